@@ -77,7 +77,7 @@ class OSRMDirectLoader extends OSRMBaseLoader {
     osrmUp (callback) {
         if (this.osrmIsRunning()) return callback(new Error("osrm-routed already running!"));
 
-        const command_arguments = util.format('%s -p %d -a %s', this.inputFile, this.scope.OSRM_PORT, this.scope.ROUTING_ALGORITHM);
+        const command_arguments = util.format('%s %s -p %d -a %s', this.scope.routedArgs, this.inputFile, this.scope.OSRM_PORT, this.scope.ROUTING_ALGORITHM);
         this.child = this.scope.runBin('osrm-routed', command_arguments, this.scope.environment, (err) => {
             if (err && err.signal !== 'SIGINT') {
                 this.child = null;
@@ -98,6 +98,10 @@ class OSRMDatastoreLoader extends OSRMBaseLoader {
 
         this.loadData((err) => {
             if (err) return callback(err);
+            // osrm-routed keeps running across scenarios unless it needs other arguments
+            if (this.osrmIsRunning() && this.routedArgs !== this.scope.routedArgs) {
+                return this.shutdown(() => { this.launch(callback); });
+            }
             if (!this.osrmIsRunning()) this.launch(callback);
             else {
                 this.scope.setupOutputLog(this.child, fs.createWriteStream(this.scope.scenarioLogFile, {'flags': 'a'}));
@@ -116,7 +120,8 @@ class OSRMDatastoreLoader extends OSRMBaseLoader {
     osrmUp (callback) {
         if (this.osrmIsRunning()) return callback();
 
-        const command_arguments = util.format('--shared-memory=1 -p %d -a %s', this.scope.OSRM_PORT, this.scope.ROUTING_ALGORITHM);
+        this.routedArgs = this.scope.routedArgs;
+        const command_arguments = util.format('%s --shared-memory=1 -p %d -a %s', this.routedArgs, this.scope.OSRM_PORT, this.scope.ROUTING_ALGORITHM);
         this.child = this.scope.runBin('osrm-routed', command_arguments, this.scope.environment, (err) => {
             if (err && err.signal !== 'SIGINT') {
                 this.child = null;
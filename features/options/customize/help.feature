@@ -10,6 +10,8 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--incremental"
+        And stdout should contain "--engine"
         And it should exit with an error
 
     Scenario: osrm-customize - Help, short
@@ -21,6 +23,8 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--incremental"
+        And stdout should contain "--engine"
         And it should exit successfully
 
     Scenario: osrm-customize - Help, long
@@ -32,4 +36,6 @@ Feature: osrm-customize command line options: help
         And stdout should contain "--help"
         And stdout should contain "Configuration:"
         And stdout should contain "--threads"
+        And stdout should contain "--incremental"
+        And stdout should contain "--engine"
         And it should exit successfully
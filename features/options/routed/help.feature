@@ -16,11 +16,24 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--ip"
         And stdout should contain "--port"
         And stdout should contain "--threads"
+        And stdout should contain "--keepalive-timeout"
+        And stdout should contain "--keepalive-requests"
+        And stdout should contain "--reuseport-sharding"
+        And stdout should contain "--compression-min-size"
         And stdout should contain "--shared-memory"
+        And stdout should contain "--mmap"
+        And stdout should contain "--mmap-image"
+        And stdout should contain "--huge-pages"
+        And stdout should contain "--metric"
         And stdout should contain "--max-viaroute-size"
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-alternative-threads"
+        And stdout should contain "--max-match-threads"
+        And stdout should contain "--max-trip-threads"
+        And stdout should contain "--max-tile-cache-memory"
+        And stdout should contain "--max-result-cache-memory"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, short
@@ -35,11 +48,24 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--ip"
         And stdout should contain "--port"
         And stdout should contain "--threads"
+        And stdout should contain "--keepalive-timeout"
+        And stdout should contain "--keepalive-requests"
+        And stdout should contain "--reuseport-sharding"
+        And stdout should contain "--compression-min-size"
         And stdout should contain "--shared-memory"
+        And stdout should contain "--mmap"
+        And stdout should contain "--mmap-image"
+        And stdout should contain "--huge-pages"
+        And stdout should contain "--metric"
         And stdout should contain "--max-viaroute-size"
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-alternative-threads"
+        And stdout should contain "--max-match-threads"
+        And stdout should contain "--max-trip-threads"
+        And stdout should contain "--max-tile-cache-memory"
+        And stdout should contain "--max-result-cache-memory"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, long
@@ -54,9 +80,22 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--ip"
         And stdout should contain "--port"
         And stdout should contain "--threads"
+        And stdout should contain "--keepalive-timeout"
+        And stdout should contain "--keepalive-requests"
+        And stdout should contain "--reuseport-sharding"
+        And stdout should contain "--compression-min-size"
         And stdout should contain "--shared-memory"
+        And stdout should contain "--mmap"
+        And stdout should contain "--mmap-image"
+        And stdout should contain "--huge-pages"
+        And stdout should contain "--metric"
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-alternative-threads"
+        And stdout should contain "--max-match-threads"
+        And stdout should contain "--max-trip-threads"
+        And stdout should contain "--max-tile-cache-memory"
+        And stdout should contain "--max-result-cache-memory"
         And it should exit successfully
@@ -0,0 +1,27 @@
+@tiles @options @files
+Feature: osrm-tiles command line options: files
+# The tiles of a bounding box around the nodes are rendered with osrm-tiles, the
+# stored tiles must be the same as the ones served by the /tile plugin.
+
+    Background:
+        Given the profile "testbot"
+        And the node map
+            """
+            a b c
+              d
+              e
+            """
+        And the ways
+            | nodes |
+            | abc   |
+            | bde   |
+
+    Scenario: osrm-tiles - Writing a directory
+        When I render the tiles of zoom 17 to a directory
+        Then it should exit successfully
+        And the rendered tile of node "b" at zoom 17 should match the tile service
+
+    Scenario: osrm-tiles - Writing an MBTiles file
+        When I render the tiles of zoom 17 to an MBTiles file
+        Then it should exit successfully
+        And the rendered tile of node "b" at zoom 17 should match the tile service
@@ -0,0 +1,56 @@
+@tiles @options @help
+Feature: osrm-tiles command line options: help
+
+    Scenario: osrm-tiles - Help should be shown when no options are passed
+        When I try to run "osrm-tiles"
+        Then stderr should be empty
+        And stdout should contain /osrm-tiles(.exe)? <input.osrm> \[options\]:/
+        And stdout should contain "Options:"
+        And stdout should contain "--version"
+        And stdout should contain "--help"
+        And stdout should contain "Configuration:"
+        And stdout should contain "--output"
+        And stdout should contain "--format"
+        And stdout should contain "--bbox"
+        And stdout should contain "--min-zoom"
+        And stdout should contain "--max-zoom"
+        And stdout should contain "--threads"
+        And stdout should contain "--shared-memory"
+        And stdout should contain "--algorithm"
+        And it should exit with an error
+
+    Scenario: osrm-tiles - Help, short
+        When I try to run "osrm-tiles -h"
+        Then stderr should be empty
+        And stdout should contain /osrm-tiles(.exe)? <input.osrm> \[options\]:/
+        And stdout should contain "Options:"
+        And stdout should contain "--version"
+        And stdout should contain "--help"
+        And stdout should contain "Configuration:"
+        And stdout should contain "--output"
+        And stdout should contain "--format"
+        And stdout should contain "--bbox"
+        And stdout should contain "--min-zoom"
+        And stdout should contain "--max-zoom"
+        And stdout should contain "--threads"
+        And stdout should contain "--shared-memory"
+        And stdout should contain "--algorithm"
+        And it should exit successfully
+
+    Scenario: osrm-tiles - Help, long
+        When I try to run "osrm-tiles --help"
+        Then stderr should be empty
+        And stdout should contain /osrm-tiles(.exe)? <input.osrm> \[options\]:/
+        And stdout should contain "Options:"
+        And stdout should contain "--version"
+        And stdout should contain "--help"
+        And stdout should contain "Configuration:"
+        And stdout should contain "--output"
+        And stdout should contain "--format"
+        And stdout should contain "--bbox"
+        And stdout should contain "--min-zoom"
+        And stdout should contain "--max-zoom"
+        And stdout should contain "--threads"
+        And stdout should contain "--shared-memory"
+        And stdout should contain "--algorithm"
+        And it should exit successfully
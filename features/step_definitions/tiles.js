@@ -0,0 +1,80 @@
+'use strict';
+
+const assert = require('assert');
+const child_process = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const request = require('request');
+const util = require('util');
+const zlib = require('zlib');
+
+module.exports = function () {
+    // the slippy map tile that contains a location
+    var tileOf = (lon, lat, z) => {
+        const n = Math.pow(2, z);
+        const lat_rad = lat * Math.PI / 180;
+        return {
+            x: Math.floor((lon + 180) / 360 * n),
+            y: Math.floor((1 - Math.log(Math.tan(lat_rad) + 1 / Math.cos(lat_rad)) / Math.PI) / 2 * n)
+        };
+    };
+
+    var readRenderedTile = (output, format, z, x, y, callback) => {
+        if (format === 'directory') {
+            return fs.readFile(path.join(output, String(z), String(x), y + '.mvt'), callback);
+        }
+
+        // MBTiles rows are flipped and the tiles are gzip compressed
+        const query = util.format('SELECT hex(tile_data) FROM tiles WHERE zoom_level = %d AND tile_column = %d AND tile_row = %d;',
+            z, x, Math.pow(2, z) - 1 - y);
+        child_process.execFile('sqlite3', [output, query], (err, stdout) => {
+            if (err) return callback(err);
+            if (!stdout.trim()) return callback(new Error(util.format('*** tile %d/%d/%d is missing in %s', z, x, y, output)));
+            zlib.gunzip(Buffer.from(stdout.trim(), 'hex'), callback);
+        });
+    };
+
+    this.When(/^I render the tiles of zoom (\d+) to an? (directory|MBTiles file)$/, { timeout: this.TIMEOUT }, (zoom, output, callback) => {
+        const format = output === 'directory' ? 'directory' : 'mbtiles';
+        this.reprocess((err) => {
+            if (err) return callback(err);
+
+            // a box around all nodes of the scenario
+            const nodes = Object.keys(this.nameNodeHash).map((name) => this.nameNodeHash[name]);
+            const lons = nodes.map((node) => parseFloat(node.lon));
+            const lats = nodes.map((node) => parseFloat(node.lat));
+            const bbox = [Math.min.apply(null, lons), Math.min.apply(null, lats),
+                Math.max.apply(null, lons), Math.max.apply(null, lats)].join(',');
+
+            this.tilesOutput = this.processedCacheFile + (format === 'directory' ? '.tiles' : '.mbtiles');
+            this.tilesFormat = format;
+            const options = util.format('%s -a %s --format %s --output %s --bbox %s --min-zoom %d --max-zoom %d',
+                this.processedCacheFile, this.ROUTING_ALGORITHM, format, this.tilesOutput, bbox, zoom, zoom);
+            this.runAndSafeOutput('osrm-tiles', options, callback);
+        });
+    });
+
+    this.Then(/^the rendered tile of node "([a-z])" at zoom (\d+) should match the tile service$/, { timeout: this.TIMEOUT }, (name, zoom, callback) => {
+        const node = this.findNodeByName(name);
+        const z = parseInt(zoom);
+        const tile = tileOf(parseFloat(node.lon), parseFloat(node.lat), z);
+
+        readRenderedTile(this.tilesOutput, this.tilesFormat, z, tile.x, tile.y, (err, rendered) => {
+            if (err) return callback(err);
+
+            this.osrmLoader.load(this.processedCacheFile, (err) => {
+                if (err) return callback(err);
+
+                // binary bodies need a buffer, the default decodes them as strings
+                this.query = [this.HOST, 'tile', 'v1', this.profile, util.format('tile(%d,%d,%d).mvt', tile.x, tile.y, z)].join('/');
+                request({ uri: this.query, encoding: null }, (err, res, body) => {
+                    if (err) return callback(err);
+                    assert.equal(res.statusCode, 200);
+                    assert.ok(rendered.length > 0);
+                    assert.ok(body.equals(rendered), util.format('*** tile %d/%d/%d differs from %s', z, tile.x, tile.y, this.query));
+                    callback();
+                });
+            });
+        });
+    });
+};
@@ -0,0 +1,37 @@
+@routing @testbot @mld
+Feature: Alternative route with multi level routing
+# The MLD alternatives are checked for edges shared with the shortest path and
+# with the alternatives kept before them. A detour over a single node shares
+# every other part of the route and is never returned.
+
+    Background:
+        Given the profile "testbot"
+        And the partition extra arguments "--small-component-size 1 --max-cell-sizes 4,16,64"
+        And the node map
+            """
+            a b   c d   e
+               f     g
+            """
+
+        And the ways
+            | nodes |
+            | abcde |
+            | bfc   |
+            | dge   |
+
+    Scenario: Alternatives that only differ by a detour
+        Given the query options
+            | alternatives | true |
+
+        When I route I should get
+            | from | to | route       | alternative |
+            | a    | e  | abcde,abcde |             |
+            | e    | a  | abcde,abcde |             |
+
+    Scenario: Requesting several alternatives
+        Given the query options
+            | alternatives | 3 |
+
+        When I route I should get
+            | from | to | route       | alternative |
+            | a    | e  | abcde,abcde |             |
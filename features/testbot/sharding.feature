@@ -0,0 +1,50 @@
+@routing @sharding @testbot
+Feature: Sharded server
+# With --reuseport-sharding every thread accepts and serves its own connections.
+# Every request of the test framework opens a new connection, so the requests
+# are spread over the acceptors of all threads.
+
+    Background:
+        Given the profile "testbot"
+        And the routed extra arguments "--reuseport-sharding --threads 4"
+
+    Scenario: Sharded server - Routes over many connections
+        Given the node map
+            """
+            a b   c
+            d e   f
+            """
+
+        And the ways
+            | nodes |
+            | abc   |
+            | def   |
+            | ad    |
+            | cf    |
+
+        When I route I should get
+            | from | to | route          |
+            | a    | c  | abc,abc        |
+            | c    | a  | abc,abc        |
+            | d    | f  | def,def        |
+            | f    | d  | def,def        |
+            | a    | d  | ad,ad          |
+            | c    | f  | cf,cf          |
+            | b    | e  | abc,ad,def,def |
+            | e    | b  | def,ad,abc,abc |
+
+    Scenario: Sharded server - Tables over many connections
+        Given the node map
+            """
+            a b c
+            """
+
+        And the ways
+            | nodes |
+            | abc   |
+
+        When I request a travel time matrix I should get
+            |   | a  | b  | c  |
+            | a | 0  | 10 | 20 |
+            | b | 10 | 0  | 10 |
+            | c | 20 | 10 | 0  |
@@ -1,13 +1,23 @@
 #ifndef OSRM_CELLS_CUSTOMIZER_HPP
 #define OSRM_CELLS_CUSTOMIZER_HPP
 
+#include "customizer/customizer_config.hpp"
 #include "partition/cell_storage.hpp"
 #include "partition/multi_level_partition.hpp"
+#include "util/integer_range.hpp"
+#include "util/min_plus.hpp"
 #include "util/query_heap.hpp"
 
+#include <boost/optional.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_vector.h>
 #include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 
+#include <algorithm>
 #include <unordered_set>
+#include <vector>
 
 namespace osrm
 {
@@ -28,10 +38,28 @@ class CellCustomizer
         util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayStorage<NodeID, int>>;
     using HeapPtr = tbb::enumerable_thread_specific<Heap>;
 
-    CellCustomizer(const partition::MultiLevelPartition &partition) : partition(partition) {}
+    // Cells above level 1 with more boundary nodes in their sub-cells are customized with
+    // Dijkstra, the min-plus engine needs cubic time in their number. The cutoff depends on
+    // the min-plus kernel util::minPlus is built with.
+#if defined(__AVX2__)
+    static constexpr std::size_t MAX_MIN_PLUS_NODES = 192;
+#elif defined(__SSE2__)
+    static constexpr std::size_t MAX_MIN_PLUS_NODES = 96;
+#else
+    static constexpr std::size_t MAX_MIN_PLUS_NODES = 64;
+#endif
+    // Rows and columns of the blocks the min-plus matrices are updated in
+    static constexpr std::size_t MIN_PLUS_BLOCK_SIZE = 64;
 
+    CellCustomizer(const partition::MultiLevelPartition &partition,
+                   const CustomizationEngine engine = CustomizationEngine::Dijkstra)
+        : partition(partition), engine(engine)
+    {
+    }
+
+    // Returns true if any weight or duration of the cell differs from the value it had before
     template <typename GraphT>
-    void Customize(const GraphT &graph,
+    bool Customize(const GraphT &graph,
                    Heap &heap,
                    const partition::CellStorage &cells,
                    const std::vector<bool> &allowed_nodes,
@@ -41,6 +69,7 @@ class CellCustomizer
     {
         auto cell = cells.GetCell(metric, level, id);
         auto destinations = cell.GetDestinationNodes();
+        bool changed = false;
 
         // for each source do forward search
         for (auto source : cell.GetSourceNodes())
@@ -82,9 +111,12 @@ class CellCustomizer
                 BOOST_ASSERT(!durations.empty());
 
                 const bool inserted = heap.WasInserted(destination);
-                weights.front() = inserted ? heap.GetKey(destination) : INVALID_EDGE_WEIGHT;
-                durations.front() =
+                const auto weight = inserted ? heap.GetKey(destination) : INVALID_EDGE_WEIGHT;
+                const auto duration =
                     inserted ? heap.GetData(destination).duration : MAXIMAL_EDGE_DURATION;
+                changed = changed || weights.front() != weight || durations.front() != duration;
+                weights.front() = weight;
+                durations.front() = duration;
 
                 weights.advance_begin(1);
                 durations.advance_begin(1);
@@ -92,6 +124,8 @@ class CellCustomizer
             BOOST_ASSERT(weights.empty());
             BOOST_ASSERT(durations.empty());
         }
+
+        return changed;
     }
 
     template <typename GraphT>
@@ -110,14 +144,392 @@ class CellCustomizer
                                   auto &heap = heaps.local();
                                   for (auto id = range.begin(), end = range.end(); id != end; ++id)
                                   {
-                                      Customize(
+                                      CustomizeCell(
                                           graph, heap, cells, allowed_nodes, metric, level, id);
                                   }
                               });
         }
     }
 
+    // Marks the cells (indexed by level and cell id) whose customization reads an edge that
+    // differs between both graphs. An edge is only read on the lowest level on which both of
+    // its nodes are in the same cell, on higher levels it is part of a sub-cell.
+    // Returns none if the graphs differ in more than their edge data.
+    template <typename GraphT>
+    boost::optional<std::vector<std::vector<bool>>>
+    FindChangedCells(const GraphT &graph, const GraphT &previous_graph) const
+    {
+        if (graph.GetNumberOfNodes() != previous_graph.GetNumberOfNodes() ||
+            graph.GetNumberOfEdges() != previous_graph.GetNumberOfEdges())
+        {
+            return boost::none;
+        }
+
+        std::vector<std::vector<bool>> changed_cells(partition.GetNumberOfLevels());
+        for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            changed_cells[level].resize(partition.GetNumberOfCells(level), false);
+        }
+
+        for (const auto node : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+        {
+            if (graph.BeginEdges(node) != previous_graph.BeginEdges(node) ||
+                graph.EndEdges(node) != previous_graph.EndEdges(node))
+            {
+                return boost::none;
+            }
+
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto to = graph.GetTarget(edge);
+                if (to != previous_graph.GetTarget(edge))
+                {
+                    return boost::none;
+                }
+
+                const auto &data = graph.GetEdgeData(edge);
+                const auto &previous_data = previous_graph.GetEdgeData(edge);
+                if (data.weight == previous_data.weight &&
+                    data.duration == previous_data.duration &&
+                    data.forward == previous_data.forward &&
+                    data.backward == previous_data.backward)
+                {
+                    continue;
+                }
+
+                const auto level = partition.GetHighestDifferentLevel(node, to) + 1;
+                if (level < partition.GetNumberOfLevels())
+                {
+                    changed_cells[level][partition.GetCell(level, node)] = true;
+                }
+            }
+        }
+
+        return changed_cells;
+    }
+
+    // Customizes only the cells marked in changed_cells, see FindChangedCells, and the parents
+    // of cells whose values changed. The metric has to hold the values of a customization of
+    // the graph before it changed. Returns the number of customized cells.
+    template <typename GraphT>
+    std::size_t CustomizeChanged(const GraphT &graph,
+                                 const partition::CellStorage &cells,
+                                 const std::vector<bool> &allowed_nodes,
+                                 CellMetric &metric,
+                                 std::vector<std::vector<bool>> changed_cells) const
+    {
+        Heap heap_exemplar(graph.GetNumberOfNodes());
+        HeapPtr heaps(heap_exemplar);
+
+        std::size_t num_customized = 0;
+        for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            std::vector<CellID> cell_ids;
+            for (const auto id : util::irange<CellID>(0, changed_cells[level].size()))
+            {
+                if (changed_cells[level][id])
+                {
+                    cell_ids.push_back(id);
+                }
+            }
+            num_customized += cell_ids.size();
+
+            tbb::concurrent_vector<CellID> updated_cells;
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, cell_ids.size()),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  auto &heap = heaps.local();
+                                  for (auto index = range.begin(), end = range.end();
+                                       index != end;
+                                       ++index)
+                                  {
+                                      const auto id = cell_ids[index];
+                                      if (CustomizeCell(
+                                              graph, heap, cells, allowed_nodes, metric, level, id))
+                                      {
+                                          updated_cells.push_back(id);
+                                      }
+                                  }
+                              });
+
+            // the clique arcs of a parent cell only change if the ones of a child changed
+            const auto parent_level = level + 1;
+            if (parent_level < partition.GetNumberOfLevels() && !updated_cells.empty())
+            {
+                std::vector<bool> updated(partition.GetNumberOfCells(level), false);
+                for (const auto id : updated_cells)
+                {
+                    updated[id] = true;
+                }
+
+                for (const auto parent :
+                     util::irange<CellID>(0, partition.GetNumberOfCells(parent_level)))
+                {
+                    for (const auto child :
+                         util::irange<CellID>(partition.BeginChildren(parent_level, parent),
+                                              partition.EndChildren(parent_level, parent)))
+                    {
+                        if (updated[child])
+                        {
+                            changed_cells[parent_level][parent] = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        return num_customized;
+    }
+
+    // Customizes a cell above level 1 from the cliques of its sub-cells and the edges between
+    // them, this is the same graph the Dijkstra searches run on. Shortest paths between all
+    // boundary nodes of the sub-cells are computed with a blocked Floyd-Warshall, every step
+    // of it is a min-plus update of a matrix row. Returns true if a value of the cell changed.
+    template <typename GraphT>
+    bool CustomizeMinPlus(const GraphT &graph,
+                          const partition::CellStorage &cells,
+                          const std::vector<bool> &allowed_nodes,
+                          CellMetric &metric,
+                          LevelID level,
+                          CellID id) const
+    {
+        BOOST_ASSERT(level > 1);
+        return CustomizeMinPlus(graph,
+                                cells,
+                                allowed_nodes,
+                                metric,
+                                level,
+                                id,
+                                GetSubcellBoundaryNodes(cells, allowed_nodes, metric, level, id));
+    }
+
   private:
+    // Customizes the cell with the configured engine
+    template <typename GraphT>
+    bool CustomizeCell(const GraphT &graph,
+                       Heap &heap,
+                       const partition::CellStorage &cells,
+                       const std::vector<bool> &allowed_nodes,
+                       CellMetric &metric,
+                       LevelID level,
+                       CellID id) const
+    {
+        if (engine == CustomizationEngine::MinPlus && level > 1)
+        {
+            auto nodes = GetSubcellBoundaryNodes(cells, allowed_nodes, metric, level, id);
+            if (nodes.size() <= MAX_MIN_PLUS_NODES)
+            {
+                return CustomizeMinPlus(
+                    graph, cells, allowed_nodes, metric, level, id, std::move(nodes));
+            }
+        }
+
+        return Customize(graph, heap, cells, allowed_nodes, metric, level, id);
+    }
+
+    // nodes are the sorted boundary nodes of the sub-cells that are allowed
+    template <typename GraphT>
+    bool CustomizeMinPlus(const GraphT &graph,
+                          const partition::CellStorage &cells,
+                          const std::vector<bool> &allowed_nodes,
+                          CellMetric &metric,
+                          LevelID level,
+                          CellID id,
+                          const std::vector<NodeID> &nodes) const
+    {
+        const auto num_nodes = nodes.size();
+        const auto index_of = [&nodes](const NodeID node) {
+            const auto iter = std::lower_bound(nodes.begin(), nodes.end(), node);
+            return iter != nodes.end() && *iter == node ? std::distance(nodes.begin(), iter)
+                                                        : -1;
+        };
+
+        std::vector<EdgeWeight> weights(num_nodes * num_nodes, INVALID_EDGE_WEIGHT);
+        std::vector<EdgeDuration> durations(num_nodes * num_nodes, MAXIMAL_EDGE_DURATION);
+        const auto add_arc = [&](const std::size_t from,
+                                 const std::size_t to,
+                                 const EdgeWeight weight,
+                                 const EdgeDuration duration) {
+            const auto index = from * num_nodes + to;
+            if (weight < weights[index])
+            {
+                weights[index] = weight;
+                durations[index] = duration;
+            }
+        };
+
+        for (const auto node_index : util::irange<std::size_t>(0, num_nodes))
+        {
+            add_arc(node_index, node_index, 0, 0);
+        }
+
+        // Clique arcs of the sub-cells
+        for (const auto subcell_id : util::irange<CellID>(partition.BeginChildren(level, id),
+                                                          partition.EndChildren(level, id)))
+        {
+            const auto subcell = cells.GetCell(metric, level - 1, subcell_id);
+            const auto subcell_destinations = subcell.GetDestinationNodes();
+            for (const auto source : subcell.GetSourceNodes())
+            {
+                if (!allowed_nodes[source])
+                {
+                    continue;
+                }
+
+                const auto source_index = index_of(source);
+                const auto subcell_weights = subcell.GetOutWeight(source);
+                const auto subcell_durations = subcell.GetOutDuration(source).begin();
+                util::forEachValidWeight(
+                    subcell_weights.begin(), subcell_weights.size(), [&](const std::size_t index) {
+                        const auto destination = subcell_destinations[index];
+                        if (allowed_nodes[destination])
+                        {
+                            add_arc(source_index,
+                                    index_of(destination),
+                                    subcell_weights[index],
+                                    subcell_durations[index]);
+                        }
+                    });
+            }
+        }
+
+        // Base graph edges between the sub-cells
+        for (const auto node_index : util::irange<std::size_t>(0, num_nodes))
+        {
+            const auto node = nodes[node_index];
+            for (const auto edge : graph.GetInternalEdgeRange(level, node))
+            {
+                const auto to = graph.GetTarget(edge);
+                const auto &data = graph.GetEdgeData(edge);
+                if (data.forward && data.weight != INVALID_EDGE_WEIGHT && allowed_nodes[to] &&
+                    partition.GetCell(level - 1, node) != partition.GetCell(level - 1, to))
+                {
+                    const auto to_index = index_of(to);
+                    BOOST_ASSERT(to_index >= 0);
+                    add_arc(node_index, to_index, data.weight, data.duration);
+                }
+            }
+        }
+
+        FloydWarshall(weights, durations, num_nodes);
+
+        bool changed = false;
+        auto cell = cells.GetCell(metric, level, id);
+        const auto destinations = cell.GetDestinationNodes();
+        for (const auto source : cell.GetSourceNodes())
+        {
+            if (!allowed_nodes[source])
+            {
+                continue;
+            }
+
+            const auto source_index = index_of(source);
+            BOOST_ASSERT(source_index >= 0);
+            auto cell_weights = cell.GetOutWeight(source).begin();
+            auto cell_durations = cell.GetOutDuration(source).begin();
+            for (const auto destination : destinations)
+            {
+                const auto destination_index = index_of(destination);
+                const auto weight = destination_index >= 0
+                                        ? weights[source_index * num_nodes + destination_index]
+                                        : INVALID_EDGE_WEIGHT;
+                const auto duration =
+                    weight != INVALID_EDGE_WEIGHT
+                        ? durations[source_index * num_nodes + destination_index]
+                        : MAXIMAL_EDGE_DURATION;
+                changed = changed || *cell_weights != weight || *cell_durations != duration;
+                *cell_weights++ = weight;
+                *cell_durations++ = duration;
+            }
+        }
+
+        return changed;
+    }
+
+    // Sorted boundary nodes of all sub-cells that are allowed
+    std::vector<NodeID> GetSubcellBoundaryNodes(const partition::CellStorage &cells,
+                                                const std::vector<bool> &allowed_nodes,
+                                                const CellMetric &metric,
+                                                LevelID level,
+                                                CellID id) const
+    {
+        std::vector<NodeID> nodes;
+        for (const auto subcell_id : util::irange<CellID>(partition.BeginChildren(level, id),
+                                                          partition.EndChildren(level, id)))
+        {
+            const auto subcell = cells.GetCell(metric, level - 1, subcell_id);
+            for (const auto node : subcell.GetSourceNodes())
+                if (allowed_nodes[node])
+                    nodes.push_back(node);
+            for (const auto node : subcell.GetDestinationNodes())
+                if (allowed_nodes[node])
+                    nodes.push_back(node);
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        return nodes;
+    }
+
+    // All pairs shortest paths on a row-major matrix, processed in blocks that fit the cache.
+    // For every block of intermediate nodes the diagonal block is updated first, then the
+    // blocks in its row and column and then all other blocks.
+    static void FloydWarshall(std::vector<EdgeWeight> &weights,
+                              std::vector<EdgeDuration> &durations,
+                              const std::size_t num_nodes)
+    {
+        const auto update_block = [&](const std::size_t row_begin,
+                                      const std::size_t column_begin,
+                                      const std::size_t via_begin) {
+            const auto row_end = std::min(row_begin + MIN_PLUS_BLOCK_SIZE, num_nodes);
+            const auto column_size = std::min(MIN_PLUS_BLOCK_SIZE, num_nodes - column_begin);
+            const auto via_end = std::min(via_begin + MIN_PLUS_BLOCK_SIZE, num_nodes);
+            for (auto via = via_begin; via < via_end; ++via)
+            {
+                const auto via_row = via * num_nodes + column_begin;
+                for (auto row = row_begin; row < row_end; ++row)
+                {
+                    const auto to_via = row * num_nodes + via;
+                    if (weights[to_via] == INVALID_EDGE_WEIGHT)
+                    {
+                        continue;
+                    }
+
+                    const auto target_row = row * num_nodes + column_begin;
+                    util::minPlus(weights.data() + target_row,
+                                  durations.data() + target_row,
+                                  weights.data() + via_row,
+                                  durations.data() + via_row,
+                                  column_size,
+                                  weights[to_via],
+                                  durations[to_via]);
+                }
+            }
+        };
+
+        for (std::size_t via = 0; via < num_nodes; via += MIN_PLUS_BLOCK_SIZE)
+        {
+            update_block(via, via, via);
+            for (std::size_t other = 0; other < num_nodes; other += MIN_PLUS_BLOCK_SIZE)
+            {
+                if (other != via)
+                {
+                    update_block(via, other, via);
+                    update_block(other, via, via);
+                }
+            }
+            for (std::size_t row = 0; row < num_nodes; row += MIN_PLUS_BLOCK_SIZE)
+            {
+                for (std::size_t column = 0; column < num_nodes; column += MIN_PLUS_BLOCK_SIZE)
+                {
+                    if (row != via && column != via)
+                    {
+                        update_block(row, column, via);
+                    }
+                }
+            }
+        }
+    }
+
     template <typename GraphT>
     void RelaxNode(const GraphT &graph,
                    const partition::CellStorage &cells,
@@ -146,33 +558,29 @@ class CellCustomizer
                 // Relax sub-cell nodes
                 auto subcell_id = partition.GetCell(level - 1, node);
                 auto subcell = cells.GetCell(metric, level - 1, subcell_id);
-                auto subcell_destination = subcell.GetDestinationNodes().begin();
-                auto subcell_duration = subcell.GetOutDuration(node).begin();
-                for (auto subcell_weight : subcell.GetOutWeight(node))
-                {
-                    if (subcell_weight != INVALID_EDGE_WEIGHT)
-                    {
-                        const NodeID to = *subcell_destination;
+                const auto subcell_destinations = subcell.GetDestinationNodes().begin();
+                const auto subcell_durations = subcell.GetOutDuration(node).begin();
+                const auto subcell_weights = subcell.GetOutWeight(node);
+                util::forEachValidWeight(
+                    subcell_weights.begin(), subcell_weights.size(), [&](const std::size_t index) {
+                        const NodeID to = subcell_destinations[index];
                         if (!allowed_nodes[to])
                         {
-                            continue;
+                            return;
                         }
 
-                        const EdgeWeight to_weight = weight + subcell_weight;
+                        const EdgeWeight to_weight = weight + subcell_weights[index];
+                        const EdgeDuration to_duration = duration + subcell_durations[index];
                         if (!heap.WasInserted(to))
                         {
-                            heap.Insert(to, to_weight, {true, duration + *subcell_duration});
+                            heap.Insert(to, to_weight, {true, to_duration});
                         }
                         else if (to_weight < heap.GetKey(to))
                         {
                             heap.DecreaseKey(to, to_weight);
-                            heap.GetData(to) = {true, duration + *subcell_duration};
+                            heap.GetData(to) = {true, to_duration};
                         }
-                    }
-
-                    ++subcell_destination;
-                    ++subcell_duration;
-                }
+                    });
             }
         }
 
@@ -205,6 +613,7 @@ class CellCustomizer
     }
 
     const partition::MultiLevelPartition &partition;
+    const CustomizationEngine engine;
 };
 }
 }
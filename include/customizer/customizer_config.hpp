@@ -14,6 +14,13 @@ namespace osrm
 namespace customizer
 {
 
+// How the cells above level 1 are customized
+enum class CustomizationEngine
+{
+    Dijkstra, // a search from every source node of the cell
+    MinPlus   // Floyd-Warshall over the boundary nodes of its sub-cells
+};
+
 struct CustomizationConfig final : storage::IOConfig
 {
     CustomizationConfig()
@@ -24,7 +31,7 @@ struct CustomizationConfig final : storage::IOConfig
                     ".osrm.properties"},
                    {},
                    {".osrm.cell_metrics", ".osrm.mldgr"}),
-          requested_num_threads(0)
+          requested_num_threads(0), incremental(false), engine(CustomizationEngine::Dijkstra)
     {
     }
 
@@ -35,6 +42,9 @@ struct CustomizationConfig final : storage::IOConfig
     }
 
     unsigned requested_num_threads;
+    // only customize the cells affected by weights that changed since the last run
+    bool incremental;
+    CustomizationEngine engine;
 
     updater::UpdaterConfig updater_config;
 };
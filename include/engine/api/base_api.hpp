@@ -2,6 +2,7 @@
 #define ENGINE_API_BASE_API_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include "engine/api/json_factory.hpp"
@@ -10,6 +11,8 @@
 #include <boost/assert.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#include <limits>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -66,6 +69,61 @@ class BaseAPI
         }
     }
 
+    // Binary counterpart of a waypoint array: `<prefix>.location` holds lon, lat pairs,
+    // `<prefix>.name` and `<prefix>.hint` the strings. A nullptr is written as NaN location
+    // with empty strings, like null entries in JSON.
+    void MakeWaypoints(BinaryWriter &writer,
+                       const std::string &prefix,
+                       const std::vector<const PhantomNode *> &phantoms) const
+    {
+        std::vector<double> locations;
+        std::vector<std::string> names;
+        std::vector<std::string> hints;
+        locations.reserve(phantoms.size() * 2);
+        names.reserve(phantoms.size());
+
+        for (const auto phantom : phantoms)
+        {
+            if (phantom == nullptr)
+            {
+                locations.push_back(std::numeric_limits<double>::quiet_NaN());
+                locations.push_back(std::numeric_limits<double>::quiet_NaN());
+                names.emplace_back();
+                if (parameters.generate_hints)
+                    hints.emplace_back();
+                continue;
+            }
+
+            locations.push_back(static_cast<double>(util::toFloating(phantom->location.lon)));
+            locations.push_back(static_cast<double>(util::toFloating(phantom->location.lat)));
+            names.push_back(
+                facade.GetNameForID(facade.GetNameIndex(phantom->forward_segment_id.id))
+                    .to_string());
+            if (parameters.generate_hints)
+                hints.push_back(Hint{*phantom, facade.GetCheckSum()}.ToBase64());
+        }
+
+        writer.Add(prefix + ".location", locations);
+        writer.Add(prefix + ".name", names);
+        if (parameters.generate_hints)
+        {
+            writer.Add(prefix + ".hint", hints);
+        }
+    }
+
+    void MakeWaypoints(BinaryWriter &writer,
+                       const std::string &prefix,
+                       const std::vector<PhantomNode> &phantoms) const
+    {
+        std::vector<const PhantomNode *> pointers;
+        pointers.reserve(phantoms.size());
+        for (const auto &phantom : phantoms)
+        {
+            pointers.push_back(&phantom);
+        }
+        MakeWaypoints(writer, prefix, pointers);
+    }
+
     const datafacade::BaseDataFacade &facade;
     const BaseParameters &parameters;
 };
@@ -57,22 +57,36 @@ namespace api
  *  - bearings: limits the search for segments in the road network to given bearing(s) in degree
  *              towards true north in clockwise direction, optional per coordinate
  *  - approaches: force the phantom node to start towards the node with the road country side.
+ *  - exclude: classes of roads to avoid, as configured in the profile.
+ *  - metric: name of one of the metrics loaded next to the dataset (see EngineConfig::metrics),
+ *            empty for the metric of the dataset itself.
+ *  - format: response format requested with the URL extension, osrm-routed falls back to the
+ *            Accept header if unset. libosrm picks the format by the result type passed in.
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
  */
 struct BaseParameters
 {
+    enum class OutputFormatType
+    {
+        JSON,
+        Binary
+    };
+
     std::vector<util::Coordinate> coordinates;
     std::vector<boost::optional<Hint>> hints;
     std::vector<boost::optional<double>> radiuses;
     std::vector<boost::optional<Bearing>> bearings;
     std::vector<boost::optional<Approach>> approaches;
     std::vector<std::string> exclude;
+    std::string metric;
 
     // Adds hints to response which can be included in subsequent requests, see `hints` above.
     bool generate_hints = true;
 
+    boost::optional<OutputFormatType> format;
+
     BaseParameters(const std::vector<util::Coordinate> coordinates_ = {},
                    const std::vector<boost::optional<Hint>> hints_ = {},
                    std::vector<boost::optional<double>> radiuses_ = {},
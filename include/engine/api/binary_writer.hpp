@@ -0,0 +1,286 @@
+#ifndef ENGINE_API_BINARY_WRITER_HPP
+#define ENGINE_API_BINARY_WRITER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+/**
+ * Writes responses in the aligned binary format.
+ *
+ * A response is a set of named, typed arrays. All values are stored in host byte order, which is
+ * little-endian on every platform we support:
+ *
+ *   Header   char magic[4] = "OSRB", uint32 version, uint32 number of sections, uint32 reserved
+ *   Section  char name[32] (zero padded), uint32 type, uint32 reserved, uint64 offset,
+ *            uint64 count; repeated for every section
+ *   Data     the arrays, each starting at a multiple of 8 bytes from the start of the buffer
+ *
+ * Clients can therefore point typed arrays directly into the received buffer, without
+ * parsing or copying the values. Strings are stored as the concatenated UTF-8 bytes in
+ * `name` and `count + 1` uint32 offsets into them in `name.offsets`.
+ *
+ * Sections are collected with Add and the response is written to the buffer by Finish.
+ */
+class BinaryWriter
+{
+  public:
+    enum class Type : std::uint32_t
+    {
+        UInt8 = 0,
+        Int32 = 1,
+        UInt32 = 2,
+        UInt64 = 3,
+        Float64 = 4
+    };
+
+    static constexpr const std::uint32_t VERSION = 1;
+    static constexpr const std::size_t NAME_SIZE = 32;
+    static constexpr const std::size_t ALIGNMENT = 8;
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t number_of_sections;
+        std::uint32_t reserved;
+    };
+
+    struct Section
+    {
+        char name[NAME_SIZE];
+        Type type;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+
+    static const char *Magic() { return "OSRB"; }
+
+    static_assert(sizeof(Header) % ALIGNMENT == 0, "header breaks the data alignment");
+    static_assert(sizeof(Section) % ALIGNMENT == 0, "section breaks the data alignment");
+
+    template <typename T> struct TypeOf;
+
+    explicit BinaryWriter(std::vector<char> &buffer_) : buffer(buffer_) {}
+
+    template <typename T> void Add(const std::string &name, const std::vector<T> &values)
+    {
+        AddSection(name, TypeOf<T>::value, values.data(), values.size(), sizeof(T));
+    }
+
+    void Add(const std::string &name, const std::string &value)
+    {
+        AddSection(name, Type::UInt8, value.data(), value.size(), 1);
+    }
+
+    void Add(const std::string &name, const std::vector<std::string> &values)
+    {
+        std::vector<std::uint32_t> offsets;
+        offsets.reserve(values.size() + 1);
+        offsets.push_back(0);
+        std::string characters;
+        for (const auto &value : values)
+        {
+            characters += value;
+            offsets.push_back(static_cast<std::uint32_t>(characters.size()));
+        }
+        Add(name, characters);
+        Add(name + ".offsets", offsets);
+    }
+
+    // Writes header, sections and data to the buffer, replacing its content
+    void Finish()
+    {
+        const auto data_offset = sizeof(Header) + sections.size() * sizeof(Section);
+
+        Header header;
+        std::memcpy(header.magic, Magic(), sizeof(header.magic));
+        header.version = VERSION;
+        header.number_of_sections = static_cast<std::uint32_t>(sections.size());
+        header.reserved = 0;
+
+        buffer.clear();
+        buffer.reserve(data_offset + data.size());
+        Append(&header, sizeof(header));
+        for (auto section : sections)
+        {
+            section.offset += data_offset;
+            Append(&section, sizeof(section));
+        }
+        buffer.insert(buffer.end(), data.begin(), data.end());
+
+        sections.clear();
+        data.clear();
+    }
+
+    // The buffer Finish writes the response to
+    const std::vector<char> &Buffer() const { return buffer; }
+
+    // Replaces the buffer's content with a response finished by an earlier writer, e.g. a
+    // cached response
+    void Raw(const std::string &response)
+    {
+        buffer.assign(response.begin(), response.end());
+        sections.clear();
+        data.clear();
+    }
+
+  private:
+    void AddSection(const std::string &name,
+                    const Type type,
+                    const void *values,
+                    const std::size_t count,
+                    const std::size_t value_size)
+    {
+        BOOST_ASSERT(name.size() < NAME_SIZE);
+
+        Section section;
+        std::memset(section.name, 0, NAME_SIZE);
+        std::memcpy(section.name, name.data(), std::min(name.size(), NAME_SIZE - 1));
+        section.type = type;
+        section.reserved = 0;
+        section.offset = data.size();
+        section.count = count;
+        sections.push_back(section);
+
+        const auto bytes = count * value_size;
+        const auto padded_bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        data.resize(data.size() + padded_bytes, 0);
+        if (bytes > 0)
+        {
+            std::memcpy(data.data() + section.offset, values, bytes);
+        }
+    }
+
+    void Append(const void *value, const std::size_t size)
+    {
+        const auto begin = static_cast<const char *>(value);
+        buffer.insert(buffer.end(), begin, begin + size);
+    }
+
+    std::vector<char> &buffer;
+    std::vector<Section> sections;
+    std::vector<char> data;
+};
+
+template <> struct BinaryWriter::TypeOf<std::uint8_t>
+{
+    static constexpr const Type value = Type::UInt8;
+};
+template <> struct BinaryWriter::TypeOf<std::int32_t>
+{
+    static constexpr const Type value = Type::Int32;
+};
+template <> struct BinaryWriter::TypeOf<std::uint32_t>
+{
+    static constexpr const Type value = Type::UInt32;
+};
+template <> struct BinaryWriter::TypeOf<std::uint64_t>
+{
+    static constexpr const Type value = Type::UInt64;
+};
+template <> struct BinaryWriter::TypeOf<double>
+{
+    static constexpr const Type value = Type::Float64;
+};
+
+/**
+ * Zero-copy access to a response written by BinaryWriter.
+ *
+ * The buffer has to outlive the reader and has to be aligned to 8 bytes, which is the case for
+ * memory returned by operator new.
+ */
+class BinaryReader
+{
+  public:
+    BinaryReader(const char *data_, const std::size_t size_) : data(data_), size(size_) {}
+
+    bool IsValid() const
+    {
+        if (size < sizeof(BinaryWriter::Header))
+            return false;
+
+        const auto header = GetHeader();
+        return std::memcmp(header->magic, BinaryWriter::Magic(), sizeof(header->magic)) == 0 &&
+               header->version == BinaryWriter::VERSION &&
+               size >= sizeof(BinaryWriter::Header) +
+                           header->number_of_sections * sizeof(BinaryWriter::Section);
+    }
+
+    bool Has(const std::string &name) const { return FindSection(name) != nullptr; }
+
+    // Returns an empty range if there is no section with this name and type
+    template <typename T> boost::iterator_range<const T *> Get(const std::string &name) const
+    {
+        const auto section = FindSection(name);
+        if (section == nullptr || section->type != BinaryWriter::TypeOf<T>::value ||
+            section->offset + section->count * sizeof(T) > size)
+        {
+            return {};
+        }
+        const auto begin = reinterpret_cast<const T *>(data + section->offset);
+        return boost::make_iterator_range(begin, begin + section->count);
+    }
+
+    std::string GetString(const std::string &name) const
+    {
+        const auto characters = Get<std::uint8_t>(name);
+        return std::string(characters.begin(), characters.end());
+    }
+
+    std::vector<std::string> GetStrings(const std::string &name) const
+    {
+        const auto characters = Get<std::uint8_t>(name);
+        const auto offsets = Get<std::uint32_t>(name + ".offsets");
+        std::vector<std::string> strings;
+        for (std::size_t index = 1; index < offsets.size(); ++index)
+        {
+            strings.emplace_back(characters.begin() + offsets[index - 1],
+                                 characters.begin() + offsets[index]);
+        }
+        return strings;
+    }
+
+  private:
+    const BinaryWriter::Header *GetHeader() const
+    {
+        return reinterpret_cast<const BinaryWriter::Header *>(data);
+    }
+
+    const BinaryWriter::Section *FindSection(const std::string &name) const
+    {
+        if (!IsValid() || name.size() >= BinaryWriter::NAME_SIZE)
+            return nullptr;
+
+        const auto sections =
+            reinterpret_cast<const BinaryWriter::Section *>(data + sizeof(BinaryWriter::Header));
+        for (std::uint32_t index = 0; index < GetHeader()->number_of_sections; ++index)
+        {
+            if (std::strncmp(sections[index].name, name.c_str(), BinaryWriter::NAME_SIZE) == 0)
+                return &sections[index];
+        }
+        return nullptr;
+    }
+
+    const char *data;
+    std::size_t size;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
@@ -12,6 +12,9 @@
 
 #include "util/integer_range.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -51,6 +54,86 @@ class MatchAPI final : public RouteAPI
         response.values["code"] = "Ok";
     }
 
+    // Renders one matching at a time so only a single route tree is alive at any point
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      util::json::Writer &writer) const
+    {
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
+
+        // Same insertions as above with a placeholder for the matchings, see Writer::Object
+        util::json::Object response;
+        response.values["tracepoints"] = MakeTracepoints(sub_matchings);
+        response.values["matchings"] = util::json::Null();
+        response.values["code"] = "Ok";
+
+        writer.Object(response, [&](const std::string &key) {
+            if (key != "matchings")
+                return false;
+
+            writer.StartArray();
+            for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+            {
+                auto route = MakeRoute(sub_routes[index].segment_end_coordinates,
+                                       sub_routes[index].unpacked_path_segments,
+                                       sub_routes[index].source_traversed_in_reverse,
+                                       sub_routes[index].target_traversed_in_reverse);
+                route.values["confidence"] = sub_matchings[index].confidence;
+                writer.Value(route);
+            }
+            writer.EndArray();
+            return true;
+        });
+    }
+
+    // `tracepoints.*` with NaN locations for unmatched points, `matchings.*` like the routes of
+    // RouteAPI and `matchings.confidence`
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      BinaryWriter &writer) const
+    {
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
+
+        std::vector<const PhantomNode *> tracepoints(parameters.coordinates.size(), nullptr);
+        std::vector<std::int32_t> matchings_indices(parameters.coordinates.size(), -1);
+        std::vector<std::int32_t> waypoint_indices(parameters.coordinates.size(), -1);
+        std::vector<std::int32_t> alternatives_counts(parameters.coordinates.size(), -1);
+        for (auto sub_matching_index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            const auto &sub_matching = sub_matchings[sub_matching_index];
+            for (auto point_index : util::irange<std::size_t>(0UL, sub_matching.indices.size()))
+            {
+                const auto trace_index =
+                    tidy_result.tidied_to_original[sub_matching.indices[point_index]];
+                if (tidy_result.can_be_removed[trace_index])
+                    continue;
+
+                tracepoints[trace_index] = &sub_matching.nodes[point_index];
+                matchings_indices[trace_index] = static_cast<std::int32_t>(sub_matching_index);
+                waypoint_indices[trace_index] = static_cast<std::int32_t>(point_index);
+                alternatives_counts[trace_index] =
+                    static_cast<std::int32_t>(sub_matching.alternatives_count[point_index]);
+            }
+        }
+
+        std::vector<const InternalRouteResult *> routes;
+        std::vector<double> confidences;
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            routes.push_back(&sub_routes[index]);
+            confidences.push_back(sub_matchings[index].confidence);
+        }
+
+        writer.Add("code", std::string("Ok"));
+        BaseAPI::MakeWaypoints(writer, "tracepoints", tracepoints);
+        writer.Add("tracepoints.matchings_index", matchings_indices);
+        writer.Add("tracepoints.waypoint_index", waypoint_indices);
+        writer.Add("tracepoints.alternatives_count", alternatives_counts);
+        MakeRoutes(writer, "matchings", routes);
+        writer.Add("matchings.confidence", confidences);
+        writer.Finish();
+    }
+
   protected:
     // FIXME this logic is a little backwards. We should change the output format of the
     // map_matching
@@ -47,6 +47,27 @@ class NearestAPI final : public BaseAPI
         response.values["waypoints"] = std::move(waypoints);
     }
 
+    // `waypoints.*` with the snapping distances in `waypoints.distance`
+    void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
+                      BinaryWriter &writer) const
+    {
+        BOOST_ASSERT(phantom_nodes.size() == 1);
+        BOOST_ASSERT(parameters.coordinates.size() == 1);
+
+        std::vector<const PhantomNode *> waypoints;
+        std::vector<double> distances;
+        for (const auto &phantom_with_distance : phantom_nodes.front())
+        {
+            waypoints.push_back(&phantom_with_distance.phantom_node);
+            distances.push_back(phantom_with_distance.distance);
+        }
+
+        writer.Add("code", std::string("Ok"));
+        BaseAPI::MakeWaypoints(writer, "waypoints", waypoints);
+        writer.Add("waypoints.distance", distances);
+        writer.Finish();
+    }
+
     const NearestParameters &parameters;
 };
 
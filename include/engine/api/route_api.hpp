@@ -22,8 +22,12 @@
 #include "util/coordinate.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
+#include "util/json_writer.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -65,6 +69,63 @@ class RouteAPI : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Renders one route at a time so only a single route tree is alive at any point
+    void MakeResponse(const InternalManyRoutesResult &raw_routes, util::json::Writer &writer) const
+    {
+        BOOST_ASSERT(!raw_routes.routes.empty());
+
+        // Same insertions as above with a placeholder for the routes, see Writer::Object
+        util::json::Object response;
+        response.values["waypoints"] =
+            BaseAPI::MakeWaypoints(raw_routes.routes[0].segment_end_coordinates);
+        response.values["routes"] = util::json::Null();
+        response.values["code"] = "Ok";
+
+        writer.Object(response, [&](const std::string &key) {
+            if (key != "routes")
+                return false;
+
+            writer.StartArray();
+            for (const auto &route : raw_routes.routes)
+            {
+                if (!route.is_valid())
+                    continue;
+
+                writer.Value(MakeRoute(route.segment_end_coordinates,
+                                       route.unpacked_path_segments,
+                                       route.source_traversed_in_reverse,
+                                       route.target_traversed_in_reverse));
+            }
+            writer.EndArray();
+            return true;
+        });
+    }
+
+    void MakeResponse(const InternalManyRoutesResult &raw_routes, BinaryWriter &writer) const
+    {
+        BOOST_ASSERT(!raw_routes.routes.empty());
+
+        std::vector<PhantomNode> waypoints;
+        const auto &segment_end_coordinates = raw_routes.routes[0].segment_end_coordinates;
+        waypoints.push_back(segment_end_coordinates.front().source_phantom);
+        for (const auto &phantom_pair : segment_end_coordinates)
+        {
+            waypoints.push_back(phantom_pair.target_phantom);
+        }
+
+        std::vector<const InternalRouteResult *> routes;
+        for (const auto &route : raw_routes.routes)
+        {
+            if (route.is_valid())
+                routes.push_back(&route);
+        }
+
+        writer.Add("code", std::string("Ok"));
+        BaseAPI::MakeWaypoints(writer, "waypoints", waypoints);
+        MakeRoutes(writer, "routes", routes);
+        writer.Finish();
+    }
+
   protected:
     template <typename ForwardIter>
     util::json::Value MakeGeometry(ForwardIter begin, ForwardIter end) const
@@ -96,7 +157,14 @@ class RouteAPI : public BaseAPI
         return annotations_store;
     }
 
-    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
+    struct AssembledRoute
+    {
+        guidance::Route route;
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+    };
+
+    AssembledRoute AssembleRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
                                  const std::vector<std::vector<PathData>> &unpacked_path_segments,
                                  const std::vector<bool> &source_traversed_in_reverse,
                                  const std::vector<bool> &target_traversed_in_reverse) const
@@ -189,6 +257,36 @@ class RouteAPI : public BaseAPI
         }
 
         auto route = guidance::assembleRoute(legs);
+        return AssembledRoute{route, std::move(legs), std::move(leg_geometries)};
+    }
+
+    // Annotations requested by either the annotations type or the old boolean flag
+    RouteParameters::AnnotationsType RequestedAnnotations() const
+    {
+        // To maintain support for uses of the old default constructors, we check
+        // if annotations property was set manually after default construction
+        auto requested_annotations = parameters.annotations_type;
+        if ((parameters.annotations == true) &&
+            (parameters.annotations_type == RouteParameters::AnnotationsType::None))
+        {
+            requested_annotations = RouteParameters::AnnotationsType::All;
+        }
+        return requested_annotations;
+    }
+
+    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
+                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                                 const std::vector<bool> &source_traversed_in_reverse,
+                                 const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        auto assembled = AssembleRoute(segment_end_coordinates,
+                                       unpacked_path_segments,
+                                       source_traversed_in_reverse,
+                                       target_traversed_in_reverse);
+        auto &route = assembled.route;
+        auto &legs = assembled.legs;
+        auto &leg_geometries = assembled.leg_geometries;
+
         boost::optional<util::json::Value> json_overview;
         if (parameters.overview != RouteParameters::OverviewType::False)
         {
@@ -236,14 +334,7 @@ class RouteAPI : public BaseAPI
 
         std::vector<util::json::Object> annotations;
 
-        // To maintain support for uses of the old default constructors, we check
-        // if annotations property was set manually after default construction
-        auto requested_annotations = parameters.annotations_type;
-        if ((parameters.annotations == true) &&
-            (parameters.annotations_type == RouteParameters::AnnotationsType::None))
-        {
-            requested_annotations = RouteParameters::AnnotationsType::All;
-        }
+        const auto requested_annotations = RequestedAnnotations();
 
         if (requested_annotations != RouteParameters::AnnotationsType::None)
         {
@@ -315,6 +406,130 @@ class RouteAPI : public BaseAPI
         return result;
     }
 
+    /**
+     * Binary counterpart of the routes array. Per route `<prefix>.distance`, `.duration` and
+     * `.weight`, the overview as lon, lat pairs in `<prefix>.geometry` delimited by
+     * `<prefix>.geometry.offsets` and the range of legs in `<prefix>.legs.offsets`.
+     * Per leg `legs.distance`, `.duration`, `.weight` and `.summary` and the requested
+     * `annotation.*` arrays delimited by `annotation.offsets` (`annotation.nodes.offsets` for
+     * the nodes). Steps are only available in JSON.
+     */
+    void MakeRoutes(BinaryWriter &writer,
+                    const std::string &prefix,
+                    const std::vector<const InternalRouteResult *> &routes) const
+    {
+        std::vector<double> route_distances, route_durations, route_weights;
+        std::vector<double> geometry;
+        std::vector<std::uint32_t> geometry_offsets{0}, leg_offsets{0};
+        std::vector<double> leg_distances, leg_durations, leg_weights;
+        std::vector<std::string> leg_summaries;
+        std::vector<std::uint32_t> annotation_offsets{0}, node_offsets{0};
+        std::vector<double> speeds, durations, distances, weights;
+        std::vector<std::uint32_t> datasources;
+        std::vector<std::uint64_t> nodes;
+
+        const auto requested_annotations = RequestedAnnotations();
+        const auto requested = [requested_annotations](
+            const RouteParameters::AnnotationsType annotation) {
+            return static_cast<bool>(requested_annotations & annotation);
+        };
+
+        for (const auto route : routes)
+        {
+            const auto assembled = AssembleRoute(route->segment_end_coordinates,
+                                                 route->unpacked_path_segments,
+                                                 route->source_traversed_in_reverse,
+                                                 route->target_traversed_in_reverse);
+            route_distances.push_back(assembled.route.distance);
+            route_durations.push_back(assembled.route.duration);
+            route_weights.push_back(assembled.route.weight);
+
+            if (parameters.overview != RouteParameters::OverviewType::False)
+            {
+                const auto use_simplification =
+                    parameters.overview == RouteParameters::OverviewType::Simplified;
+                const auto overview =
+                    guidance::assembleOverview(assembled.leg_geometries, use_simplification);
+                for (const auto &coordinate : overview)
+                {
+                    geometry.push_back(static_cast<double>(util::toFloating(coordinate.lon)));
+                    geometry.push_back(static_cast<double>(util::toFloating(coordinate.lat)));
+                }
+                geometry_offsets.push_back(static_cast<std::uint32_t>(geometry.size() / 2));
+            }
+
+            for (const auto idx : util::irange<std::size_t>(0UL, assembled.legs.size()))
+            {
+                const auto &leg = assembled.legs[idx];
+                const auto &leg_geometry = assembled.leg_geometries[idx];
+                leg_distances.push_back(leg.distance);
+                leg_durations.push_back(leg.duration);
+                leg_weights.push_back(leg.weight);
+                leg_summaries.push_back(leg.summary);
+
+                for (const auto &annotation : leg_geometry.annotations)
+                {
+                    if (requested(RouteParameters::AnnotationsType::Speed))
+                        speeds.push_back(util::json::clamp_float(
+                            std::round(annotation.distance / annotation.duration * 10.) / 10.));
+                    if (requested(RouteParameters::AnnotationsType::Duration))
+                        durations.push_back(annotation.duration);
+                    if (requested(RouteParameters::AnnotationsType::Distance))
+                        distances.push_back(annotation.distance);
+                    if (requested(RouteParameters::AnnotationsType::Weight))
+                        weights.push_back(annotation.weight);
+                    if (requested(RouteParameters::AnnotationsType::Datasources))
+                        datasources.push_back(annotation.datasource);
+                }
+                annotation_offsets.push_back(
+                    static_cast<std::uint32_t>(annotation_offsets.back() +
+                                               leg_geometry.annotations.size()));
+
+                if (requested(RouteParameters::AnnotationsType::Nodes))
+                {
+                    for (const auto node_id : leg_geometry.osm_node_ids)
+                        nodes.push_back(static_cast<std::uint64_t>(node_id));
+                    node_offsets.push_back(static_cast<std::uint32_t>(nodes.size()));
+                }
+            }
+            leg_offsets.push_back(static_cast<std::uint32_t>(leg_distances.size()));
+        }
+
+        writer.Add(prefix + ".distance", route_distances);
+        writer.Add(prefix + ".duration", route_durations);
+        writer.Add(prefix + ".weight", route_weights);
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            writer.Add(prefix + ".geometry", geometry);
+            writer.Add(prefix + ".geometry.offsets", geometry_offsets);
+        }
+        writer.Add(prefix + ".legs.offsets", leg_offsets);
+        writer.Add("legs.distance", leg_distances);
+        writer.Add("legs.duration", leg_durations);
+        writer.Add("legs.weight", leg_weights);
+        writer.Add("legs.summary", leg_summaries);
+
+        if (requested_annotations != RouteParameters::AnnotationsType::None)
+        {
+            writer.Add("annotation.offsets", annotation_offsets);
+        }
+        if (requested(RouteParameters::AnnotationsType::Speed))
+            writer.Add("annotation.speed", speeds);
+        if (requested(RouteParameters::AnnotationsType::Duration))
+            writer.Add("annotation.duration", durations);
+        if (requested(RouteParameters::AnnotationsType::Distance))
+            writer.Add("annotation.distance", distances);
+        if (requested(RouteParameters::AnnotationsType::Weight))
+            writer.Add("annotation.weight", weights);
+        if (requested(RouteParameters::AnnotationsType::Datasources))
+            writer.Add("annotation.datasources", datasources);
+        if (requested(RouteParameters::AnnotationsType::Nodes))
+        {
+            writer.Add("annotation.nodes", nodes);
+            writer.Add("annotation.nodes.offsets", node_offsets);
+        }
+    }
+
     const RouteParameters &parameters;
 };
 
@@ -2,6 +2,7 @@
 #define ENGINE_API_TABLE_HPP
 
 #include "engine/api/base_api.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/json_factory.hpp"
 #include "engine/api/table_parameters.hpp"
 
@@ -16,10 +17,18 @@
 #include "engine/internal_route_result.hpp"
 
 #include "util/integer_range.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace osrm
 {
@@ -36,9 +45,156 @@ class TableAPI final : public BaseAPI
     {
     }
 
-    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
-                              const std::vector<PhantomNode> &phantoms,
-                              util::json::Object &response) const
+    virtual void
+    MakeResponse(const std::pair<std::vector<EdgeWeight>, std::vector<double>> &tables,
+                 const std::vector<PhantomNode> &phantoms,
+                 util::json::Object &response) const
+    {
+        std::size_t number_of_sources, number_of_destinations;
+        std::tie(number_of_sources, number_of_destinations) = AddWaypoints(phantoms, response);
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            response.values["durations"] =
+                MakeDurationTable(tables.first, number_of_sources, number_of_destinations);
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            response.values["distances"] =
+                MakeDistanceTable(tables.second, number_of_sources, number_of_destinations);
+        }
+
+        response.values["code"] = "Ok";
+    }
+
+    // Streams the matrices directly into the writer instead of building json::Array rows
+    virtual void
+    MakeResponse(const std::pair<std::vector<EdgeWeight>, std::vector<double>> &tables,
+                 const std::vector<PhantomNode> &phantoms,
+                 util::json::Writer &writer) const
+    {
+        // Same insertions as above with placeholders for the matrices, see Writer::Object
+        util::json::Object response;
+        std::size_t number_of_sources, number_of_destinations;
+        std::tie(number_of_sources, number_of_destinations) = AddWaypoints(phantoms, response);
+
+        const bool has_durations =
+            parameters.annotations & TableParameters::AnnotationsType::Duration;
+        const bool has_distances =
+            parameters.annotations & TableParameters::AnnotationsType::Distance;
+        if (has_durations)
+        {
+            response.values["durations"] = util::json::Null();
+        }
+        if (has_distances)
+        {
+            response.values["distances"] = util::json::Null();
+        }
+        response.values["code"] = "Ok";
+
+        const auto write_duration = [&writer](const EdgeWeight duration) {
+            if (duration == MAXIMAL_EDGE_DURATION)
+                writer.Null();
+            else
+                writer.Number(duration / 10.);
+        };
+        const auto write_distance = [&writer](const double distance) {
+            if (distance == INVALID_TABLE_DISTANCE)
+                writer.Null();
+            else
+                writer.Number(std::round(distance * 10) / 10.);
+        };
+
+        writer.Object(response, [&](const std::string &key) {
+            if (has_durations && key == "durations")
+            {
+                WriteTable(writer,
+                           tables.first,
+                           number_of_sources,
+                           number_of_destinations,
+                           write_duration);
+                return true;
+            }
+            if (has_distances && key == "distances")
+            {
+                WriteTable(writer,
+                           tables.second,
+                           number_of_sources,
+                           number_of_destinations,
+                           write_distance);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    // Row-major `durations` in seconds and `distances` in meters with NaN for missing entries,
+    // `dimensions` holds the number of rows and columns
+    virtual void
+    MakeResponse(const std::pair<std::vector<EdgeWeight>, std::vector<double>> &tables,
+                 const std::vector<PhantomNode> &phantoms,
+                 BinaryWriter &writer) const
+    {
+        const auto select = [&phantoms](const std::vector<std::size_t> &indices) {
+            std::vector<const PhantomNode *> selected;
+            if (indices.empty())
+            {
+                for (const auto &phantom : phantoms)
+                    selected.push_back(&phantom);
+            }
+            for (const auto index : indices)
+            {
+                BOOST_ASSERT(index < phantoms.size());
+                selected.push_back(&phantoms[index]);
+            }
+            return selected;
+        };
+        const auto sources = select(parameters.sources);
+        const auto destinations = select(parameters.destinations);
+
+        writer.Add("code", std::string("Ok"));
+        BaseAPI::MakeWaypoints(writer, "sources", sources);
+        BaseAPI::MakeWaypoints(writer, "destinations", destinations);
+        writer.Add("dimensions",
+                   std::vector<std::uint32_t>{static_cast<std::uint32_t>(sources.size()),
+                                              static_cast<std::uint32_t>(destinations.size())});
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            std::vector<double> durations(tables.first.size());
+            std::transform(tables.first.begin(),
+                           tables.first.end(),
+                           durations.begin(),
+                           [](const EdgeWeight duration) {
+                               if (duration == MAXIMAL_EDGE_DURATION)
+                                   return std::numeric_limits<double>::quiet_NaN();
+                               return duration / 10.;
+                           });
+            writer.Add("durations", durations);
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            std::vector<double> distances(tables.second.size());
+            std::transform(tables.second.begin(),
+                           tables.second.end(),
+                           distances.begin(),
+                           [](const double distance) {
+                               if (distance == INVALID_TABLE_DISTANCE)
+                                   return std::numeric_limits<double>::quiet_NaN();
+                               return std::round(distance * 10) / 10.;
+                           });
+            writer.Add("distances", distances);
+        }
+
+        writer.Finish();
+    }
+
+  protected:
+    // Adds the sources and destinations to the response and returns the table dimensions
+    std::pair<std::size_t, std::size_t> AddWaypoints(const std::vector<PhantomNode> &phantoms,
+                                                     util::json::Object &response) const
     {
         auto number_of_sources = parameters.sources.size();
         auto number_of_destinations = parameters.destinations.size();
@@ -64,12 +220,28 @@ class TableAPI final : public BaseAPI
             response.values["destinations"] = MakeWaypoints(phantoms, parameters.destinations);
         }
 
-        response.values["durations"] =
-            MakeTable(durations, number_of_sources, number_of_destinations);
-        response.values["code"] = "Ok";
+        return std::make_pair(number_of_sources, number_of_destinations);
+    }
+
+    template <typename T, typename WriteEntry>
+    void WriteTable(util::json::Writer &writer,
+                    const std::vector<T> &values,
+                    std::size_t number_of_rows,
+                    std::size_t number_of_columns,
+                    WriteEntry write_entry) const
+    {
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            auto row_begin_iterator = values.begin() + (row * number_of_columns);
+            auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
+            std::for_each(row_begin_iterator, row_end_iterator, write_entry);
+            writer.EndArray();
+        }
+        writer.EndArray();
     }
 
-  protected:
     virtual util::json::Array MakeWaypoints(const std::vector<PhantomNode> &phantoms) const
     {
         util::json::Array json_waypoints;
@@ -97,9 +269,9 @@ class TableAPI final : public BaseAPI
         return json_waypoints;
     }
 
-    virtual util::json::Array MakeTable(const std::vector<EdgeWeight> &values,
-                                        std::size_t number_of_rows,
-                                        std::size_t number_of_columns) const
+    virtual util::json::Array MakeDurationTable(const std::vector<EdgeWeight> &values,
+                                                std::size_t number_of_rows,
+                                                std::size_t number_of_columns) const
     {
         util::json::Array json_table;
         for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
@@ -123,6 +295,33 @@ class TableAPI final : public BaseAPI
         return json_table;
     }
 
+    virtual util::json::Array MakeDistanceTable(const std::vector<double> &values,
+                                                std::size_t number_of_rows,
+                                                std::size_t number_of_columns) const
+    {
+        util::json::Array json_table;
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            util::json::Array json_row;
+            auto row_begin_iterator = values.begin() + (row * number_of_columns);
+            auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
+            json_row.values.resize(number_of_columns);
+            std::transform(row_begin_iterator,
+                           row_end_iterator,
+                           json_row.values.begin(),
+                           [](const double distance) {
+                               if (distance == INVALID_TABLE_DISTANCE)
+                               {
+                                   return util::json::Value(util::json::Null());
+                               }
+                               return util::json::Value(
+                                   util::json::Number(std::round(distance * 10) / 10.));
+                           });
+            json_table.values.push_back(std::move(json_row));
+        }
+        return json_table;
+    }
+
     const TableParameters &parameters;
 };
 
@@ -14,6 +14,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -67,6 +68,10 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
         return facade_factory.Get(params);
     }
 
+    // The timestamp is changed after the facades, a facade fetched after reading the timestamp
+    // is never older than the data of that timestamp.
+    unsigned GetTimestamp() const { return timestamp; }
+
   private:
     void Run()
     {
@@ -87,7 +92,7 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
                         std::make_shared<datafacade::SharedMemoryAllocator>(region));
                 timestamp = barrier.data().timestamp;
                 util::Log() << "updated facade to region " << region << " with timestamp "
-                            << timestamp;
+                            << timestamp.load();
             }
         }
 
@@ -97,7 +102,7 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     storage::SharedMonitor<storage::SharedDataTimestamp> barrier;
     std::thread watcher;
     bool active;
-    unsigned timestamp;
+    std::atomic<unsigned> timestamp;
     DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT> facade_factory;
 };
 }
@@ -0,0 +1,54 @@
+#ifndef OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+#define OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+
+#include "storage/storage_config.hpp"
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <memory>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/**
+ * This allocator memory-maps a memory image of the dataset, the <base>.osrm.memory file
+ * or the file given as image_path.
+ * The image holds the data layout followed by the memory block in the same structure as
+ * shared memory, so the facades work on the mapped pages without copying them.
+ *
+ * If the image is missing, was written by another version or is older than one of the data
+ * files it is written once from the data files. Starting from an existing image only maps it,
+ * the pages are read lazily and shared through the page cache by all processes mapping it.
+ * If the image can't be written, e.g. next to read-only data files, the dataset is read
+ * into process memory like with ProcessMemoryAllocator.
+ */
+class MMapMemoryAllocator : public ContiguousBlockAllocator
+{
+  public:
+    MMapMemoryAllocator(const storage::StorageConfig &config,
+                        const boost::filesystem::path &image_path = {});
+    ~MMapMemoryAllocator() override final;
+
+    // interface to give access to the datafacades
+    storage::DataLayout &GetLayout() override final;
+    char *GetMemory() override final;
+
+  private:
+    boost::iostreams::mapped_file_source mapped_image;
+    std::unique_ptr<ProcessMemoryAllocator> fallback_allocator;
+    storage::DataLayout *layout;
+    char *memory;
+};
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
@@ -3,6 +3,7 @@
 
 #include "storage/storage_config.hpp"
 #include "engine/datafacade/contiguous_block_allocator.hpp"
+#include "util/huge_pages.hpp"
 
 #include <memory>
 
@@ -18,12 +19,20 @@ namespace datafacade
  * data into.  The structure and layout is the same as when using
  * shared memory.
  * This class holds a unique_ptr to the memory block, so it
- * is auto-freed upon destruction.
+ * is auto-freed upon destruction. The block can be backed
+ * by huge pages, see util::ProcessMemory.
+ *
+ * An allocator with a base only loads the metric blocks of
+ * its dataset, see DataLayout::IsMetricBlock. All other blocks
+ * are read from the base, which has to hold the same static data.
  */
 class ProcessMemoryAllocator : public ContiguousBlockAllocator
 {
   public:
-    explicit ProcessMemoryAllocator(const storage::StorageConfig &config);
+    ProcessMemoryAllocator(const storage::StorageConfig &config, const bool use_huge_pages);
+    ProcessMemoryAllocator(const storage::StorageConfig &config,
+                           const bool use_huge_pages,
+                           std::shared_ptr<ContiguousBlockAllocator> base);
     ~ProcessMemoryAllocator() override final;
 
     // interface to give access to the datafacades
@@ -31,8 +40,9 @@ class ProcessMemoryAllocator : public ContiguousBlockAllocator
     char *GetMemory() override final;
 
   private:
-    std::unique_ptr<char[]> internal_memory;
+    std::unique_ptr<util::ProcessMemory> internal_memory;
     std::unique_ptr<storage::DataLayout> internal_layout;
+    std::shared_ptr<ContiguousBlockAllocator> base_allocator;
 };
 
 } // namespace datafacade
@@ -19,6 +19,8 @@ namespace datafacade
 * This allocator uses an IPC shared memory block as the data location.
 * Many SharedMemoryDataFacade objects can be created that point to the same shared
 * memory block.
+* Regions of metric updates only hold the metric blocks, the allocator then also attaches
+* the full region they are based on.
 */
 class SharedMemoryAllocator : public ContiguousBlockAllocator
 {
@@ -32,6 +34,9 @@ class SharedMemoryAllocator : public ContiguousBlockAllocator
 
   private:
     std::unique_ptr<storage::SharedMemory> m_large_memory;
+    std::unique_ptr<storage::SharedMemory> m_base_memory;
+    // process local copy that points to the base region
+    storage::DataLayout m_layout;
 };
 
 } // namespace datafacade
@@ -7,6 +7,7 @@
 #include "engine/algorithm.hpp"
 #include "engine/api/base_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
+#include "engine/datafacade/contiguous_block_allocator.hpp"
 
 #include "util/integer_range.hpp"
 
@@ -14,13 +15,15 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace osrm
 {
 namespace engine
 {
-// This class selects the right facade for
+// This class selects the right facade for the exclude flags of a request. The facades are
+// created on first use, most exclude combinations are never requested.
 template <template <typename A> class FacadeT, typename AlgorithmT> class DataFacadeFactory
 {
     static constexpr auto has_exclude_flags = routing_algorithms::HasExcludeFlags<AlgorithmT>{};
@@ -44,12 +47,8 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
     // Algorithm with exclude flags
     template <typename AllocatorT>
     DataFacadeFactory(std::shared_ptr<AllocatorT> allocator, std::true_type)
+        : facades(std::make_shared<LazyFacades>(allocator))
     {
-        for (const auto index : util::irange<std::size_t>(0, facades.size()))
-        {
-            facades[index] = std::make_shared<const Facade>(allocator, index);
-        }
-
         properties = allocator->GetLayout().template GetBlockPtr<extractor::ProfileProperties>(
             allocator->GetMemory(), storage::DataLayout::PROPERTIES);
 
@@ -66,13 +65,13 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
     // Algorithm without exclude flags
     template <typename AllocatorT>
     DataFacadeFactory(std::shared_ptr<AllocatorT> allocator, std::false_type)
+        : facades(std::make_shared<LazyFacades>(allocator))
     {
-        facades[0] = std::make_shared<const Facade>(allocator, 0);
     }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &, std::false_type) const
     {
-        return facades[0];
+        return facades->Get(0);
     }
 
     // Default for non-exclude flags: return only facade
@@ -83,20 +82,20 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
             return {};
         }
 
-        return facades[0];
+        return facades->Get(0);
     }
 
     // TileParameters don't drive from BaseParameters and generally don't have use for exclude flags
     std::shared_ptr<const Facade> Get(const api::TileParameters &, std::true_type) const
     {
-        return facades[0];
+        return facades->Get(0);
     }
 
     // Selection logic for finding the corresponding datafacade for the given parameters
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params, std::true_type) const
     {
         if (params.exclude.empty())
-            return facades[0];
+            return facades->Get(0);
 
         extractor::ClassData mask = 0;
         for (const auto &name : params.exclude)
@@ -118,13 +117,36 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
         {
             auto exclude_index =
                 std::distance(properties->excludable_classes.begin(), exclude_iter);
-            return facades[exclude_index];
+            return facades->Get(exclude_index);
         }
 
         return {};
     }
 
-    std::array<std::shared_ptr<const Facade>, extractor::MAX_EXCLUDABLE_CLASSES> facades;
+    // Shared by all copies of the factory, the facades of an allocator are created only once
+    class LazyFacades
+    {
+      public:
+        template <typename AllocatorT>
+        LazyFacades(std::shared_ptr<AllocatorT> allocator) : allocator(std::move(allocator))
+        {
+        }
+
+        std::shared_ptr<const Facade> Get(const std::size_t exclude_index)
+        {
+            std::call_once(created[exclude_index], [&] {
+                facades[exclude_index] = std::make_shared<const Facade>(allocator, exclude_index);
+            });
+            return facades[exclude_index];
+        }
+
+      private:
+        std::shared_ptr<datafacade::ContiguousBlockAllocator> allocator;
+        std::array<std::once_flag, extractor::MAX_EXCLUDABLE_CLASSES> created;
+        std::array<std::shared_ptr<const Facade>, extractor::MAX_EXCLUDABLE_CLASSES> facades;
+    };
+
+    std::shared_ptr<LazyFacades> facades;
     std::unordered_map<std::string, extractor::ClassData> name_to_class;
     const extractor::ProfileProperties *properties = nullptr;
 };
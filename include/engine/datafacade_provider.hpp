@@ -4,9 +4,15 @@
 #include "engine/data_watchdog.hpp"
 #include "engine/datafacade.hpp"
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "engine/datafacade/mmap_memory_allocator.hpp"
 #include "engine/datafacade/process_memory_allocator.hpp"
 #include "engine/datafacade_factory.hpp"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 namespace osrm
 {
 namespace engine
@@ -23,6 +29,12 @@ template <typename AlgorithmT, template <typename A> class FacadeT> class DataFa
 
     virtual std::shared_ptr<const Facade> Get(const api::BaseParameters &) const = 0;
     virtual std::shared_ptr<const Facade> Get(const api::TileParameters &) const = 0;
+
+    // An empty name selects the default metric
+    virtual bool HasMetric(const std::string &metric) const = 0;
+
+    // Changes whenever the facades switch to new data, read it before fetching a facade
+    virtual unsigned GetTimestamp() const = 0;
 };
 
 template <typename AlgorithmT, template <typename A> class FacadeT>
@@ -31,9 +43,21 @@ class ImmutableProvider final : public DataFacadeProvider<AlgorithmT, FacadeT>
   public:
     using Facade = typename DataFacadeProvider<AlgorithmT, FacadeT>::Facade;
 
-    ImmutableProvider(const storage::StorageConfig &config)
-        : facade_factory(std::make_shared<datafacade::ProcessMemoryAllocator>(config))
+    ImmutableProvider(const storage::StorageConfig &config,
+                      const bool use_mmap,
+                      const boost::filesystem::path &memory_image_path,
+                      const bool use_huge_pages,
+                      const std::map<std::string, storage::StorageConfig> &metrics = {})
     {
+        auto allocator = MakeAllocator(config, use_mmap, memory_image_path, use_huge_pages);
+        facade_factory = DataFacadeFactory<FacadeT, AlgorithmT>(allocator);
+
+        for (const auto &name_and_config : metrics)
+        {
+            metric_factories[name_and_config.first] = DataFacadeFactory<FacadeT, AlgorithmT>(
+                std::make_shared<datafacade::ProcessMemoryAllocator>(
+                    name_and_config.second, use_huge_pages, allocator));
+        }
     }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const override final
@@ -42,11 +66,43 @@ class ImmutableProvider final : public DataFacadeProvider<AlgorithmT, FacadeT>
     }
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params) const override final
     {
-        return facade_factory.Get(params);
+        if (params.metric.empty())
+        {
+            return facade_factory.Get(params);
+        }
+
+        const auto factory = metric_factories.find(params.metric);
+        if (factory == metric_factories.end())
+        {
+            return {};
+        }
+        return factory->second.Get(params);
     }
 
+    bool HasMetric(const std::string &metric) const override final
+    {
+        return metric.empty() || metric_factories.count(metric) > 0;
+    }
+
+    // the data never changes
+    unsigned GetTimestamp() const override final { return 0; }
+
   private:
+    static std::shared_ptr<datafacade::ContiguousBlockAllocator>
+    MakeAllocator(const storage::StorageConfig &config,
+                  const bool use_mmap,
+                  const boost::filesystem::path &memory_image_path,
+                  const bool use_huge_pages)
+    {
+        if (use_mmap)
+        {
+            return std::make_shared<datafacade::MMapMemoryAllocator>(config, memory_image_path);
+        }
+        return std::make_shared<datafacade::ProcessMemoryAllocator>(config, use_huge_pages);
+    }
+
     DataFacadeFactory<FacadeT, AlgorithmT> facade_factory;
+    std::unordered_map<std::string, DataFacadeFactory<FacadeT, AlgorithmT>> metric_factories;
 };
 
 template <typename AlgorithmT, template <typename A> class FacadeT>
@@ -63,8 +119,17 @@ class WatchingProvider : public DataFacadeProvider<AlgorithmT, FacadeT>
     }
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params) const override final
     {
+        // osrm-datastore loads a single metric
+        if (!params.metric.empty())
+        {
+            return {};
+        }
         return watchdog.Get(params);
     }
+
+    bool HasMetric(const std::string &metric) const override final { return metric.empty(); }
+
+    unsigned GetTimestamp() const override final { return watchdog.GetTimestamp(); }
 };
 }
 
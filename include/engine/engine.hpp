@@ -1,6 +1,7 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -17,15 +18,19 @@
 #include "engine/plugins/tile.hpp"
 #include "engine/plugins/trip.hpp"
 #include "engine/plugins/viaroute.hpp"
+#include "engine/result_cache.hpp"
 #include "engine/routing_algorithms.hpp"
 #include "engine/status.hpp"
+#include "util/cache_statistics.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -38,29 +43,58 @@ class EngineInterface
     virtual ~EngineInterface() = default;
     virtual Status Route(const api::RouteParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Route(const api::RouteParameters &parameters,
+                         api::BinaryWriter &result) const = 0;
+    virtual Status Route(const api::RouteParameters &parameters,
+                         util::json::Writer &result) const = 0;
     virtual Status Table(const api::TableParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Table(const api::TableParameters &parameters,
+                         api::BinaryWriter &result) const = 0;
+    virtual Status Table(const api::TableParameters &parameters,
+                         util::json::Writer &result) const = 0;
     virtual Status Nearest(const api::NearestParameters &parameters,
                            util::json::Object &result) const = 0;
+    virtual Status Nearest(const api::NearestParameters &parameters,
+                           api::BinaryWriter &result) const = 0;
     virtual Status Trip(const api::TripParameters &parameters,
                         util::json::Object &result) const = 0;
     virtual Status Match(const api::MatchParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Match(const api::MatchParameters &parameters,
+                         api::BinaryWriter &result) const = 0;
+    virtual Status Match(const api::MatchParameters &parameters,
+                         util::json::Writer &result) const = 0;
+    virtual Status Match(const std::vector<api::MatchParameters> &parameters,
+                         const plugins::MatchPlugin::BatchCallback &callback) const = 0;
     virtual Status Tile(const api::TileParameters &parameters, std::string &result) const = 0;
+    virtual util::CacheStatistics TileCacheStatistics() const = 0;
+    virtual util::CacheStatistics ResultCacheStatistics() const = 0;
 };
 
 template <typename Algorithm> class Engine final : public EngineInterface
 {
   public:
     explicit Engine(const EngineConfig &config)
-        : route_plugin(config.max_locations_viaroute, config.max_alternatives), //
-          table_plugin(config.max_locations_distance_table),                    //
+        : result_cache(static_cast<std::size_t>(config.max_result_cache_memory) * 1024 * 1024),
+          route_plugin(config.max_locations_viaroute,
+                       config.max_alternatives,
+                       config.max_alternative_threads,
+                       result_cache),                                           //
+          table_plugin(config.max_locations_distance_table,
+                       config.max_table_threads,
+                       config.max_table_memory,
+                       result_cache),                                           //
           nearest_plugin(config.max_results_nearest),                           //
-          trip_plugin(config.max_locations_trip),                               //
-          match_plugin(config.max_locations_map_matching),                      //
-          tile_plugin()                                                         //
+          trip_plugin(config.max_locations_trip, config.max_trip_threads),      //
+          match_plugin(config.max_locations_map_matching,
+                       config.max_match_threads),                               //
+          tile_plugin(static_cast<std::size_t>(config.max_tile_cache_memory) * 1024 * 1024) //
 
     {
+        heaps.max_heap_index_memory =
+            static_cast<std::size_t>(config.max_heap_index_memory) * 1024 * 1024;
+
         if (config.use_shared_memory)
         {
             util::Log(logDEBUG) << "Using shared memory with algorithm "
@@ -69,9 +103,15 @@ template <typename Algorithm> class Engine final : public EngineInterface
         }
         else
         {
-            util::Log(logDEBUG) << "Using internal memory with algorithm "
+            util::Log(logDEBUG) << "Using " << (config.use_mmap ? "memory mapped" : "internal")
+                                << " memory with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config);
+            facade_provider =
+                std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config,
+                                                               config.use_mmap,
+                                                               config.memory_image_path,
+                                                               config.use_huge_pages,
+                                                               config.metrics);
         }
     }
 
@@ -85,13 +125,43 @@ template <typename Algorithm> class Engine final : public EngineInterface
     Status Route(const api::RouteParameters &params,
                  util::json::Object &result) const override final
     {
-        return route_plugin.HandleRequest(GetAlgorithms(params), params, result);
+        const auto timestamp = facade_provider->GetTimestamp();
+        return route_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
+    }
+
+    Status Route(const api::RouteParameters &params,
+                 api::BinaryWriter &result) const override final
+    {
+        const auto timestamp = facade_provider->GetTimestamp();
+        return route_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
+    }
+
+    Status Route(const api::RouteParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        const auto timestamp = facade_provider->GetTimestamp();
+        return route_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
     }
 
     Status Table(const api::TableParameters &params,
                  util::json::Object &result) const override final
     {
-        return table_plugin.HandleRequest(GetAlgorithms(params), params, result);
+        const auto timestamp = facade_provider->GetTimestamp();
+        return table_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
+    }
+
+    Status Table(const api::TableParameters &params,
+                 api::BinaryWriter &result) const override final
+    {
+        const auto timestamp = facade_provider->GetTimestamp();
+        return table_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
+    }
+
+    Status Table(const api::TableParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        const auto timestamp = facade_provider->GetTimestamp();
+        return table_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
     }
 
     Status Nearest(const api::NearestParameters &params,
@@ -100,6 +170,12 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return nearest_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
+    Status Nearest(const api::NearestParameters &params,
+                   api::BinaryWriter &result) const override final
+    {
+        return nearest_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
     Status Trip(const api::TripParameters &params, util::json::Object &result) const override final
     {
         return trip_plugin.HandleRequest(GetAlgorithms(params), params, result);
@@ -111,21 +187,64 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return match_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
+    Status Match(const api::MatchParameters &params,
+                 api::BinaryWriter &result) const override final
+    {
+        return match_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
+    Status Match(const api::MatchParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        return match_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
+    Status Match(const std::vector<api::MatchParameters> &params,
+                 const plugins::MatchPlugin::BatchCallback &callback) const override final
+    {
+        if (params.empty())
+        {
+            return Status::Ok;
+        }
+        // the facade is selected once for the whole batch
+        return match_plugin.HandleRequest(GetAlgorithms(params.front()), params, callback);
+    }
+
     Status Tile(const api::TileParameters &params, std::string &result) const override final
     {
-        return tile_plugin.HandleRequest(GetAlgorithms(params), params, result);
+        // read before the facade, a tile of new data may be cached under the old timestamp
+        // but never the other way round
+        const auto timestamp = facade_provider->GetTimestamp();
+        return tile_plugin.HandleRequest(GetAlgorithms(params), params, timestamp, result);
+    }
+
+    util::CacheStatistics TileCacheStatistics() const override final
+    {
+        return tile_plugin.GetCacheStatistics();
+    }
+
+    util::CacheStatistics ResultCacheStatistics() const override final
+    {
+        return result_cache.GetStatistics();
     }
 
     static bool CheckCompability(const EngineConfig &config);
 
   private:
-    template <typename ParametersT> auto GetAlgorithms(const ParametersT &params) const
+    auto GetAlgorithms(const api::BaseParameters &params) const
+    {
+        return RoutingAlgorithms<Algorithm>{
+            heaps, facade_provider->Get(params), facade_provider->HasMetric(params.metric)};
+    }
+    auto GetAlgorithms(const api::TileParameters &params) const
     {
         return RoutingAlgorithms<Algorithm>{heaps, facade_provider->Get(params)};
     }
     std::unique_ptr<DataFacadeProvider<Algorithm>> facade_provider;
     mutable SearchEngineData<Algorithm> heaps;
 
+    // shared by the route and table plugins, declared before them
+    const ResultCache result_cache;
     const plugins::ViaRoutePlugin route_plugin;
     const plugins::TablePlugin table_plugin;
     const plugins::NearestPlugin nearest_plugin;
@@ -32,6 +32,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <map>
 #include <string>
 
 namespace osrm
@@ -53,7 +54,43 @@ namespace engine
  *  - Match
  *  - Nearest
  *
+ * The forward searches of a single Table request can be split across several threads
+ * with max_table_threads. max_table_memory bounds the memory in MiB (-1 for unlimited) that
+ * the additional search heaps of one such request may use, fewer threads are used otherwise.
+ *
+ * The traces of a batch Match request are matched on up to max_match_threads threads.
+ *
+ * MLD unpacks the candidates for the alternatives of a Route request on up to
+ * max_alternative_threads threads.
+ *
+ * Trips with more locations than the exact solver handles are improved by several local search
+ * restarts, run on up to max_trip_threads threads.
+ *
+ * Search heaps index their nodes with a hash map by default. If max_heap_index_memory is set,
+ * every heap whose array based index for all nodes of the graph needs at most that many MiB
+ * uses generation stamped arrays with constant time lookups instead.
+ *
+ * Encoded vector tiles are cached in up to max_tile_cache_memory MiB (0 disables the cache).
+ * The cache is emptied when osrm-datastore loads new data into shared memory.
+ *
+ * Serialized route and table responses are cached the same way in up to
+ * max_result_cache_memory MiB (0 disables the cache). Requests are looked up by their
+ * parameters and snapped coordinates, only responses rendered with util::json::Writer or
+ * api::BinaryWriter (as by osrm-routed) are cached.
+ *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * Without osrm-datastore, use_mmap maps a memory image of the dataset instead of reading
+ * all files into process memory. The image is written on the first start, next to the data
+ * files or to memory_image_path, and shared through the page cache by all processes mapping it.
+ * If it can't be written the data is read into process memory instead.
+ * Data read into process memory is backed by huge pages with use_huge_pages, which saves TLB
+ * misses on the random accesses of the searches. osrm-datastore has its own --huge-pages.
+ *
+ * Datasets loaded from files can be queried with several metrics. Every entry of metrics names
+ * a dataset that was customized (or contracted) with other weights from the same extracted and
+ * partitioned data. Only its weights, durations, graph and cell metrics are loaded, all other
+ * data is shared with storage_config. Requests pick a metric by name with
+ * BaseParameters::metric.
  *
  * You can chose between three algorithms:
  *  - Algorithm::CH
@@ -88,7 +125,19 @@ struct EngineConfig final
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
     int max_alternatives = 3; // set an arbitrary upper bound; can be adjusted by user
+    int max_alternative_threads = 1; // 1 unpacks all alternative candidates on the calling thread
+    int max_table_threads = 1; // 1 runs all searches of a table request on the calling thread
+    int max_table_memory = -1;
+    int max_match_threads = 1; // 1 matches all traces of a batch on the calling thread
+    int max_trip_threads = 1;  // 1 runs all local search restarts on the calling thread
+    int max_heap_index_memory = 0; // 0 always indexes heap nodes with a hash map
+    int max_tile_cache_memory = 0;
+    int max_result_cache_memory = 0;
     bool use_shared_memory = true;
+    bool use_mmap = false;
+    boost::filesystem::path memory_image_path; // empty keeps <base>.osrm.memory
+    bool use_huge_pages = false;
+    std::map<std::string, storage::StorageConfig> metrics;
     Algorithm algorithm = Algorithm::CH;
 };
 }
@@ -7,6 +7,9 @@
 
 #include "util/json_util.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace osrm
@@ -22,19 +25,40 @@ class MatchPlugin : public BasePlugin
     using SubMatching = map_matching::SubMatching;
     using SubMatchingList = routing_algorithms::SubMatchingList;
     using CandidateLists = routing_algorithms::CandidateLists;
+    // Receives the index of a trace of a batch with its status and response
+    using BatchCallback =
+        std::function<void(const std::size_t, const Status, util::json::Object &)>;
     static const constexpr double RADIUS_MULTIPLIER = 3;
+    // Bytes of candidates a batch keeps to share between its traces
+    static const constexpr std::size_t CANDIDATE_CACHE_SIZE = 16 * 1024 * 1024;
 
-    MatchPlugin(const int max_locations_map_matching)
-        : max_locations_map_matching(max_locations_map_matching)
+    MatchPlugin(const int max_locations_map_matching, const int max_match_threads)
+        : max_locations_map_matching(max_locations_map_matching),
+          max_match_threads(static_cast<std::size_t>(std::max(max_match_threads, 1)))
     {
     }
 
+    template <typename ResultT>
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::MatchParameters &parameters,
-                         util::json::Object &json_result) const;
+                         ResultT &json_result) const;
+
+    // Matches the traces of a batch on up to max_match_threads threads. The callback is called
+    // for every trace as soon as it is matched, the calls are serialized. Candidates of equal
+    // coordinates are looked up once per batch, as long as they stay in a bounded cache.
+    Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                         const std::vector<api::MatchParameters> &parameters,
+                         const BatchCallback &callback) const;
 
   private:
+    template <typename ResultT, typename GetCandidates>
+    Status MatchTrace(const RoutingAlgorithmsInterface &algorithms,
+                      const api::MatchParameters &parameters,
+                      GetCandidates &&get_candidates,
+                      ResultT &json_result) const;
+
     const int max_locations_map_matching;
+    const std::size_t max_match_threads;
 };
 }
 }
@@ -19,9 +19,10 @@ class NearestPlugin final : public BasePlugin
   public:
     explicit NearestPlugin(const int max_results);
 
+    template <typename ResultT>
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::NearestParameters &params,
-                         util::json::Object &result) const;
+                         ResultT &result) const;
 
   private:
     const int max_results;
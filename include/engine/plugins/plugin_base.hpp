@@ -2,6 +2,7 @@
 #define BASE_PLUGIN_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/routing_algorithms.hpp"
@@ -11,6 +12,7 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -37,15 +39,22 @@ class BasePlugin
             });
     }
 
+    template <typename ResultT>
     bool CheckAlgorithms(const api::BaseParameters &params,
                          const RoutingAlgorithmsInterface &algorithms,
-                         util::json::Object &result) const
+                         ResultT &result) const
     {
         if (algorithms.IsValid())
         {
             return true;
         }
 
+        // without the metric there is no facade to check the exclude flags against
+        if (!algorithms.HasMetric())
+        {
+            Error("InvalidValue", "Metric " + params.metric + " is not loaded.", result);
+            return false;
+        }
         if (!algorithms.HasExcludeFlags() && !params.exclude.empty())
         {
             Error("NotImplemented", "This algorithm does not support exclude flags.", result);
@@ -57,8 +66,8 @@ class BasePlugin
             return false;
         }
 
-        BOOST_ASSERT_MSG(false,
-                         "There are only two reasons why the algorithm interface can be invalid.");
+        BOOST_ASSERT_MSG(
+            false, "There are only three reasons why the algorithm interface can be invalid.");
         return false;
     }
 
@@ -71,6 +80,26 @@ class BasePlugin
         return Status::Error;
     }
 
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 util::json::Writer &writer) const
+    {
+        util::json::Object json_result;
+        Error(code, message, json_result);
+        writer.Value(json_result);
+        return Status::Error;
+    }
+
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 api::BinaryWriter &writer) const
+    {
+        writer.Add("code", code);
+        writer.Add("message", message);
+        writer.Finish();
+        return Status::Error;
+    }
+
     // Decides whether to use the phantom node from a big or small component if both are found.
     // Returns true if all phantom nodes are in the same component after snapping.
     std::vector<PhantomNode>
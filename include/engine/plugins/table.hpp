@@ -4,6 +4,7 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "engine/api/table_parameters.hpp"
+#include "engine/result_cache.hpp"
 #include "engine/routing_algorithms.hpp"
 
 #include "util/json_container.hpp"
@@ -18,14 +19,22 @@ namespace plugins
 class TablePlugin final : public BasePlugin
 {
   public:
-    explicit TablePlugin(const int max_locations_distance_table);
+    explicit TablePlugin(const int max_locations_distance_table,
+                         const int max_table_threads,
+                         const int max_table_memory,
+                         const ResultCache &result_cache);
 
+    // timestamp has to be read before the facade of algorithms was fetched
+    template <typename ResultT>
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TableParameters &params,
-                         util::json::Object &result) const;
+                         const unsigned timestamp,
+                         ResultT &result) const;
 
   private:
     const int max_locations_distance_table;
+    routing_algorithms::ManyToManyConcurrency concurrency;
+    const ResultCache &result_cache;
 };
 }
 }
@@ -5,6 +5,13 @@
 #include "engine/plugins/plugin_base.hpp"
 #include "engine/routing_algorithms.hpp"
 
+#include "util/cache_statistics.hpp"
+#include "util/lru_cache.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -15,6 +22,9 @@
  * to display maps that show the exact road network that
  * OSRM is routing.  This is very useful for debugging routing
  * errors
+ *
+ * Encoded tiles can be kept in a cache of max_cache_size bytes, a map viewer requests the
+ * same tiles over and over. The cache is emptied once the data timestamp changes.
  */
 namespace osrm
 {
@@ -26,9 +36,37 @@ namespace plugins
 class TilePlugin final : public BasePlugin
 {
   public:
+    // a max_cache_size of 0 disables the cache
+    explicit TilePlugin(const std::size_t max_cache_size = 0);
+
+    // timestamp has to be read before the facade of algorithms was fetched
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TileParameters &parameters,
+                         const unsigned timestamp,
                          std::string &pbf_buffer) const;
+
+    util::CacheStatistics GetCacheStatistics() const { return cache.GetStatistics(); }
+
+  private:
+    struct TileKey
+    {
+        unsigned timestamp;
+        unsigned x;
+        unsigned y;
+        unsigned z;
+
+        bool operator==(const TileKey &other) const
+        {
+            return timestamp == other.timestamp && x == other.x && y == other.y && z == other.z;
+        }
+    };
+    struct TileKeyHash
+    {
+        std::size_t operator()(const TileKey &key) const;
+    };
+
+    mutable util::LRUCache<TileKey, std::shared_ptr<const std::string>, TileKeyHash> cache;
+    mutable std::atomic<unsigned> cache_timestamp;
 };
 }
 }
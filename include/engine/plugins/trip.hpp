@@ -29,6 +29,7 @@ class TripPlugin final : public BasePlugin
 {
   private:
     const int max_locations_trip;
+    const std::size_t max_trip_threads;
 
     InternalRouteResult ComputeRoute(const RoutingAlgorithmsInterface &algorithms,
                                      const std::vector<PhantomNode> &phantom_node_list,
@@ -36,7 +37,11 @@ class TripPlugin final : public BasePlugin
                                      const bool roundtrip) const;
 
   public:
-    explicit TripPlugin(const int max_locations_trip_) : max_locations_trip(max_locations_trip_) {}
+    TripPlugin(const int max_locations_trip_, const int max_trip_threads_)
+        : max_locations_trip(max_locations_trip_),
+          max_trip_threads(static_cast<std::size_t>(std::max(max_trip_threads_, 1)))
+    {
+    }
 
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TripParameters &parameters,
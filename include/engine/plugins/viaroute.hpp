@@ -4,6 +4,7 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "engine/api/route_parameters.hpp"
+#include "engine/result_cache.hpp"
 #include "engine/routing_algorithms.hpp"
 
 #include "util/json_container.hpp"
@@ -27,13 +28,21 @@ class ViaRoutePlugin final : public BasePlugin
   private:
     const int max_locations_viaroute;
     const int max_alternatives;
+    const std::size_t max_alternative_threads;
+    const ResultCache &result_cache;
 
   public:
-    explicit ViaRoutePlugin(int max_locations_viaroute, int max_alternatives);
+    explicit ViaRoutePlugin(int max_locations_viaroute,
+                            int max_alternatives,
+                            int max_alternative_threads,
+                            const ResultCache &result_cache);
 
+    // timestamp has to be read before the facade of algorithms was fetched
+    template <typename ResultT>
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::RouteParameters &route_parameters,
-                         util::json::Object &json_result) const;
+                         const unsigned timestamp,
+                         ResultT &json_result) const;
 };
 }
 }
@@ -0,0 +1,138 @@
+#ifndef ENGINE_RESULT_CACHE_HPP
+#define ENGINE_RESULT_CACHE_HPP
+
+#include "engine/api/binary_writer.hpp"
+#include "engine/api/route_parameters.hpp"
+#include "engine/api/table_parameters.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/status.hpp"
+
+#include "util/cache_statistics.hpp"
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+#include "util/lru_cache.hpp"
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Memory bounded LRU cache of serialized route and table responses, shared by all threads of
+ * an Engine.
+ *
+ * Entries are keyed on the normalized request parameters, the snapped phantom nodes and the data
+ * timestamp. Parameters that only select the phantom nodes (hints, bearings, radiuses and
+ * approaches) are left out. The coordinates are only keyed as the input location of the phantom
+ * nodes, it sets the depart and arrive bearings and the hints. The cache is emptied once the data
+ * timestamp changes, i.e. when osrm-datastore loads new data.
+ *
+ * Only responses written with util::json::Writer or api::BinaryWriter are cached, json::Object
+ * results are always computed. A max_size of 0 disables the cache.
+ */
+class ResultCache
+{
+  public:
+    explicit ResultCache(const std::size_t max_size) : cache(max_size), cache_timestamp(0) {}
+
+    bool IsEnabled() const { return cache.GetMaxSize() > 0; }
+
+    static std::string MakeKey(const api::RouteParameters &parameters,
+                               const std::vector<PhantomNode> &snapped_phantoms);
+    static std::string MakeKey(const api::TableParameters &parameters,
+                               const std::vector<PhantomNode> &snapped_phantoms);
+
+    // Writes the cached response for the key returned by make_key() or calls make_response() and
+    // caches what it wrote if it returned Status::Ok. The timestamp has to be read before the
+    // facade was fetched.
+    template <typename KeyMaker, typename ResponseMaker>
+    Status Serve(const unsigned /*timestamp*/,
+                 KeyMaker && /*make_key*/,
+                 util::json::Object & /*result*/,
+                 ResponseMaker &&make_response) const
+    {
+        return make_response();
+    }
+
+    template <typename KeyMaker, typename ResponseMaker>
+    Status Serve(const unsigned timestamp,
+                 KeyMaker &&make_key,
+                 util::json::Writer &result,
+                 ResponseMaker &&make_response) const
+    {
+        return ServeSerialized(
+            timestamp, 'j', make_key, result, result.Buffer().size(), make_response);
+    }
+
+    template <typename KeyMaker, typename ResponseMaker>
+    Status Serve(const unsigned timestamp,
+                 KeyMaker &&make_key,
+                 api::BinaryWriter &result,
+                 ResponseMaker &&make_response) const
+    {
+        // Finish replaces the whole buffer
+        return ServeSerialized(timestamp, 'b', make_key, result, 0, make_response);
+    }
+
+    util::CacheStatistics GetStatistics() const { return cache.GetStatistics(); }
+
+  private:
+    template <typename KeyMaker, typename WriterT, typename ResponseMaker>
+    Status ServeSerialized(const unsigned timestamp,
+                           const char format,
+                           KeyMaker &make_key,
+                           WriterT &result,
+                           const std::size_t offset,
+                           ResponseMaker &make_response) const
+    {
+        if (!IsEnabled())
+        {
+            return make_response();
+        }
+
+        Invalidate(timestamp);
+
+        // the timestamp keeps responses of old data from being returned while other threads
+        // still see the previous timestamp
+        std::string full_key(reinterpret_cast<const char *>(&timestamp), sizeof(timestamp));
+        full_key.push_back(format);
+        full_key.append(make_key());
+
+        std::shared_ptr<const std::string> cached_response;
+        if (cache.Get(full_key, cached_response))
+        {
+            result.Raw(*cached_response);
+            return Status::Ok;
+        }
+
+        const auto status = make_response();
+        if (status == Status::Ok)
+        {
+            const auto &buffer = result.Buffer();
+            BOOST_ASSERT(buffer.size() >= offset);
+            auto response = std::make_shared<const std::string>(buffer.begin() + offset,
+                                                                buffer.end());
+            const auto size = full_key.size() + response->size();
+            cache.Put(full_key, std::move(response), size);
+        }
+        return status;
+    }
+
+    // Empties the cache once the data timestamp changed
+    void Invalidate(const unsigned timestamp) const;
+
+    mutable util::LRUCache<std::string, std::shared_ptr<const std::string>> cache;
+    mutable std::atomic<unsigned> cache_timestamp;
+};
+}
+}
+
+#endif
@@ -21,7 +21,8 @@ class RoutingAlgorithmsInterface
   public:
     virtual InternalManyRoutesResult
     AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                          unsigned number_of_alternatives) const = 0;
+                          unsigned number_of_alternatives,
+                          const std::size_t max_threads) const = 0;
 
     virtual InternalRouteResult
     ShortestPathSearch(const std::vector<PhantomNodes> &phantom_node_pair,
@@ -30,10 +31,12 @@ class RoutingAlgorithmsInterface
     virtual InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_node_pair) const = 0;
 
-    virtual std::vector<EdgeWeight>
+    virtual std::pair<std::vector<EdgeWeight>, std::vector<double>>
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
-                     const std::vector<std::size_t> &target_indices) const = 0;
+                     const std::vector<std::size_t> &target_indices,
+                     const bool calculate_distance,
+                     const routing_algorithms::ManyToManyConcurrency &concurrency) const = 0;
 
     virtual routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -55,6 +58,7 @@ class RoutingAlgorithmsInterface
     virtual bool HasManyToManySearch() const = 0;
     virtual bool HasGetTileTurns() const = 0;
     virtual bool HasExcludeFlags() const = 0;
+    virtual bool HasMetric() const = 0;
     virtual bool IsValid() const = 0;
 };
 
@@ -63,16 +67,18 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
 {
   public:
     RoutingAlgorithms(SearchEngineData<Algorithm> &heaps,
-                      std::shared_ptr<const DataFacade<Algorithm>> facade)
-        : heaps(heaps), facade(facade)
+                      std::shared_ptr<const DataFacade<Algorithm>> facade,
+                      const bool has_metric = true)
+        : heaps(heaps), facade(facade), has_metric(has_metric)
     {
     }
 
     virtual ~RoutingAlgorithms() = default;
 
-    InternalManyRoutesResult
-    AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                          unsigned number_of_alternatives) const final override;
+    InternalManyRoutesResult AlternativePathSearch(const PhantomNodes &phantom_node_pair,
+                                                   unsigned number_of_alternatives,
+                                                   const std::size_t max_threads) const
+        final override;
 
     InternalRouteResult ShortestPathSearch(
         const std::vector<PhantomNodes> &phantom_node_pair,
@@ -81,10 +87,13 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
     InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_nodes) const final override;
 
-    std::vector<EdgeWeight>
+    std::pair<std::vector<EdgeWeight>, std::vector<double>>
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
-                     const std::vector<std::size_t> &target_indices) const final override;
+                     const std::vector<std::size_t> &target_indices,
+                     const bool calculate_distance,
+                     const routing_algorithms::ManyToManyConcurrency &concurrency) const
+        final override;
 
     routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -134,20 +143,25 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
         return routing_algorithms::HasExcludeFlags<Algorithm>::value;
     }
 
+    bool HasMetric() const final override { return has_metric; }
+
     bool IsValid() const final override { return static_cast<bool>(facade); }
 
   private:
     SearchEngineData<Algorithm> &heaps;
     std::shared_ptr<const DataFacade<Algorithm>> facade;
+    // false if the requested metric is not loaded, the facade is empty then
+    const bool has_metric;
 };
 
 template <typename Algorithm>
 InternalManyRoutesResult
 RoutingAlgorithms<Algorithm>::AlternativePathSearch(const PhantomNodes &phantom_node_pair,
-                                                    unsigned number_of_alternatives) const
+                                                    unsigned number_of_alternatives,
+                                                    const std::size_t max_threads) const
 {
     return routing_algorithms::alternativePathSearch(
-        heaps, *facade, phantom_node_pair, number_of_alternatives);
+        heaps, *facade, phantom_node_pair, number_of_alternatives, max_threads);
 }
 
 template <typename Algorithm>
@@ -167,13 +181,21 @@ RoutingAlgorithms<Algorithm>::DirectShortestPathSearch(const PhantomNodes &phant
 }
 
 template <typename Algorithm>
-std::vector<EdgeWeight>
-RoutingAlgorithms<Algorithm>::ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
-                                               const std::vector<std::size_t> &source_indices,
-                                               const std::vector<std::size_t> &target_indices) const
+std::pair<std::vector<EdgeWeight>, std::vector<double>>
+RoutingAlgorithms<Algorithm>::ManyToManySearch(
+    const std::vector<PhantomNode> &phantom_nodes,
+    const std::vector<std::size_t> &source_indices,
+    const std::vector<std::size_t> &target_indices,
+    const bool calculate_distance,
+    const routing_algorithms::ManyToManyConcurrency &concurrency) const
 {
-    return routing_algorithms::manyToManySearch(
-        heaps, *facade, phantom_nodes, source_indices, target_indices);
+    return routing_algorithms::manyToManySearch(heaps,
+                                                *facade,
+                                                phantom_nodes,
+                                                source_indices,
+                                                target_indices,
+                                                calculate_distance,
+                                                concurrency);
 }
 
 template <typename Algorithm>
@@ -205,17 +227,20 @@ inline std::vector<routing_algorithms::TurnData> RoutingAlgorithms<Algorithm>::G
 template <>
 InternalManyRoutesResult inline RoutingAlgorithms<
     routing_algorithms::corech::Algorithm>::AlternativePathSearch(const PhantomNodes &,
-                                                                  unsigned) const
+                                                                  unsigned,
+                                                                  const std::size_t) const
 {
     throw util::exception("AlternativePathSearch is disabled due to performance reasons");
 }
 
 template <>
-inline std::vector<EdgeWeight>
+inline std::pair<std::vector<EdgeWeight>, std::vector<double>>
 RoutingAlgorithms<routing_algorithms::corech::Algorithm>::ManyToManySearch(
     const std::vector<PhantomNode> &,
     const std::vector<std::size_t> &,
-    const std::vector<std::size_t> &) const
+    const std::vector<std::size_t> &,
+    const bool,
+    const routing_algorithms::ManyToManyConcurrency &) const
 {
     throw util::exception("ManyToManySearch is disabled due to performance reasons");
 }
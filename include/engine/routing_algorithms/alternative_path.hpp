@@ -9,6 +9,8 @@
 
 #include "util/exception.hpp"
 
+#include <cstddef>
+
 namespace osrm
 {
 namespace engine
@@ -19,12 +21,15 @@ namespace routing_algorithms
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<ch::Algorithm> &search_engine_data,
                                                const DataFacade<ch::Algorithm> &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives);
+                                               unsigned number_of_alternatives,
+                                               const std::size_t max_threads);
 
+// MLD unpacks the alternative candidates on up to max_threads threads, CH has no use for them.
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<mld::Algorithm> &search_engine_data,
                                                const DataFacade<mld::Algorithm> &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives);
+                                               unsigned number_of_alternatives,
+                                               const std::size_t max_threads);
 
 } // namespace routing_algorithms
 } // namespace engine
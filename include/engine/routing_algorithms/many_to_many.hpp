@@ -7,6 +7,9 @@
 
 #include "util/typedefs.hpp"
 
+#include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -16,12 +19,29 @@ namespace engine
 namespace routing_algorithms
 {
 
+// Limits how a single many-to-many query may split its forward searches across threads.
+// The forward searches only share the read-only buckets of the backward searches, so each
+// thread uses its own thread local heap. The number of threads is reduced until the estimated
+// memory of all heaps, including array node indices, fits into max_heap_memory bytes. The
+// defaults run all searches serially.
+struct ManyToManyConcurrency
+{
+    std::size_t max_threads = 1;
+    std::size_t max_heap_memory = std::numeric_limits<std::size_t>::max();
+};
+
+// Returns the durations and, if calculate_distance is set, the distances in meters of all
+// entries in row-major order. Unreachable entries are MAXIMAL_EDGE_DURATION and
+// INVALID_TABLE_DISTANCE, the distances are empty if they were not requested.
 template <typename Algorithm>
-std::vector<EdgeWeight> manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
-                                         const DataFacade<Algorithm> &facade,
-                                         const std::vector<PhantomNode> &phantom_nodes,
-                                         const std::vector<std::size_t> &source_indices,
-                                         const std::vector<std::size_t> &target_indices);
+std::pair<std::vector<EdgeWeight>, std::vector<double>>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const DataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices,
+                 const bool calculate_distance = false,
+                 const ManyToManyConcurrency &concurrency = {});
 
 } // namespace routing_algorithms
 } // namespace engine
@@ -44,40 +44,52 @@ bool needsLoopBackwards(const PhantomNode &source_phantom, const PhantomNode &ta
 bool needsLoopForward(const PhantomNodes &phantoms);
 bool needsLoopBackwards(const PhantomNodes &phantoms);
 
-template <typename Heap>
-void insertNodesInHeaps(Heap &forward_heap, Heap &reverse_heap, const PhantomNodes &nodes)
+template <bool DIRECTION, typename Heap>
+void insertNodesInHeap(Heap &heap, const PhantomNode &phantom_node)
 {
-    const auto &source = nodes.source_phantom;
-    if (source.IsValidForwardSource())
+    // source nodes are inserted with negative offsets into the forward heap,
+    // target nodes with positive offsets into the reverse heap
+    if (DIRECTION == FORWARD_DIRECTION)
     {
-        forward_heap.Insert(source.forward_segment_id.id,
-                            -source.GetForwardWeightPlusOffset(),
-                            source.forward_segment_id.id);
-    }
+        if (phantom_node.IsValidForwardSource())
+        {
+            heap.Insert(phantom_node.forward_segment_id.id,
+                        -phantom_node.GetForwardWeightPlusOffset(),
+                        phantom_node.forward_segment_id.id);
+        }
 
-    if (source.IsValidReverseSource())
-    {
-        forward_heap.Insert(source.reverse_segment_id.id,
-                            -source.GetReverseWeightPlusOffset(),
-                            source.reverse_segment_id.id);
+        if (phantom_node.IsValidReverseSource())
+        {
+            heap.Insert(phantom_node.reverse_segment_id.id,
+                        -phantom_node.GetReverseWeightPlusOffset(),
+                        phantom_node.reverse_segment_id.id);
+        }
     }
-
-    const auto &target = nodes.target_phantom;
-    if (target.IsValidForwardTarget())
+    else
     {
-        reverse_heap.Insert(target.forward_segment_id.id,
-                            target.GetForwardWeightPlusOffset(),
-                            target.forward_segment_id.id);
-    }
+        if (phantom_node.IsValidForwardTarget())
+        {
+            heap.Insert(phantom_node.forward_segment_id.id,
+                        phantom_node.GetForwardWeightPlusOffset(),
+                        phantom_node.forward_segment_id.id);
+        }
 
-    if (target.IsValidReverseTarget())
-    {
-        reverse_heap.Insert(target.reverse_segment_id.id,
-                            target.GetReverseWeightPlusOffset(),
-                            target.reverse_segment_id.id);
+        if (phantom_node.IsValidReverseTarget())
+        {
+            heap.Insert(phantom_node.reverse_segment_id.id,
+                        phantom_node.GetReverseWeightPlusOffset(),
+                        phantom_node.reverse_segment_id.id);
+        }
     }
 }
 
+template <typename Heap>
+void insertNodesInHeaps(Heap &forward_heap, Heap &reverse_heap, const PhantomNodes &nodes)
+{
+    insertNodesInHeap<FORWARD_DIRECTION>(forward_heap, nodes.source_phantom);
+    insertNodesInHeap<REVERSE_DIRECTION>(reverse_heap, nodes.target_phantom);
+}
+
 template <typename ManyToManyQueryHeap>
 void insertSourceInHeap(ManyToManyQueryHeap &heap, const PhantomNode &phantom_node)
 {
@@ -374,6 +374,17 @@ double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
                           const PhantomNode &target_phantom,
                           int duration_upper_bound = INVALID_EDGE_WEIGHT);
 
+// Network distances from one source to many targets. The forward search space of the source
+// is settled once up to the bound and every target only runs its reverse search against it.
+// Unreachable targets and targets not within the bound get std::numeric_limits<double>::max().
+std::vector<double> getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                        const DataFacade<ch::Algorithm> &facade,
+                                        SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                        SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                        const PhantomNode &source_phantom,
+                                        const std::vector<PhantomNode> &target_phantoms,
+                                        int duration_upper_bound = INVALID_EDGE_WEIGHT);
+
 } // namespace ch
 
 namespace corech
@@ -409,6 +420,15 @@ double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
                           const PhantomNode &target_phantom,
                           int duration_upper_bound = INVALID_EDGE_WEIGHT);
 
+// Network distances from one source to many targets, one search per target
+std::vector<double> getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                        const DataFacade<corech::Algorithm> &facade,
+                                        SearchEngineData<ch::Algorithm>::QueryHeap &forward_heap,
+                                        SearchEngineData<ch::Algorithm>::QueryHeap &reverse_heap,
+                                        const PhantomNode &source_phantom,
+                                        const std::vector<PhantomNode> &target_phantoms,
+                                        int duration_upper_bound = INVALID_EDGE_WEIGHT);
+
 template <typename RandomIter, typename FacadeT>
 void unpackPath(const FacadeT &facade,
                 RandomIter packed_path_begin,
@@ -6,6 +6,8 @@
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 
+#include "util/integer_range.hpp"
+#include "util/min_plus.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -65,6 +67,38 @@ inline bool checkParentCellRestriction(CellID cell, LevelID, CellID parent)
 {
     return cell == parent;
 }
+
+// One-to-many search (Args is const OneToManyPhantomNodes &):
+//   * use the lowest query level of the source and all targets
+//   * allow to traverse all cells
+struct OneToManyPhantomNodes
+{
+    const PhantomNode &source_phantom;
+    const std::vector<PhantomNode> &target_phantoms;
+};
+
+template <typename MultiLevelPartition>
+inline LevelID getNodeQueryLevel(const MultiLevelPartition &partition,
+                                 NodeID node,
+                                 const OneToManyPhantomNodes &phantom_nodes)
+{
+    auto level = [&partition, node](const SegmentID &segment) {
+        if (segment.enabled)
+            return partition.GetHighestDifferentLevel(segment.id, node);
+        return INVALID_LEVEL_ID;
+    };
+    auto query_level = std::min(level(phantom_nodes.source_phantom.forward_segment_id),
+                                level(phantom_nodes.source_phantom.reverse_segment_id));
+    for (const auto &target_phantom : phantom_nodes.target_phantoms)
+    {
+        query_level = std::min({query_level,
+                                level(target_phantom.forward_segment_id),
+                                level(target_phantom.reverse_segment_id)});
+    }
+    return query_level;
+}
+
+inline bool checkParentCellRestriction(CellID, const OneToManyPhantomNodes &) { return true; }
 }
 
 // Heaps only record for each node its predecessor ("parent") on the shortest path.
@@ -178,15 +212,17 @@ void routingStep(const DataFacade<Algorithm> &facade,
         {
             // Shortcuts in forward direction
             const auto &cell = cells.GetCell(metric, level, partition.GetCell(level, node));
-            auto destination = cell.GetDestinationNodes().begin();
-            for (auto shortcut_weight : cell.GetOutWeight(node))
-            {
-                BOOST_ASSERT(destination != cell.GetDestinationNodes().end());
-                const NodeID to = *destination;
+            const auto destinations = cell.GetDestinationNodes().begin();
+            const auto shortcut_weights = cell.GetOutWeight(node);
+            util::forEachValidWeight(
+                shortcut_weights.begin(), shortcut_weights.size(), [&](const std::size_t index) {
+                    const NodeID to = destinations[index];
+                    if (node == to)
+                    {
+                        return;
+                    }
 
-                if (shortcut_weight != INVALID_EDGE_WEIGHT && node != to)
-                {
-                    const EdgeWeight to_weight = weight + shortcut_weight;
+                    const EdgeWeight to_weight = weight + shortcut_weights[index];
                     BOOST_ASSERT(to_weight >= weight);
                     if (!forward_heap.WasInserted(to))
                     {
@@ -197,13 +233,11 @@ void routingStep(const DataFacade<Algorithm> &facade,
                         forward_heap.GetData(to) = {node, true};
                         forward_heap.DecreaseKey(to, to_weight);
                     }
-                }
-                ++destination;
-            }
+                });
         }
         else
         {
-            // Shortcuts in backward direction
+            // Shortcuts in backward direction, the columns are strided and read one by one
             const auto &cell = cells.GetCell(metric, level, partition.GetCell(level, node));
             auto source = cell.GetSourceNodes().begin();
             for (auto shortcut_weight : cell.GetInWeight(node))
@@ -489,6 +523,198 @@ double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
     return getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
 }
 
+// Network distances from one source to many targets. A single forward search runs on the
+// lowest query level of all targets and reads off the target weights when it settles the
+// target nodes, so it stops as soon as all targets are settled or the bound is reached.
+// Unreachable targets and targets not within the bound get std::numeric_limits<double>::max().
+template <typename Algorithm>
+std::vector<double>
+getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                    const DataFacade<Algorithm> &facade,
+                    typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                    typename SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                    const PhantomNode &source_phantom,
+                    const std::vector<PhantomNode> &target_phantoms,
+                    EdgeWeight weight_upper_bound = INVALID_EDGE_WEIGHT)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto number_of_targets = target_phantoms.size();
+
+    std::vector<double> distances(number_of_targets, std::numeric_limits<double>::max());
+    std::vector<EdgeWeight> weights(number_of_targets, weight_upper_bound);
+    std::vector<NodeID> middle_nodes(number_of_targets, SPECIAL_NODEID);
+
+    // A target behind the source on the same segment can only be reached with a loop
+    // through the source node, which is handled by the bidirectional search.
+    std::vector<bool> needs_loop(number_of_targets);
+    for (const auto index : util::irange<std::size_t>(0UL, number_of_targets))
+    {
+        needs_loop[index] = needsLoopForward(source_phantom, target_phantoms[index]) ||
+                            needsLoopBackwards(source_phantom, target_phantoms[index]);
+    }
+
+    // Target nodes as {node, target index, weight offset}
+    std::vector<std::tuple<NodeID, std::size_t, EdgeWeight>> target_nodes;
+    for (const auto index : util::irange<std::size_t>(0UL, number_of_targets))
+    {
+        const auto &target_phantom = target_phantoms[index];
+        if (needs_loop[index])
+            continue;
+        if (target_phantom.IsValidForwardTarget())
+            target_nodes.emplace_back(target_phantom.forward_segment_id.id,
+                                      index,
+                                      target_phantom.GetForwardWeightPlusOffset());
+        if (target_phantom.IsValidReverseTarget())
+            target_nodes.emplace_back(target_phantom.reverse_segment_id.id,
+                                      index,
+                                      target_phantom.GetReverseWeightPlusOffset());
+    }
+
+    // The search can stop once no unsettled target can get a smaller weight
+    const auto search_upper_bound = [&] {
+        auto bound = std::numeric_limits<EdgeWeight>::min();
+        for (const auto &target_node : target_nodes)
+            bound = std::max(bound, weights[std::get<1>(target_node)]);
+        return bound;
+    };
+
+    forward_heap.Clear();
+    reverse_heap.Clear();
+    insertNodesInHeap<FORWARD_DIRECTION>(forward_heap, source_phantom);
+
+    const OneToManyPhantomNodes phantom_nodes{source_phantom, target_phantoms};
+    NodeID middle = SPECIAL_NODEID;
+    EdgeWeight weight = weight_upper_bound;
+    auto upper_bound = search_upper_bound();
+    while (!forward_heap.Empty() && forward_heap.MinKey() < upper_bound)
+    {
+        const auto node = forward_heap.Min();
+        const auto node_weight = forward_heap.MinKey();
+
+        // The reverse heap stays empty, so this only settles and relaxes the node
+        routingStep<FORWARD_DIRECTION>(facade,
+                                       forward_heap,
+                                       reverse_heap,
+                                       middle,
+                                       weight,
+                                       DO_NOT_FORCE_LOOPS,
+                                       DO_NOT_FORCE_LOOPS,
+                                       phantom_nodes);
+
+        bool found_target = false;
+        for (const auto &target_node : target_nodes)
+        {
+            const auto index = std::get<1>(target_node);
+            const auto path_weight = node_weight + std::get<2>(target_node);
+            if (std::get<0>(target_node) == node && path_weight >= 0 &&
+                path_weight < weights[index])
+            {
+                weights[index] = path_weight;
+                middle_nodes[index] = node;
+                found_target = true;
+            }
+        }
+        if (found_target)
+        {
+            upper_bound = search_upper_bound();
+        }
+    }
+
+    // The paths are retrieved before unpacking, which reuses the heaps
+    std::vector<PackedPath> packed_paths(number_of_targets);
+    for (const auto index : util::irange<std::size_t>(0UL, number_of_targets))
+    {
+        if (middle_nodes[index] != SPECIAL_NODEID)
+        {
+            auto &packed_path = packed_paths[index];
+            packed_path = retrievePackedPathFromSingleHeap<FORWARD_DIRECTION>(
+                forward_heap, middle_nodes[index]);
+            std::reverse(packed_path.begin(), packed_path.end());
+        }
+    }
+
+    std::vector<PathData> unpacked_path;
+    for (const auto index : util::irange<std::size_t>(0UL, number_of_targets))
+    {
+        const auto &target_phantom = target_phantoms[index];
+        if (needs_loop[index])
+        {
+            distances[index] = getNetworkDistance(engine_working_data,
+                                                  facade,
+                                                  forward_heap,
+                                                  reverse_heap,
+                                                  source_phantom,
+                                                  target_phantom,
+                                                  weight_upper_bound);
+            continue;
+        }
+
+        if (middle_nodes[index] == SPECIAL_NODEID)
+            continue;
+
+        const auto &packed_path = packed_paths[index];
+        std::vector<NodeID> unpacked_nodes;
+        std::vector<EdgeID> unpacked_edges;
+        unpacked_nodes.reserve(packed_path.size() + 1);
+        unpacked_edges.reserve(packed_path.size());
+        unpacked_nodes.push_back(packed_path.empty() ? middle_nodes[index]
+                                                     : std::get<0>(packed_path.front()));
+
+        for (auto const &packed_edge : packed_path)
+        {
+            NodeID source, target;
+            bool overlay_edge;
+            std::tie(source, target, overlay_edge) = packed_edge;
+            if (!overlay_edge)
+            { // a base graph edge
+                unpacked_nodes.push_back(target);
+                unpacked_edges.push_back(facade.FindEdge(source, target));
+                continue;
+            }
+
+            // an overlay graph edge, unpacked on the level it was added on
+            const auto level = getNodeQueryLevel(partition, source, phantom_nodes);
+            const auto parent_cell_id = partition.GetCell(level, source);
+            BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
+
+            forward_heap.Clear();
+            reverse_heap.Clear();
+            forward_heap.Insert(source, 0, {source});
+            reverse_heap.Insert(target, 0, {target});
+
+            std::vector<NodeID> subpath_nodes;
+            std::vector<EdgeID> subpath_edges;
+            std::tie(std::ignore, subpath_nodes, subpath_edges) =
+                search(engine_working_data,
+                       facade,
+                       forward_heap,
+                       reverse_heap,
+                       DO_NOT_FORCE_LOOPS,
+                       DO_NOT_FORCE_LOOPS,
+                       INVALID_EDGE_WEIGHT,
+                       static_cast<LevelID>(level - 1),
+                       parent_cell_id);
+            BOOST_ASSERT(subpath_nodes.size() > 1);
+            BOOST_ASSERT(subpath_nodes.front() == source);
+            BOOST_ASSERT(subpath_nodes.back() == target);
+            unpacked_nodes.insert(
+                unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
+            unpacked_edges.insert(unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
+        }
+
+        unpacked_path.clear();
+        annotatePath(facade,
+                     {source_phantom, target_phantom},
+                     unpacked_nodes,
+                     unpacked_edges,
+                     unpacked_path);
+
+        distances[index] = getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
+    }
+
+    return distances;
+}
+
 } // namespace mld
 } // namespace routing_algorithms
 } // namespace engine
@@ -16,6 +16,9 @@ namespace engine
 // - CH algorithms use CH heaps
 // - CoreCH algorithms use CH
 // - MLD algorithms use MLD heaps
+//
+// The heaps are thread-local and shared by all instances, the node index of a heap is
+// selected by max_heap_index_memory when the heap is first created on a thread.
 
 template <typename Algorithm> struct SearchEngineData
 {
@@ -35,14 +38,14 @@ struct ManyToManyHeapData : HeapData
 
 template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
 {
-    using QueryHeap = util::
-        QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+    using QueryHeap =
+        util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::AdaptiveStorage<NodeID, int>>;
 
     using ManyToManyQueryHeap = util::QueryHeap<NodeID,
                                                 NodeID,
                                                 EdgeWeight,
                                                 ManyToManyHeapData,
-                                                util::UnorderedMapStorage<NodeID, int>>;
+                                                util::AdaptiveStorage<NodeID, int>>;
 
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
@@ -55,6 +58,9 @@ template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
     static SearchEngineHeapPtr reverse_heap_3;
     static ManyToManyHeapPtr many_to_many_heap;
 
+    // Heaps of graphs whose array node index needs at most this many bytes use arrays
+    std::size_t max_heap_index_memory = 0;
+
     void InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes);
 
     void InitializeOrClearSecondThreadLocalStorage(unsigned number_of_nodes);
@@ -97,13 +103,13 @@ template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
                                       NodeID,
                                       EdgeWeight,
                                       MultiLayerDijkstraHeapData,
-                                      util::UnorderedMapStorage<NodeID, int>>;
+                                      util::AdaptiveStorage<NodeID, int>>;
 
     using ManyToManyQueryHeap = util::QueryHeap<NodeID,
                                                 NodeID,
                                                 EdgeWeight,
                                                 ManyToManyMultiLayerDijkstraHeapData,
-                                                util::UnorderedMapStorage<NodeID, int>>;
+                                                util::AdaptiveStorage<NodeID, int>>;
 
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
@@ -112,6 +118,9 @@ template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
     static SearchEngineHeapPtr reverse_heap_1;
     static ManyToManyHeapPtr many_to_many_heap;
 
+    // Heaps of graphs whose array node index needs at most this many bytes use arrays
+    std::size_t max_heap_index_memory = 0;
+
     void InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes);
 
     void InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes);
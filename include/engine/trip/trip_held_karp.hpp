@@ -0,0 +1,131 @@
+#ifndef TRIP_HELD_KARP_HPP
+#define TRIP_HELD_KARP_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+// The tables of the dynamic program hold 2^(n-1) * (n-1) entries, about 11 MB for 18 locations
+const constexpr std::size_t HELD_KARP_MAX_LOCATIONS = 18;
+
+// Computes the shortest round trip with the Held-Karp dynamic program over subsets of locations
+// in O(2^n * n^2) instead of trying all n! orders. Returns an empty trip if every round trip
+// uses an INVALID_EDGE_WEIGHT entry of the table.
+inline std::vector<NodeID> HeldKarpTrip(const std::size_t number_of_locations,
+                                        const util::DistTableWrapper<EdgeWeight> &dist_table)
+{
+    BOOST_ASSERT(number_of_locations > 0);
+    BOOST_ASSERT(number_of_locations <= HELD_KARP_MAX_LOCATIONS);
+    BOOST_ASSERT_MSG(number_of_locations * number_of_locations == dist_table.size(),
+                     "number_of_locations and dist_table size do not match");
+
+    if (number_of_locations == 1)
+    {
+        return {0};
+    }
+
+    // All paths start at location 0. Bit i of a subset stands for location i + 1, the entry
+    // [subset * others + last] is the shortest path from 0 that visits exactly the subset and
+    // ends at location last + 1.
+    const std::size_t others = number_of_locations - 1;
+    const std::size_t number_of_subsets = std::size_t{1} << others;
+    std::vector<EdgeWeight> weights(number_of_subsets * others, INVALID_EDGE_WEIGHT);
+    std::vector<std::uint8_t> predecessors(number_of_subsets * others);
+
+    for (std::size_t last = 0; last < others; ++last)
+    {
+        weights[(std::size_t{1} << last) * others + last] = dist_table(0, last + 1);
+    }
+
+    // subsets only grow, every subset is final before it is extended
+    for (std::size_t subset = 1; subset < number_of_subsets; ++subset)
+    {
+        for (std::size_t last = 0; last < others; ++last)
+        {
+            const auto weight = weights[subset * others + last];
+            if ((subset & (std::size_t{1} << last)) == 0 || weight == INVALID_EDGE_WEIGHT)
+            {
+                continue;
+            }
+
+            for (std::size_t next = 0; next < others; ++next)
+            {
+                const auto next_bit = std::size_t{1} << next;
+                const auto edge_weight = dist_table(last + 1, next + 1);
+                if ((subset & next_bit) != 0 || edge_weight == INVALID_EDGE_WEIGHT)
+                {
+                    continue;
+                }
+
+                // sums beyond the range of EdgeWeight are treated as invalid
+                const auto candidate = std::int64_t{weight} + edge_weight;
+                const auto index = (subset | next_bit) * others + next;
+                if (candidate < weights[index])
+                {
+                    weights[index] = static_cast<EdgeWeight>(candidate);
+                    predecessors[index] = static_cast<std::uint8_t>(last);
+                }
+            }
+        }
+    }
+
+    // close the round trip back to location 0
+    const auto all_locations = number_of_subsets - 1;
+    auto min_trip_weight = std::int64_t{INVALID_EDGE_WEIGHT};
+    std::size_t min_last = others;
+    for (std::size_t last = 0; last < others; ++last)
+    {
+        const auto weight = weights[all_locations * others + last];
+        const auto edge_weight = dist_table(last + 1, 0);
+        if (weight == INVALID_EDGE_WEIGHT || edge_weight == INVALID_EDGE_WEIGHT)
+        {
+            continue;
+        }
+
+        const auto trip_weight = std::int64_t{weight} + edge_weight;
+        if (trip_weight < min_trip_weight)
+        {
+            min_trip_weight = trip_weight;
+            min_last = last;
+        }
+    }
+
+    if (min_last == others)
+    {
+        return {};
+    }
+
+    // follow the predecessors back to location 0
+    std::vector<NodeID> trip(number_of_locations);
+    auto subset = all_locations;
+    auto last = min_last;
+    for (auto position = number_of_locations - 1; position > 0; --position)
+    {
+        trip[position] = static_cast<NodeID>(last + 1);
+        const auto previous = predecessors[subset * others + last];
+        subset &= ~(std::size_t{1} << last);
+        last = previous;
+    }
+    trip[0] = 0;
+
+    return trip;
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_HELD_KARP_HPP
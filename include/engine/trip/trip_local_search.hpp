@@ -0,0 +1,320 @@
+#ifndef TRIP_LOCAL_SEARCH_HPP
+#define TRIP_LOCAL_SEARCH_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+namespace detail
+{
+using Clock = std::chrono::steady_clock;
+// Weights of whole trips. INVALID_EDGE_WEIGHT entries stay far larger than any valid trip, so
+// the search never trades a valid leg for an invalid one.
+using TripWeight = std::int64_t;
+
+inline TripWeight GetTripWeight(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                const std::vector<NodeID> &trip)
+{
+    TripWeight weight = 0;
+    for (std::size_t index = 0; index < trip.size(); ++index)
+    {
+        weight += dist_table(trip[index], trip[(index + 1) % trip.size()]);
+    }
+    return weight;
+}
+
+// Asymmetric 2-opt: reverses trip[first + 1 .. last] if that makes the trip shorter. The legs
+// inside the reversed part change direction, their weights are kept as prefix sums in both
+// directions so every move is evaluated in constant time.
+class TwoOpt
+{
+  public:
+    TwoOpt(const util::DistTableWrapper<EdgeWeight> &dist_table) : dist_table(dist_table) {}
+
+    bool Improve(std::vector<NodeID> &trip, const Clock::time_point deadline)
+    {
+        const auto size = trip.size();
+        if (size < 4)
+        {
+            return false;
+        }
+
+        UpdatePrefixSums(trip);
+        bool improved = false;
+        for (std::size_t first = 0; first + 2 < size; ++first)
+        {
+            if (Clock::now() > deadline)
+            {
+                break;
+            }
+
+            for (std::size_t last = first + 2; last < size; ++last)
+            {
+                const auto before = trip[first];
+                const auto begin = trip[first + 1];
+                const auto end = trip[last];
+                const auto after = trip[(last + 1) % size];
+                if (after == before)
+                {
+                    continue;
+                }
+
+                const auto forward = forward_weights[last] - forward_weights[first + 1];
+                const auto backward = backward_weights[last] - backward_weights[first + 1];
+                const auto delta = TripWeight{dist_table(before, end)} + dist_table(begin, after) +
+                                   backward - dist_table(before, begin) - dist_table(end, after) -
+                                   forward;
+                if (delta < 0)
+                {
+                    std::reverse(trip.begin() + first + 1, trip.begin() + last + 1);
+                    UpdatePrefixSums(trip);
+                    improved = true;
+                }
+            }
+        }
+        return improved;
+    }
+
+  private:
+    void UpdatePrefixSums(const std::vector<NodeID> &trip)
+    {
+        forward_weights.resize(trip.size());
+        backward_weights.resize(trip.size());
+        forward_weights[0] = 0;
+        backward_weights[0] = 0;
+        for (std::size_t index = 1; index < trip.size(); ++index)
+        {
+            forward_weights[index] =
+                forward_weights[index - 1] + dist_table(trip[index - 1], trip[index]);
+            backward_weights[index] =
+                backward_weights[index - 1] + dist_table(trip[index], trip[index - 1]);
+        }
+    }
+
+    const util::DistTableWrapper<EdgeWeight> &dist_table;
+    std::vector<TripWeight> forward_weights;
+    std::vector<TripWeight> backward_weights;
+};
+
+// Or-opt: moves a run of up to three consecutive locations, in either direction, between two
+// other neighbouring locations if that makes the trip shorter
+class OrOpt
+{
+  public:
+    static const constexpr std::size_t MAX_SEGMENT_LENGTH = 3;
+
+    OrOpt(const util::DistTableWrapper<EdgeWeight> &dist_table) : dist_table(dist_table) {}
+
+    bool Improve(std::vector<NodeID> &trip, const Clock::time_point deadline)
+    {
+        const auto size = trip.size();
+        bool improved = false;
+        for (std::size_t length = 1; length <= MAX_SEGMENT_LENGTH && length + 3 <= size; ++length)
+        {
+            for (std::size_t first = 0; first + length <= size; ++first)
+            {
+                if (Clock::now() > deadline)
+                {
+                    return improved;
+                }
+
+                improved |= MoveSegment(trip, first, length);
+            }
+        }
+        return improved;
+    }
+
+  private:
+    bool MoveSegment(std::vector<NodeID> &trip, const std::size_t first, const std::size_t length)
+    {
+        const auto size = trip.size();
+        const auto last = first + length - 1;
+        const auto before = trip[(first + size - 1) % size];
+        const auto after = trip[(last + 1) % size];
+        const auto segment_begin = trip[first];
+        const auto segment_end = trip[last];
+
+        TripWeight forward = 0;
+        TripWeight backward = 0;
+        for (auto index = first; index < last; ++index)
+        {
+            forward += dist_table(trip[index], trip[index + 1]);
+            backward += dist_table(trip[index + 1], trip[index]);
+        }
+
+        const auto removal_gain = TripWeight{dist_table(before, segment_begin)} +
+                                  dist_table(segment_end, after) - dist_table(before, after);
+
+        // insert between trip[position] and its successor, both outside the segment
+        TripWeight best_delta = 0;
+        std::size_t best_position = size;
+        bool best_reversed = false;
+        for (std::size_t offset = 1; offset + length < size; ++offset)
+        {
+            const auto position = (last + offset) % size;
+            const auto from = trip[position];
+            const auto to = trip[(position + 1) % size];
+
+            const auto removed = TripWeight{dist_table(from, to)} + removal_gain + forward;
+            const auto inserted = TripWeight{dist_table(from, segment_begin)} +
+                                  dist_table(segment_end, to) + forward;
+            const auto inserted_reversed = TripWeight{dist_table(from, segment_end)} +
+                                           dist_table(segment_begin, to) + backward;
+
+            if (inserted - removed < best_delta)
+            {
+                best_delta = inserted - removed;
+                best_position = position;
+                best_reversed = false;
+            }
+            if (inserted_reversed - removed < best_delta)
+            {
+                best_delta = inserted_reversed - removed;
+                best_position = position;
+                best_reversed = true;
+            }
+        }
+
+        if (best_position == size)
+        {
+            return false;
+        }
+
+        std::vector<NodeID> segment(trip.begin() + first, trip.begin() + last + 1);
+        if (best_reversed)
+        {
+            std::reverse(segment.begin(), segment.end());
+        }
+        const auto insert_after = trip[best_position];
+        trip.erase(trip.begin() + first, trip.begin() + last + 1);
+        const auto position = std::find(trip.begin(), trip.end(), insert_after);
+        trip.insert(std::next(position), segment.begin(), segment.end());
+        return true;
+    }
+
+    const util::DistTableWrapper<EdgeWeight> &dist_table;
+};
+
+// Applies 2-opt and Or-opt moves until neither improves the trip or the time is up
+inline void ImproveTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                        std::vector<NodeID> &trip,
+                        const Clock::time_point deadline)
+{
+    TwoOpt two_opt(dist_table);
+    OrOpt or_opt(dist_table);
+    bool improved = true;
+    while (improved && Clock::now() <= deadline)
+    {
+        improved = two_opt.Improve(trip, deadline);
+        improved = or_opt.Improve(trip, deadline) || improved;
+    }
+}
+
+// Double bridge kick: reconnects three random cuts of the trip in a different order, a change
+// 2-opt and Or-opt can not undo in a single move
+inline void PerturbTrip(std::vector<NodeID> &trip, std::mt19937 &generator)
+{
+    if (trip.size() < 8)
+    {
+        std::shuffle(trip.begin() + 1, trip.end(), generator);
+        return;
+    }
+
+    std::uniform_int_distribution<std::size_t> cut_distribution(1, trip.size() - 1);
+    std::vector<std::size_t> cuts;
+    while (cuts.size() < 3)
+    {
+        const auto cut = cut_distribution(generator);
+        if (std::find(cuts.begin(), cuts.end(), cut) == cuts.end())
+        {
+            cuts.push_back(cut);
+        }
+    }
+    std::sort(cuts.begin(), cuts.end());
+
+    std::vector<NodeID> perturbed(trip.begin(), trip.begin() + cuts[0]);
+    perturbed.insert(perturbed.end(), trip.begin() + cuts[2], trip.end());
+    perturbed.insert(perturbed.end(), trip.begin() + cuts[1], trip.begin() + cuts[2]);
+    perturbed.insert(perturbed.end(), trip.begin() + cuts[0], trip.begin() + cuts[1]);
+    trip = std::move(perturbed);
+}
+}
+
+// Improves a trip with 2-opt and Or-opt moves. The first restart improves initial_trip, every
+// other restart a double bridge perturbation of it with its own fixed seed, and the shortest
+// result is returned. Restarts run on up to max_threads threads and all stop at the time budget.
+// Results only depend on the time budget if it runs out.
+inline std::vector<NodeID> LocalSearchTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                           const std::vector<NodeID> &initial_trip,
+                                           const std::chrono::milliseconds time_budget,
+                                           const std::size_t number_of_restarts,
+                                           const std::size_t max_threads)
+{
+    BOOST_ASSERT(number_of_restarts > 0);
+    const auto deadline = detail::Clock::now() + time_budget;
+
+    std::vector<std::vector<NodeID>> trips(number_of_restarts, initial_trip);
+    std::vector<detail::TripWeight> trip_weights(number_of_restarts);
+    const auto run_restart = [&](const std::size_t restart) {
+        if (restart > 0)
+        {
+            std::mt19937 generator(restart);
+            detail::PerturbTrip(trips[restart], generator);
+        }
+        detail::ImproveTrip(dist_table, trips[restart], deadline);
+        trip_weights[restart] = detail::GetTripWeight(dist_table, trips[restart]);
+    };
+
+    const auto number_of_threads = std::min(max_threads, number_of_restarts);
+    if (number_of_threads <= 1)
+    {
+        for (std::size_t restart = 0; restart < number_of_restarts; ++restart)
+        {
+            run_restart(restart);
+        }
+    }
+    else
+    {
+        tbb::task_arena arena(static_cast<int>(number_of_threads));
+        arena.execute([&] {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, number_of_restarts, 1),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto restart = range.begin(), end = range.end();
+                                       restart != end;
+                                       ++restart)
+                                  {
+                                      run_restart(restart);
+                                  }
+                              });
+        });
+    }
+
+    // ties go to the lowest restart, the unperturbed one first
+    const auto best = std::min_element(trip_weights.begin(), trip_weights.end());
+    return trips[std::distance(trip_weights.begin(), best)];
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_LOCAL_SEARCH_HPP
@@ -119,6 +119,10 @@ inline engine_config_ptr argumentsToEngineConfig(const Nan::FunctionCallbackInfo
     if (shared_memory.IsEmpty())
         return engine_config_ptr();
 
+    auto mmap = params->Get(Nan::New("mmap").ToLocalChecked());
+    if (mmap.IsEmpty())
+        return engine_config_ptr();
+
     if (!path->IsUndefined())
     {
         engine_config->storage_config =
@@ -145,6 +149,57 @@ inline engine_config_ptr argumentsToEngineConfig(const Nan::FunctionCallbackInfo
         return engine_config_ptr();
     }
 
+    if (!mmap->IsUndefined())
+    {
+        if (!mmap->IsBoolean())
+        {
+            Nan::ThrowError("mmap option must be a boolean");
+            return engine_config_ptr();
+        }
+        engine_config->use_mmap = Nan::To<bool>(mmap).FromJust();
+        if (engine_config->use_mmap && engine_config->use_shared_memory)
+        {
+            Nan::ThrowError("mmap can not be used with shared_memory");
+            return engine_config_ptr();
+        }
+    }
+
+    auto metrics = params->Get(Nan::New("metrics").ToLocalChecked());
+    if (metrics.IsEmpty())
+        return engine_config_ptr();
+
+    if (!metrics->IsUndefined())
+    {
+        if (!metrics->IsObject() || metrics->IsArray())
+        {
+            Nan::ThrowError("metrics must be an object of metric names to paths");
+            return engine_config_ptr();
+        }
+        if (engine_config->use_shared_memory)
+        {
+            Nan::ThrowError("metrics can not be used with shared_memory");
+            return engine_config_ptr();
+        }
+
+        auto metrics_object = Nan::To<v8::Object>(metrics).ToLocalChecked();
+        auto names = Nan::GetOwnPropertyNames(metrics_object).ToLocalChecked();
+        for (uint32_t i = 0; i < names->Length(); ++i)
+        {
+            auto name = names->Get(i);
+            auto metric_path = metrics_object->Get(name);
+            if (metric_path.IsEmpty())
+                return engine_config_ptr();
+
+            if (!metric_path->IsString())
+            {
+                Nan::ThrowError("metrics must be an object of metric names to paths");
+                return engine_config_ptr();
+            }
+            engine_config->metrics[*v8::String::Utf8Value(name)] =
+                osrm::StorageConfig(*v8::String::Utf8Value(metric_path));
+        }
+    }
+
     auto algorithm = params->Get(Nan::New("algorithm").ToLocalChecked());
     if (algorithm.IsEmpty())
         return engine_config_ptr();
@@ -618,6 +673,20 @@ inline bool argumentsToParameter(const Nan::FunctionCallbackInfo<v8::Value> &arg
         }
     }
 
+    if (obj->Has(Nan::New("metric").ToLocalChecked()))
+    {
+        v8::Local<v8::Value> metric = obj->Get(Nan::New("metric").ToLocalChecked());
+        if (metric.IsEmpty())
+            return false;
+
+        if (!metric->IsString())
+        {
+            Nan::ThrowError("Metric must be a string");
+            return false;
+        }
+        params->metric = *v8::String::Utf8Value(metric);
+    }
+
     return true;
 }
 
@@ -1025,6 +1094,46 @@ argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
         }
     }
 
+    if (obj->Has(Nan::New("annotations").ToLocalChecked()))
+    {
+        v8::Local<v8::Value> annotations = obj->Get(Nan::New("annotations").ToLocalChecked());
+        if (annotations.IsEmpty())
+            return table_parameters_ptr();
+
+        if (!annotations->IsArray())
+        {
+            Nan::ThrowError("Annotations must an array containing 'duration' or 'distance', or "
+                            "both");
+            return table_parameters_ptr();
+        }
+
+        params->annotations = osrm::TableParameters::AnnotationsType::None;
+
+        v8::Local<v8::Array> annotations_array = v8::Local<v8::Array>::Cast(annotations);
+        for (std::size_t i = 0; i < annotations_array->Length(); ++i)
+        {
+            const Nan::Utf8String annotations_utf8str(annotations_array->Get(i));
+            std::string annotations_str{*annotations_utf8str,
+                                        *annotations_utf8str + annotations_utf8str.length()};
+
+            if (annotations_str == "duration")
+            {
+                params->annotations =
+                    params->annotations | osrm::TableParameters::AnnotationsType::Duration;
+            }
+            else if (annotations_str == "distance")
+            {
+                params->annotations =
+                    params->annotations | osrm::TableParameters::AnnotationsType::Distance;
+            }
+            else
+            {
+                Nan::ThrowError("this 'annotations' param is not supported");
+                return table_parameters_ptr();
+            }
+        }
+    }
+
     return params;
 }
 
@@ -31,8 +31,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "osrm/osrm_fwd.hpp"
 #include "osrm/status.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -44,6 +47,10 @@ using engine::api::NearestParameters;
 using engine::api::TripParameters;
 using engine::api::MatchParameters;
 using engine::api::TileParameters;
+using engine::api::BinaryWriter;
+using util::CacheStatistics;
+// Receives the index of a trace of a batch match query, its status and its response
+using MatchCallback = std::function<void(const std::size_t, const Status, json::Object &)>;
 
 /**
  * Represents a Open Source Routing Machine with access to its services.
@@ -85,6 +92,26 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * Shortest path queries for coordinates, rendered straight into a JSON writer.
+     *
+     * The output is identical to rendering the json::Object of the overload above.
+     *
+     * \param parameters route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, RouteParameters and json::Writer
+     */
+    Status Route(const RouteParameters &parameters, json::Writer &result) const;
+
+    /**
+     * Shortest path queries for coordinates, in the aligned binary format.
+     *
+     * \param parameters route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, RouteParameters and BinaryWriter
+     */
+    Status Route(const RouteParameters &parameters, BinaryWriter &result) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +121,26 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * Distance tables for coordinates, rendered straight into a JSON writer.
+     *
+     * The matrices are written without building a json::Array per row and entry.
+     *
+     * \param parameters table query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and json::Writer
+     */
+    Status Table(const TableParameters &parameters, json::Writer &result) const;
+
+    /**
+     * Distance tables for coordinates, in the aligned binary format.
+     *
+     * \param parameters table query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and BinaryWriter
+     */
+    Status Table(const TableParameters &parameters, BinaryWriter &result) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -103,6 +150,15 @@ class OSRM final
      */
     Status Nearest(const NearestParameters &parameters, json::Object &result) const;
 
+    /**
+     * Nearest street segment for coordinate, in the aligned binary format.
+     *
+     * \param parameters nearest query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, NearestParameters and BinaryWriter
+     */
+    Status Nearest(const NearestParameters &parameters, BinaryWriter &result) const;
+
     /**
      * Trip: shortest round trip between coordinates.
      *
@@ -121,6 +177,40 @@ class OSRM final
      */
     Status Match(const MatchParameters &parameters, json::Object &result) const;
 
+    /**
+     * Match: snaps noisy coordinate traces to the road network, rendered straight into a JSON
+     * writer.
+     *
+     * \param parameters match query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, MatchParameters and json::Writer
+     */
+    Status Match(const MatchParameters &parameters, json::Writer &result) const;
+
+    /**
+     * Match: snaps noisy coordinate traces to the road network, in the aligned binary format.
+     *
+     * \param parameters match query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, MatchParameters and BinaryWriter
+     */
+    Status Match(const MatchParameters &parameters, BinaryWriter &result) const;
+
+    /**
+     * Match: snaps a batch of noisy coordinate traces to the road network. The traces are
+     * matched in parallel on up to EngineConfig::max_match_threads threads and the callback
+     * is called with the response of every trace as soon as it is matched. Calls of the
+     * callback are serialized but not ordered. All traces are matched with the metric and
+     * exclude classes of the first one, traces asking for others are rejected.
+     *
+     * \param parameters match query specific parameters of all traces
+     * \param callback called once for every trace
+     * \return Status indicating success for all traces or failure of at least one
+     * \see Status, MatchParameters and MatchCallback
+     */
+    Status Match(const std::vector<MatchParameters> &parameters,
+                 const MatchCallback &callback) const;
+
     /**
      * Tile: vector tiles with internal graph representation
      *
@@ -130,6 +220,23 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * Counters of the vector tile cache, see EngineConfig::max_tile_cache_memory
+     *
+     * \return hits, misses, evictions and the current size of the cache
+     * \see CacheStatistics
+     */
+    CacheStatistics TileCacheStatistics() const;
+
+    /**
+     * Counters of the route and table response cache, see
+     * EngineConfig::max_result_cache_memory
+     *
+     * \return hits, misses, evictions, invalidations and the current size of the cache
+     * \see CacheStatistics
+     */
+    CacheStatistics ResultCacheStatistics() const;
+
   private:
     std::unique_ptr<engine::EngineInterface> engine_;
 };
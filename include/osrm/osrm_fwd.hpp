@@ -29,16 +29,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OSRM_FWD_HPP
 
 // OSRM API forward declarations for usage in interfaces. Exposes forward declarations for:
-// osrm::util::json::Object, osrm::engine::api::XParameters
+// osrm::util::json::Object, osrm::util::json::Writer, osrm::engine::api::XParameters,
+// osrm::engine::api::BinaryWriter, osrm::util::CacheStatistics
 
 namespace osrm
 {
 
 namespace util
 {
+struct CacheStatistics;
+
 namespace json
 {
 struct Object;
+class Writer;
 } // ns json
 } // ns util
 
@@ -52,6 +56,7 @@ struct NearestParameters;
 struct TripParameters;
 struct MatchParameters;
 struct TileParameters;
+class BinaryWriter;
 } // ns api
 
 class EngineInterface;
@@ -27,17 +27,20 @@ namespace ph = boost::phoenix;
 namespace qi = boost::spirit::qi;
 }
 
-template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_policies<T>
+// Rejects the dot in front of an output format extension like "1.json", so "1" is the number
+template <typename T> struct no_trailing_dot_policy : qi::real_policies<T>
 {
     template <typename Iterator> static bool parse_dot(Iterator &first, Iterator const &last)
     {
         if (first == last || *first != '.')
             return false;
 
-        static const constexpr char fmt[sizeof...(Fmt)] = {Fmt...};
-
-        if (first + sizeof(fmt) < last && std::equal(fmt, fmt + sizeof(fmt), first + 1u))
-            return false;
+        for (const std::string extension : {"json", "bin"})
+        {
+            if (static_cast<std::size_t>(last - first) > extension.size() &&
+                std::equal(extension.begin(), extension.end(), first + 1u))
+                return false;
+        }
 
         ++first;
         return true;
@@ -70,7 +73,7 @@ template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_poli
 template <typename Iterator, typename Signature>
 struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
 {
-    using json_policy = no_trailing_dot_policy<double, 'j', 's', 'o', 'n'>;
+    using format_policy = no_trailing_dot_policy<double>;
 
     BaseParametersGrammar(qi::rule<Iterator, Signature> &root_rule)
         : BaseParametersGrammar::base_type(root_rule)
@@ -166,17 +169,28 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
                        (qi::as_string[+qi::char_("a-zA-Z0-9")] %
                         ',')[ph::bind(&engine::api::BaseParameters::exclude, qi::_r1) = qi::_1];
 
+        metric_rule = qi::lit("metric=") >
+                      qi::as_string[+qi::char_("a-zA-Z0-9_-")][ph::bind(
+                          &engine::api::BaseParameters::metric, qi::_r1) = qi::_1];
+
+        format_type.add("json", engine::api::BaseParameters::OutputFormatType::JSON)(
+            "bin", engine::api::BaseParameters::OutputFormatType::Binary);
+        format_rule = qi::lit('.') >
+                      format_type[ph::bind(&engine::api::BaseParameters::format, qi::_r1) = qi::_1];
+
         base_rule = radiuses_rule(qi::_r1)         //
                     | hints_rule(qi::_r1)          //
                     | bearings_rule(qi::_r1)       //
                     | generate_hints_rule(qi::_r1) //
                     | approach_rule(qi::_r1)       //
-                    | exclude_rule(qi::_r1);
+                    | exclude_rule(qi::_r1)        //
+                    | metric_rule(qi::_r1);
     }
 
   protected:
     qi::rule<Iterator, Signature> base_rule;
     qi::rule<Iterator, Signature> query_rule;
+    qi::rule<Iterator, Signature> format_rule;
 
   private:
     qi::rule<Iterator, Signature> bearings_rule;
@@ -186,6 +200,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, Signature> generate_hints_rule;
     qi::rule<Iterator, Signature> approach_rule;
     qi::rule<Iterator, Signature> exclude_rule;
+    qi::rule<Iterator, Signature> metric_rule;
 
     qi::rule<Iterator, osrm::engine::Bearing()> bearing_rule;
     qi::rule<Iterator, osrm::util::Coordinate()> location_rule;
@@ -195,9 +210,10 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, unsigned char()> base64_char;
     qi::rule<Iterator, std::string()> polyline_chars;
     qi::rule<Iterator, double()> unlimited_rule;
-    qi::real_parser<double, json_policy> double_;
+    qi::real_parser<double, format_policy> double_;
 
     qi::symbols<char, engine::Approach> approach_type;
+    qi::symbols<char, engine::api::BaseParameters::OutputFormatType> format_type;
 };
 }
 }
@@ -37,7 +37,7 @@ struct MatchParametersGrammar final : public RouteParametersGrammar<Iterator, Si
             "ignore", engine::api::MatchParameters::GapsType::Ignore);
 
         root_rule =
-            BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+            BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
             -('?' > (timestamps_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1) |
                      (qi::lit("gaps=") >
                       gaps_type[ph::bind(&engine::api::MatchParameters::gaps, qi::_r1) = qi::_1]) |
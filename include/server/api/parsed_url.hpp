@@ -1,6 +1,7 @@
 #ifndef SERVER_API_PARSED_URL_HPP
 #define SERVER_API_PARSED_URL_HPP
 
+#include "engine/api/base_parameters.hpp"
 #include "util/coordinate.hpp"
 
 #include <string>
@@ -20,6 +21,11 @@ struct ParsedURL final
     std::string profile;
     std::string query;
     std::size_t prefix_length;
+    // response format for queries without a format extension, taken from the Accept header
+    engine::api::BaseParameters::OutputFormatType default_format =
+        engine::api::BaseParameters::OutputFormatType::JSON;
+    // body of POST requests
+    std::string body;
 };
 
 } // api
@@ -48,9 +48,25 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
             (qi::lit("all") |
              (size_t_ % ';')[ph::bind(&engine::api::TableParameters::sources, qi::_r1) = qi::_1]);
 
-        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1);
+        using AnnotationsType = engine::api::TableParameters::AnnotationsType;
 
-        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+        const auto add_annotation = [](engine::api::TableParameters &table_parameters,
+                                       AnnotationsType table_param) {
+            table_parameters.annotations = table_parameters.annotations | table_param;
+        };
+
+        annotations_type.add("duration", AnnotationsType::Duration)("distance",
+                                                                    AnnotationsType::Distance);
+
+        // the listed annotations replace the default of returning only durations
+        annotations_rule =
+            qi::lit("annotations=")[ph::bind(&engine::api::TableParameters::annotations, qi::_r1) =
+                                        AnnotationsType::None] >
+            (annotations_type[ph::bind(add_annotation, qi::_r1, qi::_1)] % ',');
+
+        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1) | annotations_rule(qi::_r1);
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (table_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
     }
 
@@ -59,7 +75,9 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
     qi::rule<Iterator, Signature> table_rule;
     qi::rule<Iterator, Signature> sources_rule;
     qi::rule<Iterator, Signature> destinations_rule;
+    qi::rule<Iterator, Signature> annotations_rule;
     qi::rule<Iterator, std::size_t()> size_t_;
+    qi::symbols<char, engine::api::TableParameters::AnnotationsType> annotations_type;
 };
 }
 }
@@ -0,0 +1,57 @@
+#ifndef COMPRESSOR_HPP
+#define COMPRESSOR_HPP
+
+#include "server/http/compression_type.hpp"
+
+#include <zlib.h>
+
+#ifdef USE_ZSTD_LIBRARY
+#include <zstd.h>
+#endif
+
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+
+/// Compresses reply bodies.
+///
+/// Setting up a deflate stream allocates a few hundred kB of state. A compressor keeps the
+/// streams for gzip and deflate (and the zstd context) and only resets them between replies.
+/// Compressors are not thread-safe, use the one of the current thread returned by ThreadLocal.
+class Compressor
+{
+  public:
+    Compressor();
+    ~Compressor();
+    Compressor(const Compressor &) = delete;
+    Compressor &operator=(const Compressor &) = delete;
+
+    /// Replaces the content of output with the compressed input. The capacity of output is
+    /// kept, so reusing the same vector avoids reallocations for similar sized replies.
+    void compress(const std::vector<char> &input,
+                  const http::compression_type type,
+                  std::vector<char> &output);
+
+    /// Value of the Content-Encoding header
+    static const char *content_encoding(const http::compression_type type);
+
+    static Compressor &thread_local_instance();
+
+  private:
+    void deflate_buffer(z_stream &stream,
+                        const std::vector<char> &input,
+                        std::vector<char> &output);
+
+    z_stream gzip_stream;
+    z_stream deflate_stream;
+#ifdef USE_ZSTD_LIBRARY
+    ZSTD_CCtx *zstd_context;
+#endif
+};
+}
+}
+
+#endif // COMPRESSOR_HPP
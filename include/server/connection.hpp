@@ -34,10 +34,19 @@ namespace server
 class RequestHandler;
 
 /// Represents a single connection from a client.
+///
+/// Connections are kept alive for up to keepalive_max_requests requests if the client asks for
+/// it, idle connections are closed after keepalive_timeout seconds. Pipelined requests that are
+/// already in the read buffer are answered without reading from the socket again.
+/// Replies smaller than compression_min_size bytes are sent uncompressed.
 class Connection : public std::enable_shared_from_this<Connection>
 {
   public:
-    explicit Connection(boost::asio::io_service &io_service, RequestHandler &handler);
+    explicit Connection(boost::asio::io_service &io_service,
+                        RequestHandler &handler,
+                        const unsigned keepalive_timeout = 0,
+                        const unsigned keepalive_max_requests = 1,
+                        const std::size_t compression_min_size = 0);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
 
@@ -49,19 +58,37 @@ class Connection : public std::enable_shared_from_this<Connection>
   private:
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Parse buffered data and answer the request once it is complete.
+    void process_buffer(char *begin, char *end);
+
+    /// Wait for more data from the client, closes the connection when idle for too long.
+    void async_read();
+
+    void handle_timeout(const boost::system::error_code &e);
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
-    std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
-                                       const http::compression_type compression_type);
+    /// Initiate graceful connection closure.
+    void close();
 
     boost::asio::io_service::strand strand;
     boost::asio::ip::tcp::socket TCP_socket;
+    boost::asio::deadline_timer timer;
     RequestHandler &request_handler;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
+    // unparsed data of pipelined requests in incoming_data_buffer
+    char *pipelined_begin;
+    char *pipelined_end;
+    const unsigned keepalive_timeout;
+    const unsigned keepalive_max_requests;
+    const std::size_t compression_min_size;
+    unsigned processed_requests;
+    bool keep_alive;
     http::request current_request;
     http::reply current_reply;
+    // reused for all replies of the connection
     std::vector<char> compressed_output;
     // Header compression_header;
     std::vector<boost::asio::const_buffer> output_buffer;
@@ -12,7 +12,9 @@ enum compression_type
 {
     no_compression,
     gzip_rfc1952,
-    deflate_rfc1951
+    deflate_rfc1951,
+    // only negotiated if built with zstd support
+    zstd
 };
 }
 }
@@ -31,6 +31,10 @@ class reply
     static reply stock_reply(const status_type status);
     void set_size(const std::size_t size);
     void set_uncompressed_size();
+    // Sets the Connection header, persistent connections also announce their limits
+    void set_keep_alive(const bool keep_alive,
+                        const unsigned timeout,
+                        const unsigned remaining_requests);
 
     reply();
 
@@ -17,7 +17,12 @@ struct request
     std::string uri;
     std::string referrer;
     std::string agent;
+    std::string accept;
+    // sent with a Content-Length header, e.g. the traces of a batch match request
+    std::string body;
     boost::asio::ip::address endpoint;
+    // HTTP/1.1 by default, HTTP/1.0 only with "Connection: keep-alive"
+    bool keep_alive = false;
 };
 }
 }
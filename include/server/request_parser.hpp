@@ -4,6 +4,7 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
 #include <tuple>
 
 namespace osrm
@@ -19,6 +20,9 @@ struct request;
 class RequestParser
 {
   public:
+    // larger request bodies are rejected
+    static const constexpr std::size_t MAX_CONTENT_LENGTH = 64 * 1024 * 1024;
+
     RequestParser();
 
     enum class RequestStatus : char
@@ -28,7 +32,10 @@ class RequestParser
         indeterminate
     };
 
-    std::tuple<RequestStatus, http::compression_type>
+    // Consumes input up to the end of the first complete request. The returned position
+    // points behind the last consumed character, any data after it belongs to the next
+    // (pipelined) request and has to be parsed by a new parser.
+    std::tuple<RequestStatus, http::compression_type, char *>
     parse(http::request &current_request, char *begin, char *end);
 
   private:
@@ -64,11 +71,15 @@ class RequestParser
         space_before_header_value,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        body
     } state;
 
     http::header current_header;
     http::compression_type selected_compression;
+    std::size_t content_length;
+    unsigned http_version_major;
+    unsigned http_version_minor;
 };
 }
 }
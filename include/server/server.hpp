@@ -13,6 +13,10 @@
 
 #include <zlib.h>
 
+#ifdef USE_ZSTD_LIBRARY
+#include <zstd.h>
+#endif
+
 #ifndef _WIN32
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -29,43 +33,89 @@ namespace osrm
 namespace server
 {
 
+// Accepts connections and runs them on a pool of threads.
+//
+// By default all threads share one io_service and one acceptor. In sharded mode every thread
+// owns an io_service with its own acceptor bound to the same endpoint with SO_REUSEPORT, the
+// kernel distributes incoming connections over the acceptors and a connection stays on the
+// thread that accepted it.
 class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                unsigned keepalive_timeout = 0,
+                                                unsigned keepalive_max_requests = 1,
+                                                bool sharded = false,
+                                                std::size_t compression_min_size = 0)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
+#ifdef USE_ZSTD_LIBRARY
+        util::Log() << "zstd compression handled by zstd version " << ZSTD_versionString();
+#endif
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+#ifndef SO_REUSEPORT
+        if (sharded)
+        {
+            util::Log(logWARNING) << "SO_REUSEPORT is not supported, using a shared io_service";
+            sharded = false;
+        }
+#endif
+        return std::make_shared<Server>(ip_address,
+                                        ip_port,
+                                        real_num_threads,
+                                        keepalive_timeout,
+                                        keepalive_max_requests,
+                                        sharded,
+                                        compression_min_size);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_service),
-          new_connection(std::make_shared<Connection>(io_service, request_handler))
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned thread_pool_size,
+                    const unsigned keepalive_timeout = 0,
+                    const unsigned keepalive_max_requests = 1,
+                    const bool sharded = false,
+                    const std::size_t compression_min_size = 0)
+        : thread_pool_size(thread_pool_size), keepalive_timeout(keepalive_timeout),
+          keepalive_max_requests(keepalive_max_requests), compression_min_size(compression_min_size)
     {
+        const auto number_of_shards = sharded ? std::max(thread_pool_size, 1u) : 1u;
+        for (unsigned i = 0; i < number_of_shards; ++i)
+        {
+            shards.push_back(std::make_unique<Shard>());
+        }
+
         const auto port_string = std::to_string(port);
 
-        boost::asio::ip::tcp::resolver resolver(io_service);
+        boost::asio::ip::tcp::resolver resolver(shards.front()->io_service);
         boost::asio::ip::tcp::resolver::query query(address, port_string);
         boost::asio::ip::tcp::endpoint endpoint = *resolver.resolve(query);
 
-        acceptor.open(endpoint.protocol());
+        for (auto &shard : shards)
+        {
+            auto &acceptor = shard->acceptor;
+            acceptor.open(endpoint.protocol());
 #ifdef SO_REUSEPORT
-        const int option = 1;
-        setsockopt(acceptor.native_handle(), SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option));
+            const int option = 1;
+            setsockopt(
+                acceptor.native_handle(), SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option));
 #endif
-        acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
-        acceptor.bind(endpoint);
-        acceptor.listen();
+            acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            acceptor.bind(endpoint);
+            acceptor.listen();
+
+            // all shards have to listen on the port the first one got, even for port 0
+            endpoint = acceptor.local_endpoint();
 
-        util::Log() << "Listening on: " << acceptor.local_endpoint();
+            AsyncAccept(*shard);
+        }
 
-        acceptor.async_accept(
-            new_connection->socket(),
-            boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
+        util::Log() << "Listening on: " << endpoint
+                    << (sharded ? " with one acceptor per thread" : "");
     }
 
     void Run()
@@ -73,6 +123,7 @@ class Server
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
+            auto &io_service = shards[i % shards.size()]->io_service;
             std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
                 boost::bind(&boost::asio::io_service::run, &io_service));
             threads.push_back(thread);
@@ -83,7 +134,13 @@ class Server
         }
     }
 
-    void Stop() { io_service.stop(); }
+    void Stop()
+    {
+        for (auto &shard : shards)
+        {
+            shard->io_service.stop();
+        }
+    }
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler_)
     {
@@ -91,23 +148,44 @@ class Server
     }
 
   private:
-    void HandleAccept(const boost::system::error_code &e)
+    struct Shard
+    {
+        Shard() : acceptor(io_service) {}
+
+        boost::asio::io_service io_service;
+        boost::asio::ip::tcp::acceptor acceptor;
+        std::shared_ptr<Connection> new_connection;
+    };
+
+    void AsyncAccept(Shard &shard)
+    {
+        shard.new_connection = std::make_shared<Connection>(shard.io_service,
+                                                            request_handler,
+                                                            keepalive_timeout,
+                                                            keepalive_max_requests,
+                                                            compression_min_size);
+        shard.acceptor.async_accept(shard.new_connection->socket(),
+                                    boost::bind(&Server::HandleAccept,
+                                                this,
+                                                boost::ref(shard),
+                                                boost::asio::placeholders::error));
+    }
+
+    void HandleAccept(Shard &shard, const boost::system::error_code &e)
     {
         if (!e)
         {
-            new_connection->start();
-            new_connection = std::make_shared<Connection>(io_service, request_handler);
-            acceptor.async_accept(
-                new_connection->socket(),
-                boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
+            shard.new_connection->start();
+            AsyncAccept(shard);
         }
     }
 
     unsigned thread_pool_size;
-    boost::asio::io_service io_service;
-    boost::asio::ip::tcp::acceptor acceptor;
-    std::shared_ptr<Connection> new_connection;
+    unsigned keepalive_timeout;
+    unsigned keepalive_max_requests;
+    std::size_t compression_min_size;
     RequestHandler request_handler;
+    std::vector<std::unique_ptr<Shard>> shards;
 };
 }
 }
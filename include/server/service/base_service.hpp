@@ -1,6 +1,7 @@
 #ifndef SERVER_SERVICE_BASE_SERVICE_HPP
 #define SERVER_SERVICE_BASE_SERVICE_HPP
 
+#include "engine/api/base_parameters.hpp"
 #include "engine/status.hpp"
 #include "osrm/osrm.hpp"
 #include "util/coordinate.hpp"
@@ -17,16 +18,39 @@ namespace server
 namespace service
 {
 
+// Response that was written by an engine::api::BinaryWriter
+struct BinaryResult
+{
+    std::vector<char> buffer;
+};
+
 class BaseService
 {
   public:
-    using ResultT = mapbox::util::variant<util::json::Object, std::string>;
+    // json::Object trees, JSON that was already rendered by a json::Writer, protobuf data or
+    // binary responses
+    using ResultT =
+        mapbox::util::variant<util::json::Object, std::vector<char>, std::string, BinaryResult>;
+    using OutputFormatType = engine::api::BaseParameters::OutputFormatType;
 
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
 
-    virtual engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) = 0;
+    // `format` is used for queries that do not request a format with the URL extension
+    virtual engine::Status RunQuery(std::size_t prefix_length,
+                                    std::string &query,
+                                    const OutputFormatType format,
+                                    ResultT &result) = 0;
+
+    // Requests that were sent with a body. Only services that read the body override this.
+    virtual engine::Status RunBodyQuery(std::size_t prefix_length,
+                                        std::string &query,
+                                        const OutputFormatType format,
+                                        const std::string & /*body*/,
+                                        ResultT &result)
+    {
+        return RunQuery(prefix_length, query, format, result);
+    }
 
     virtual unsigned GetVersion() = 0;
 
@@ -22,8 +22,17 @@ class MatchService final : public BaseService
   public:
     MatchService(OSRM &routing_machine) : BaseService(routing_machine) {}
 
-    engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) final override;
+    engine::Status RunQuery(std::size_t prefix_length,
+                            std::string &query,
+                            const OutputFormatType format,
+                            ResultT &result) final override;
+
+    // POST requests to "batch" with one trace per line of the body
+    engine::Status RunBodyQuery(std::size_t prefix_length,
+                                std::string &query,
+                                const OutputFormatType format,
+                                const std::string &body,
+                                ResultT &result) final override;
 
     unsigned GetVersion() final override { return 1; }
 };
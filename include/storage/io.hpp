@@ -16,6 +16,7 @@
 #include <cstring>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace osrm
 {
@@ -49,8 +50,11 @@ class FileReader
     }
 
     FileReader(const boost::filesystem::path &filepath_, const FingerprintFlag flag)
-        : filepath(filepath_), fingerprint(flag)
+        : filepath(filepath_), read_buffer(READ_BUFFER_SIZE), fingerprint(flag)
     {
+        // the buffer has to be set before opening, small reads are then served from memory
+        // and every read from the file fills a whole megabyte
+        input_stream.rdbuf()->pubsetbuf(read_buffer.data(), read_buffer.size());
         input_stream.open(filepath, std::ios::binary);
 
         // Note: filepath.string() is wrapped in std::string() because it can
@@ -176,7 +180,10 @@ class FileReader
     }
 
   private:
+    static const constexpr std::size_t READ_BUFFER_SIZE = 1024 * 1024;
+
     const boost::filesystem::path filepath;
+    std::vector<char> read_buffer;
     boost::filesystem::ifstream input_stream;
     FingerprintFlag fingerprint;
 };
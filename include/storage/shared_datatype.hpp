@@ -86,6 +86,16 @@ const constexpr char *block_id_to_name[] = {"NAME_CHAR_DATA",
                                             "MLD_GRAPH_EDGE_LIST",
                                             "MLD_GRAPH_NODE_TO_OFFSET"};
 
+enum SharedDataType
+{
+    REGION_NONE,
+    REGION_1,
+    REGION_2,
+    // regions of metric updates, they are based on REGION_1 or REGION_2
+    REGION_3,
+    REGION_4
+};
+
 struct DataLayout
 {
     enum BlockID
@@ -164,7 +174,72 @@ struct DataLayout
     std::array<std::size_t, NUM_BLOCKS> entry_size;
     std::array<std::size_t, NUM_BLOCKS> entry_align;
 
-    DataLayout() : num_entries(), entry_size(), entry_align() {}
+    // A metric update only stores the metric blocks, all other blocks are read from the full
+    // region it is based on. REGION_NONE if this layout stores all blocks.
+    SharedDataType base_region;
+    // Process local layout and memory of the attached base region. Metrics loaded into process
+    // memory only set these, their base is not a shared memory region.
+    const DataLayout *base_layout;
+    char *base_memory;
+
+    DataLayout()
+        : num_entries(), entry_size(), entry_align(), base_region(REGION_NONE),
+          base_layout(nullptr), base_memory(nullptr)
+    {
+    }
+
+    // Blocks that are changed by osrm-contract and osrm-customize
+    static bool IsMetricBlock(BlockID bid)
+    {
+        if (bid >= MLD_CELL_WEIGHTS_0 && bid <= MLD_CELL_DURATIONS_7)
+        {
+            return true;
+        }
+
+        switch (bid)
+        {
+        case CH_GRAPH_NODE_LIST:
+        case CH_GRAPH_EDGE_LIST:
+        case HSGR_CHECKSUM:
+        case CH_CORE_MARKER:
+        case GEOMETRIES_FWD_WEIGHT_LIST:
+        case GEOMETRIES_REV_WEIGHT_LIST:
+        case GEOMETRIES_FWD_DURATION_LIST:
+        case GEOMETRIES_REV_DURATION_LIST:
+        case GEOMETRIES_FWD_DATASOURCES_LIST:
+        case GEOMETRIES_REV_DATASOURCES_LIST:
+        case DATASOURCES_NAMES:
+        case TURN_WEIGHT_PENALTIES:
+        case TURN_DURATION_PENALTIES:
+        case MLD_GRAPH_NODE_LIST:
+        case MLD_GRAPH_EDGE_LIST:
+        case MLD_GRAPH_NODE_TO_OFFSET:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline bool IsInBaseRegion(BlockID bid) const
+    {
+        return (base_region != REGION_NONE || base_layout != nullptr) && !IsMetricBlock(bid);
+    }
+
+    // First block read from the base that differs in size from the base layout, NUM_BLOCKS if
+    // the base can be shared
+    BlockID FindBaseMismatch(const DataLayout &base) const
+    {
+        for (auto i = 0; i < NUM_BLOCKS; i++)
+        {
+            const auto bid = static_cast<BlockID>(i);
+            if (IsInBaseRegion(bid) && (num_entries[bid] != base.num_entries[bid] ||
+                                        entry_size[bid] != base.entry_size[bid]))
+            {
+                return bid;
+            }
+        }
+        return NUM_BLOCKS;
+    }
 
     template <typename T> inline void SetBlockSize(BlockID bid, uint64_t entries)
     {
@@ -192,6 +267,10 @@ struct DataLayout
         for (auto i = 0; i < NUM_BLOCKS; i++)
         {
             BOOST_ASSERT(entry_align[i] > 0);
+            if (IsInBaseRegion((BlockID)i))
+            {
+                continue;
+            }
             result += 2 * sizeof(CANARY) + GetBlockSize((BlockID)i) + entry_align[i];
         }
         return result;
@@ -212,6 +291,10 @@ struct DataLayout
     {
         for (auto i = 0; i < bid; i++)
         {
+            if (IsInBaseRegion((BlockID)i))
+            {
+                continue;
+            }
             ptr = static_cast<char *>(ptr) + sizeof(CANARY);
             ptr = align(entry_align[i], entry_size[i], ptr);
             ptr = static_cast<char *>(ptr) + GetBlockSize((BlockID)i);
@@ -232,6 +315,17 @@ struct DataLayout
     template <typename T, bool WRITE_CANARY = false>
     inline T *GetBlockPtr(char *shared_memory, BlockID bid) const
     {
+        if (IsInBaseRegion(bid))
+        {
+            BOOST_ASSERT_MSG(!WRITE_CANARY, "Blocks of the base region are never written");
+            if (base_layout == nullptr)
+            {
+                throw util::exception("Base region of block is not attached. (" +
+                                      std::string(block_id_to_name[bid]) + ")" + SOURCE_REF);
+            }
+            return base_layout->GetBlockPtr<T>(base_memory, bid);
+        }
+
         char *ptr = (char *)GetAlignedBlockPtr(shared_memory, bid);
         if (WRITE_CANARY)
         {
@@ -262,13 +356,6 @@ struct DataLayout
     }
 };
 
-enum SharedDataType
-{
-    REGION_NONE,
-    REGION_1,
-    REGION_2
-};
-
 struct SharedDataTimestamp
 {
     explicit SharedDataTimestamp(SharedDataType region, unsigned timestamp)
@@ -290,6 +377,10 @@ inline std::string regionToString(const SharedDataType region)
         return "REGION_1";
     case REGION_2:
         return "REGION_2";
+    case REGION_3:
+        return "REGION_3";
+    case REGION_4:
+        return "REGION_4";
     case REGION_NONE:
         return "REGION_NONE";
     default:
@@ -3,6 +3,7 @@
 
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
+#include "util/huge_pages.hpp"
 #include "util/log.hpp"
 
 #include <boost/filesystem.hpp>
@@ -19,7 +20,9 @@
 #include <sys/shm.h>
 #endif
 
+#include <cerrno>
 #include <cstdint>
+#include <cstring>
 
 #include <algorithm>
 #include <exception>
@@ -54,7 +57,8 @@ class SharedMemory
     template <typename IdentifierT>
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
-                 const uint64_t size = 0)
+                 const uint64_t size = 0,
+                 const bool use_huge_pages = false)
         : key(lock_file.string().c_str(), id)
     {
         // open only
@@ -69,6 +73,9 @@ class SharedMemory
         // open or create
         else
         {
+#ifdef __linux__
+            const bool huge_tlb = use_huge_pages && CreateHugePageSegment(size);
+#endif
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::Log(logDEBUG) << "opening/creating " << shm.get_shmid() << " from id " << id
@@ -83,6 +90,18 @@ class SharedMemory
             }
 #endif
             region = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
+#ifdef __linux__
+            if (use_huge_pages && !huge_tlb &&
+                !util::adviseHugePages(region.get_address(), region.get_size()))
+            {
+                util::Log(logWARNING) << "Transparent huge pages are not available";
+            }
+#else
+            if (use_huge_pages)
+            {
+                util::Log(logWARNING) << "Huge pages are only supported on Linux";
+            }
+#endif
         }
     }
 
@@ -161,6 +180,24 @@ class SharedMemory
 #endif
 
   private:
+#ifdef __linux__
+    // Boost creates segments without flags, a segment backed by reserved huge pages is
+    // created up front and then opened by Boost like any other segment.
+    bool CreateHugePageSegment(const uint64_t size)
+    {
+        const auto aligned_size = util::alignToHugePages(size);
+        if (-1 == ::shmget(key.get_key(), aligned_size, IPC_CREAT | IPC_EXCL | SHM_HUGETLB | 0644))
+        {
+            const auto error = std::strerror(errno);
+            util::Log(logWARNING) << "Could not create a shared memory segment of "
+                                  << aligned_size << " bytes with reserved huge pages (" << error
+                                  << "), falling back to transparent huge pages";
+            return false;
+        }
+        return true;
+    }
+#endif
+
     static bool RegionExists(const boost::interprocess::xsi_key &key)
     {
         bool result = true;
@@ -201,7 +238,10 @@ class SharedMemory
   public:
     void *Ptr() const { return region.get_address(); }
 
-    SharedMemory(const boost::filesystem::path &lock_file, const int id, const uint64_t size = 0)
+    SharedMemory(const boost::filesystem::path &lock_file,
+                 const int id,
+                 const uint64_t size = 0,
+                 const bool use_huge_pages = false)
     {
         sprintf(key, "%s.%d", "osrm.lock", id);
         if (0 == size)
@@ -218,6 +258,10 @@ class SharedMemory
             region = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
 
             util::Log(logDEBUG) << "writeable memory allocated " << size << " bytes";
+            if (use_huge_pages)
+            {
+                util::Log(logWARNING) << "Huge pages are only supported on Linux";
+            }
         }
     }
 
@@ -283,7 +327,9 @@ class SharedMemory
 #endif
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
-std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint64_t size = 0)
+std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id,
+                                               const uint64_t size = 0,
+                                               const bool use_huge_pages = false)
 {
     try
     {
@@ -299,7 +345,7 @@ std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint
                 boost::filesystem::ofstream ofs(lock_file());
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(), id, size);
+        return std::make_unique<SharedMemory>(lock_file(), id, size, use_huge_pages);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
@@ -34,20 +34,49 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/filesystem/path.hpp>
 
 #include <string>
+#include <vector>
 
 namespace osrm
 {
 namespace storage
 {
+
+// The region an update loads into. A full update alternates between REGION_1 and REGION_2,
+// a metric update between REGION_3 and REGION_4 and needs the full region in_use_base_region
+// the data in use is based on.
+SharedDataType
+getNextRegion(SharedDataType in_use_region, SharedDataType in_use_base_region, bool only_metric);
+
+// The regions an update removes once the clients switched to the new region. A metric update
+// keeps the region it is based on, a full update removes both the region in use and its base.
+std::vector<SharedDataType> getRetiredRegions(SharedDataType in_use_region,
+                                              SharedDataType in_use_base_region,
+                                              bool only_metric);
+
 class Storage
 {
   public:
     Storage(StorageConfig config);
 
-    int Run(int max_wait);
+    // Loads the dataset into a new shared memory region and switches all clients to it.
+    // With only_metric only the blocks changed by osrm-contract and osrm-customize are loaded,
+    // the new region shares all other blocks with the full region of the data in use.
+    // With use_huge_pages the region is backed by huge pages.
+    int Run(int max_wait, bool only_metric, bool use_huge_pages);
 
     void PopulateLayout(DataLayout &layout);
     void PopulateData(const DataLayout &layout, char *memory_ptr);
+    // Blocks created by osrm-extract and osrm-partition
+    void PopulateStaticData(const DataLayout &layout, char *memory_ptr);
+    // Blocks changed by osrm-contract and osrm-customize, see DataLayout::IsMetricBlock
+    void PopulateUpdatableData(const DataLayout &layout, char *memory_ptr);
+
+    // First block of layout that can't be read from the base, NUM_BLOCKS if the base holds the
+    // same static data. Besides the sizes of all blocks the timestamps of the extracted data
+    // have to match, otherwise TIMESTAMP is returned.
+    DataLayout::BlockID FindBaseMismatch(const DataLayout &layout,
+                                         const DataLayout &base_layout,
+                                         char *base_memory) const;
 
   private:
     StorageConfig config;
@@ -71,7 +71,7 @@ struct StorageConfig final : IOConfig
                     ".osrm.tld",
                     ".osrm.tls",
                     ".osrm.partition"},
-                   {})
+                   {".osrm.memory"})
     {
     }
 };
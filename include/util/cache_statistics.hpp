@@ -0,0 +1,35 @@
+#ifndef OSRM_UTIL_CACHE_STATISTICS_HPP
+#define OSRM_UTIL_CACHE_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm
+{
+namespace util
+{
+
+// Counters of a response cache, all since the cache was created
+struct CacheStatistics
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    // entries dropped to make room for new ones
+    std::uint64_t evictions = 0;
+    // times the cache was emptied because the data changed
+    std::uint64_t invalidations = 0;
+    // current number of entries and their size in bytes
+    std::size_t entries = 0;
+    std::size_t size = 0;
+
+    // share of the lookups answered from the cache, 0 without lookups
+    double HitRate() const
+    {
+        const auto lookups = hits + misses;
+        return lookups == 0 ? 0. : static_cast<double>(hits) / lookups;
+    }
+};
+}
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef OSRM_UTIL_HUGE_PAGES_HPP
+#define OSRM_UTIL_HUGE_PAGES_HPP
+
+#include <cstddef>
+
+namespace osrm
+{
+namespace util
+{
+
+// Default huge page size on x86-64 and on aarch64 with 4K base pages
+const constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Huge page backed mappings must span whole huge pages
+inline std::size_t alignToHugePages(const std::size_t size)
+{
+    return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+// Asks the kernel to back the range with transparent huge pages, returns false if that is
+// not supported. The kernel needs transparent huge pages enabled for madvise (or always).
+bool adviseHugePages(void *address, const std::size_t size);
+
+/**
+ * A block of process memory for the dataset.
+ *
+ * With use_huge_pages the block is mapped with MAP_HUGETLB from the huge pages reserved in
+ * /proc/sys/vm/nr_hugepages. If there are not enough, it falls back to normal pages backed
+ * by transparent huge pages. Either way random accesses into the graphs and the r-tree need
+ * far fewer TLB entries than with 4K pages.
+ */
+class ProcessMemory
+{
+  public:
+    ProcessMemory(const std::size_t size, const bool use_huge_pages);
+    ~ProcessMemory();
+
+    ProcessMemory(const ProcessMemory &) = delete;
+    ProcessMemory &operator=(const ProcessMemory &) = delete;
+
+    char *get() const { return memory; }
+    // true only if the memory is backed by reserved huge pages
+    bool UsesHugeTLB() const { return huge_tlb; }
+
+  private:
+    char *memory;
+    std::size_t mapped_size;
+    bool huge_tlb;
+};
+}
+}
+
+#endif
@@ -9,6 +9,9 @@
 
 #include "osrm/json_container.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iterator>
 #include <ostream>
 #include <string>
@@ -21,6 +24,54 @@ namespace util
 namespace json
 {
 
+namespace detail
+{
+inline void appendInteger(std::vector<char> &out, const std::int64_t value)
+{
+    char buffer[20];
+    auto magnitude =
+        value < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(value) : std::uint64_t(value);
+    auto begin = std::end(buffer);
+    do
+    {
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+        out.push_back('-');
+    out.insert(out.end(), begin, std::end(buffer));
+}
+
+// Produces exactly the same characters as cast::to_string_with_precision<double, 6>
+// without going through a std::ostringstream.
+inline void appendNumber(std::vector<char> &out, const double value)
+{
+    // integral values are printed as "X.000000" and trimmed to "X" anyway
+    if (std::abs(value) < 1e15 && std::trunc(value) == value && !std::signbit(value))
+    {
+        appendInteger(out, static_cast<std::int64_t>(value));
+        return;
+    }
+
+    char buffer[512];
+    const auto length = std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+    if (length < 0 || static_cast<std::size_t>(length) >= sizeof(buffer))
+    {
+        const auto number_string = cast::to_string_with_precision(value);
+        out.insert(out.end(), number_string.begin(), number_string.end());
+        return;
+    }
+
+    auto end = buffer + length;
+    while (end != buffer && *(end - 1) == '0')
+        --end;
+    if (end != buffer && *(end - 1) == '.')
+        --end;
+    out.insert(out.end(), buffer, end);
+}
+}
+
 struct Renderer
 {
     explicit Renderer(std::ostream &_out) : out(_out) {}
@@ -89,11 +140,7 @@ struct ArrayRenderer
         out.push_back('\"');
     }
 
-    void operator()(const Number &number) const
-    {
-        const std::string number_string = cast::to_string_with_precision(number.value);
-        out.insert(out.end(), number_string.begin(), number_string.end());
-    }
+    void operator()(const Number &number) const { detail::appendNumber(out, number.value); }
 
     void operator()(const Object &object) const
     {
@@ -158,8 +205,7 @@ inline void render(std::ostream &out, const Object &object)
 
 inline void render(std::vector<char> &out, const Object &object)
 {
-    Value value = object;
-    mapbox::util::apply_visitor(ArrayRenderer(out), value);
+    ArrayRenderer{out}(object);
 }
 
 } // namespace json
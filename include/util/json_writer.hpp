@@ -0,0 +1,185 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+#include "util/string_util.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace json
+{
+
+/**
+ * Streaming JSON writer that appends directly to a character buffer.
+ *
+ * Unlike building a json::Object tree and rendering it afterwards, values are written as soon
+ * as they are known. Separators are inserted automatically, so a writer is used like this:
+ *
+ *   writer.StartObject();
+ *   writer.Key("durations");
+ *   writer.StartArray();
+ *   writer.Number(1.5);
+ *   writer.Null();
+ *   writer.EndArray();
+ *   writer.EndObject();
+ *
+ * The output is byte-for-byte identical to the output of ArrayRenderer for the same values.
+ */
+class Writer
+{
+  public:
+    explicit Writer(std::vector<char> &buffer_) : buffer(buffer_) {}
+
+    void StartObject()
+    {
+        Separate();
+        buffer.push_back('{');
+        first = true;
+    }
+
+    void EndObject()
+    {
+        buffer.push_back('}');
+        first = false;
+    }
+
+    void StartArray()
+    {
+        Separate();
+        buffer.push_back('[');
+        first = true;
+    }
+
+    void EndArray()
+    {
+        buffer.push_back(']');
+        first = false;
+    }
+
+    // Keys are not escaped, same as in ArrayRenderer
+    void Key(const std::string &key)
+    {
+        Separate();
+        buffer.push_back('\"');
+        buffer.insert(buffer.end(), key.begin(), key.end());
+        buffer.push_back('\"');
+        buffer.push_back(':');
+        first = true;
+    }
+
+    void String(const std::string &string)
+    {
+        Separate();
+        buffer.push_back('\"');
+        const auto escaped = escape_JSON(string);
+        buffer.insert(buffer.end(), escaped.begin(), escaped.end());
+        buffer.push_back('\"');
+    }
+
+    void Number(const double number)
+    {
+        Separate();
+        detail::appendNumber(buffer, number);
+    }
+
+    void Integer(const std::int64_t number)
+    {
+        Separate();
+        detail::appendInteger(buffer, number);
+    }
+
+    void Null() { Literal("null"); }
+
+    void Bool(const bool value)
+    {
+        if (value)
+            Literal("true");
+        else
+            Literal("false");
+    }
+
+    // Renders a complete json::Value subtree at the current position
+    void Value(const json::Value &value)
+    {
+        Separate();
+        mapbox::util::apply_visitor(ArrayRenderer(buffer), value);
+    }
+
+    void Value(const json::Object &object)
+    {
+        Separate();
+        ArrayRenderer{buffer}(object);
+    }
+
+    void Value(const json::Array &array)
+    {
+        Separate();
+        ArrayRenderer{buffer}(array);
+    }
+
+    /**
+     * Writes the members of `skeleton` in the order the tree renderer would use.
+     *
+     * json::Object is an unordered map, so the member order depends on the keys that were
+     * inserted. Building a skeleton with the same insertion sequence and placeholder values for
+     * the large members keeps the output identical to rendering the full tree.
+     * `stream_member(key)` is called after each key has been written; it either writes the
+     * value itself and returns true, or returns false to render the skeleton's value.
+     */
+    template <typename StreamMember>
+    void Object(const json::Object &skeleton, StreamMember &&stream_member)
+    {
+        StartObject();
+        for (const auto &member : skeleton.values)
+        {
+            Key(member.first);
+            if (!stream_member(member.first))
+            {
+                Value(member.second);
+            }
+        }
+        EndObject();
+    }
+
+    // The buffer the writer appends to
+    const std::vector<char> &Buffer() const { return buffer; }
+
+    // Writes a value rendered by an earlier writer, e.g. a cached response
+    void Raw(const std::string &json)
+    {
+        Separate();
+        buffer.insert(buffer.end(), json.begin(), json.end());
+    }
+
+  private:
+    void Separate()
+    {
+        if (!first)
+        {
+            buffer.push_back(',');
+        }
+        first = false;
+    }
+
+    template <std::size_t N> void Literal(const char (&literal)[N])
+    {
+        Separate();
+        buffer.insert(buffer.end(), literal, literal + N - 1);
+    }
+
+    std::vector<char> &buffer;
+    bool first = true;
+};
+
+} // namespace json
+} // namespace util
+} // namespace osrm
+
+#endif // JSON_WRITER_HPP
@@ -0,0 +1,117 @@
+#ifndef OSRM_UTIL_LRU_CACHE_HPP
+#define OSRM_UTIL_LRU_CACHE_HPP
+
+#include "util/cache_statistics.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * A least recently used cache bounded by the total size of its values, safe to use from
+ * several threads. Every value is put with its size in bytes, the least recently used entries
+ * are evicted once the sizes add up to more than max_size.
+ *
+ * Lookups copy the value while the cache is locked, large values should be held by
+ * a shared_ptr.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class LRUCache
+{
+  public:
+    explicit LRUCache(const std::size_t max_size) : max_size(max_size) {}
+
+    std::size_t GetMaxSize() const { return max_size; }
+
+    // Copies the value for key into value and marks it as most recently used
+    bool Get(const Key &key, Value &value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(key);
+        if (found == index.end())
+        {
+            ++statistics.misses;
+            return false;
+        }
+
+        entries.splice(entries.begin(), entries, found->second);
+        value = found->second->value;
+        ++statistics.hits;
+        return true;
+    }
+
+    // Inserts or replaces the value for key. Values larger than the whole cache are not stored.
+    void Put(const Key &key, Value value, const std::size_t size)
+    {
+        if (size > max_size)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(key);
+        if (found != index.end())
+        {
+            statistics.size -= found->second->size;
+            entries.erase(found->second);
+            index.erase(found);
+        }
+
+        while (statistics.size + size > max_size)
+        {
+            statistics.size -= entries.back().size;
+            index.erase(entries.back().key);
+            entries.pop_back();
+            ++statistics.evictions;
+        }
+
+        entries.push_front(Entry{key, std::move(value), size});
+        index.emplace(key, entries.begin());
+        statistics.size += size;
+        statistics.entries = entries.size();
+    }
+
+    // Drops all entries, counted as an invalidation
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        index.clear();
+        statistics.size = 0;
+        statistics.entries = 0;
+        ++statistics.invalidations;
+    }
+
+    CacheStatistics GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return statistics;
+    }
+
+  private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        std::size_t size;
+    };
+    using EntryList = std::list<Entry>;
+
+    const std::size_t max_size;
+    mutable std::mutex mutex;
+    // most recently used first
+    EntryList entries;
+    std::unordered_map<Key, typename EntryList::iterator, Hash> index;
+    CacheStatistics statistics;
+};
+}
+}
+
+#endif
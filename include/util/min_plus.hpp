@@ -0,0 +1,177 @@
+#ifndef OSRM_UTIL_MIN_PLUS_HPP
+#define OSRM_UTIL_MIN_PLUS_HPP
+
+#include "util/typedefs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace osrm
+{
+namespace util
+{
+
+// Kernels for the dense weight rows of the MLD cells. They use AVX2 if the compiler targets it
+// (e.g. -mavx2 or -march=native), SSE2 on every other x86-64 target and scalar code elsewhere.
+
+namespace detail
+{
+// index of the lowest set bit, mask must not be 0
+inline unsigned lowestSetBit(unsigned mask)
+{
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    while ((mask & 1u) == 0)
+    {
+        mask >>= 1u;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+template <std::size_t Width, typename Callback>
+inline void forEachSetBit(const std::size_t offset, unsigned mask, Callback &callback)
+{
+    // rows are mostly valid, a full vector needs no bit scans
+    if (mask == (1u << Width) - 1)
+    {
+        for (std::size_t index = 0; index < Width; ++index)
+        {
+            callback(offset + index);
+        }
+        return;
+    }
+
+    while (mask != 0)
+    {
+        callback(offset + lowestSetBit(mask));
+        mask &= mask - 1;
+    }
+}
+}
+
+// Calls callback(index) in increasing order for every weight that is not INVALID_EDGE_WEIGHT.
+// Whole vectors of invalid weights are skipped with a single comparison.
+template <typename Callback>
+inline void forEachValidWeight(const EdgeWeight *weights, const std::size_t size, Callback callback)
+{
+    std::size_t index = 0;
+#if defined(__AVX2__)
+    const auto invalid = _mm256_set1_epi32(INVALID_EDGE_WEIGHT);
+    for (; index + 8 <= size; index += 8)
+    {
+        const auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + index));
+        const auto is_invalid = _mm256_castsi256_ps(_mm256_cmpeq_epi32(values, invalid));
+        const auto valid_mask = ~static_cast<unsigned>(_mm256_movemask_ps(is_invalid)) & 0xFFu;
+        detail::forEachSetBit<8>(index, valid_mask, callback);
+    }
+#elif defined(__SSE2__)
+    const auto invalid = _mm_set1_epi32(INVALID_EDGE_WEIGHT);
+    for (; index + 4 <= size; index += 4)
+    {
+        const auto values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + index));
+        const auto is_invalid = _mm_castsi128_ps(_mm_cmpeq_epi32(values, invalid));
+        const auto valid_mask = ~static_cast<unsigned>(_mm_movemask_ps(is_invalid)) & 0xFu;
+        detail::forEachSetBit<4>(index, valid_mask, callback);
+    }
+#endif
+    for (; index < size; ++index)
+    {
+        if (weights[index] != INVALID_EDGE_WEIGHT)
+        {
+            callback(index);
+        }
+    }
+}
+
+// Min-plus update of a matrix row: target[i] = min(target[i], offset + row[i]) for the valid
+// entries of the row. A duration is replaced together with the weight it belongs to, equal
+// weights keep the target.
+inline void minPlus(EdgeWeight *target_weights,
+                    EdgeDuration *target_durations,
+                    const EdgeWeight *weights,
+                    const EdgeDuration *durations,
+                    const std::size_t size,
+                    const EdgeWeight offset_weight,
+                    const EdgeDuration offset_duration)
+{
+    std::size_t index = 0;
+#if defined(__AVX2__)
+    const auto invalid = _mm256_set1_epi32(INVALID_EDGE_WEIGHT);
+    const auto offset_weights = _mm256_set1_epi32(offset_weight);
+    const auto offset_durations = _mm256_set1_epi32(offset_duration);
+    for (; index + 8 <= size; index += 8)
+    {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + index));
+        auto target = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target_weights + index));
+        const auto sum = _mm256_add_epi32(row, offset_weights);
+        const auto better = _mm256_andnot_si256(_mm256_cmpeq_epi32(row, invalid),
+                                                _mm256_cmpgt_epi32(target, sum));
+        if (_mm256_testz_si256(better, better))
+        {
+            continue;
+        }
+
+        target = _mm256_blendv_epi8(target, sum, better);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(target_weights + index), target);
+
+        const auto row_durations =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(durations + index));
+        auto target_duration =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target_durations + index));
+        target_duration = _mm256_blendv_epi8(
+            target_duration, _mm256_add_epi32(row_durations, offset_durations), better);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(target_durations + index),
+                            target_duration);
+    }
+#elif defined(__SSE2__)
+    const auto invalid = _mm_set1_epi32(INVALID_EDGE_WEIGHT);
+    const auto offset_weights = _mm_set1_epi32(offset_weight);
+    const auto offset_durations = _mm_set1_epi32(offset_duration);
+    for (; index + 4 <= size; index += 4)
+    {
+        const auto row = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + index));
+        auto target = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target_weights + index));
+        const auto sum = _mm_add_epi32(row, offset_weights);
+        const auto better =
+            _mm_andnot_si128(_mm_cmpeq_epi32(row, invalid), _mm_cmplt_epi32(sum, target));
+        if (_mm_movemask_epi8(better) == 0)
+        {
+            continue;
+        }
+
+        // SSE2 has no blend, select with masks
+        target = _mm_or_si128(_mm_and_si128(better, sum), _mm_andnot_si128(better, target));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target_weights + index), target);
+
+        const auto row_durations =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(durations + index));
+        const auto sum_durations = _mm_add_epi32(row_durations, offset_durations);
+        auto target_duration =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(target_durations + index));
+        target_duration = _mm_or_si128(_mm_and_si128(better, sum_durations),
+                                       _mm_andnot_si128(better, target_duration));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target_durations + index), target_duration);
+    }
+#endif
+    for (; index < size; ++index)
+    {
+        if (weights[index] != INVALID_EDGE_WEIGHT &&
+            offset_weight + weights[index] < target_weights[index])
+        {
+            target_weights[index] = offset_weight + weights[index];
+            target_durations[index] = offset_duration + durations[index];
+        }
+    }
+}
+}
+}
+
+#endif
@@ -2,12 +2,13 @@
 #define OSRM_UTIL_QUERY_HEAP_HPP
 
 #include <boost/assert.hpp>
-#include <boost/heap/d_ary_heap.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -21,13 +22,13 @@ template <typename NodeID, typename Key> class GenerationArrayStorage
 
   public:
     explicit GenerationArrayStorage(std::size_t size)
-        : positions(size, 0), generation(1), generations(size, 0)
+        : generation(1), generations(size, 0), positions(size, 0)
     {
     }
 
     Key &operator[](NodeID node)
     {
-        generation[node] = generation;
+        generations[node] = generation;
         return positions[node];
     }
 
@@ -126,6 +127,100 @@ template <typename NodeID, typename Key> class UnorderedMapStorage
     std::unordered_map<NodeID, Key> nodes;
 };
 
+// Selects the node index at runtime: generation stamped arrays with O(1) lookups are used
+// if they fit into max_array_memory bytes, otherwise a hash map that only grows with the
+// number of inserted nodes. The arrays grow if a node beyond the initial size is inserted,
+// which happens if a dataset with more nodes is loaded while the heap is kept alive.
+template <typename NodeID, typename Key> class AdaptiveStorage
+{
+    using GenerationCounter = std::uint16_t;
+
+  public:
+    static constexpr std::size_t ARRAY_BYTES_PER_NODE = sizeof(Key) + sizeof(GenerationCounter);
+
+    explicit AdaptiveStorage(std::size_t size, std::size_t max_array_memory = 0)
+        : use_array(FitsArray(size, max_array_memory)),
+          generation(1), generations(use_array ? size : 0, 0), positions(use_array ? size : 0, 0)
+    {
+        if (!use_array)
+        {
+            nodes.rehash(1000);
+        }
+    }
+
+    Key &operator[](const NodeID node)
+    {
+        if (use_array)
+        {
+            if (node >= generations.size())
+            {
+                generations.resize(node + 1, 0);
+                positions.resize(node + 1, 0);
+            }
+            generations[node] = generation;
+            return positions[node];
+        }
+        return nodes[node];
+    }
+
+    Key peek_index(const NodeID node) const
+    {
+        if (use_array)
+        {
+            if (node >= generations.size() || generations[node] != generation)
+            {
+                return std::numeric_limits<Key>::max();
+            }
+            return positions[node];
+        }
+
+        const auto iter = nodes.find(node);
+        if (std::end(nodes) != iter)
+        {
+            return iter->second;
+        }
+        return std::numeric_limits<Key>::max();
+    }
+
+    void Clear()
+    {
+        if (use_array)
+        {
+            generation++;
+            // if generation overflows we end up at 0 again and need to clear the vector
+            if (generation == 0)
+            {
+                generation = 1;
+                std::fill(generations.begin(), generations.end(), 0);
+            }
+        }
+        else
+        {
+            nodes.clear();
+        }
+    }
+
+    bool UsesArray() const { return use_array; }
+
+    static bool FitsArray(const std::size_t size, const std::size_t max_array_memory)
+    {
+        return max_array_memory > 0 && size <= max_array_memory / ARRAY_BYTES_PER_NODE;
+    }
+
+    // Bytes the arrays of a storage for size nodes allocate up front, 0 if it uses the hash map
+    static std::size_t GetArrayMemory(const std::size_t size, const std::size_t max_array_memory)
+    {
+        return FitsArray(size, max_array_memory) ? size * ARRAY_BYTES_PER_NODE : 0;
+    }
+
+  private:
+    bool use_array;
+    GenerationCounter generation;
+    std::vector<GenerationCounter> generations;
+    std::vector<Key> positions;
+    std::unordered_map<NodeID, Key> nodes;
+};
+
 template <typename NodeID,
           typename Key,
           typename Weight,
@@ -136,8 +231,15 @@ class QueryHeap
   public:
     using WeightType = Weight;
     using DataType = Data;
+    using IndexStorageType = IndexStorage;
 
-    explicit QueryHeap(std::size_t maxID) : node_index(maxID) { Clear(); }
+    // Additional arguments are forwarded to the constructor of the index storage
+    template <typename... StorageArgs>
+    explicit QueryHeap(std::size_t maxID, StorageArgs &&... storage_args)
+        : node_index(maxID, std::forward<StorageArgs>(storage_args)...)
+    {
+        Clear();
+    }
 
     void Clear()
     {
@@ -153,9 +255,11 @@ class QueryHeap
     void Insert(NodeID node, Weight weight, const Data &data)
     {
         const auto index = static_cast<Key>(inserted_nodes.size());
-        const auto handle = heap.push(std::make_pair(weight, index));
-        inserted_nodes.emplace_back(HeapNode{handle, node, weight, data});
+        const auto position = static_cast<Key>(heap.size());
+        inserted_nodes.emplace_back(HeapNode{position, node, weight, data});
+        heap.emplace_back(HeapElement{weight, index});
         node_index[node] = index;
+        Upheap(position);
     }
 
     Data &GetData(NodeID node)
@@ -180,7 +284,7 @@ class QueryHeap
     {
         BOOST_ASSERT(WasInserted(node));
         const Key index = node_index.peek_index(node);
-        return inserted_nodes[index].handle == HeapHandle{};
+        return inserted_nodes[index].position == REMOVED_POSITION;
     }
 
     bool WasInserted(const NodeID node) const
@@ -196,28 +300,35 @@ class QueryHeap
     NodeID Min() const
     {
         BOOST_ASSERT(!heap.empty());
-        return inserted_nodes[heap.top().second].node;
+        return inserted_nodes[heap.front().index].node;
     }
 
     Weight MinKey() const
     {
         BOOST_ASSERT(!heap.empty());
-        return heap.top().first;
+        return heap.front().weight;
     }
 
     NodeID DeleteMin()
     {
         BOOST_ASSERT(!heap.empty());
-        const Key removedIndex = heap.top().second;
-        heap.pop();
-        inserted_nodes[removedIndex].handle = HeapHandle{};
+        const Key removedIndex = heap.front().index;
+        inserted_nodes[removedIndex].position = REMOVED_POSITION;
+
+        heap.front() = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            Downheap(0);
+        }
+
         return inserted_nodes[removedIndex].node;
     }
 
     void DeleteAll()
     {
         std::for_each(inserted_nodes.begin(), inserted_nodes.end(), [](auto &node) {
-            node.handle = HeapHandle();
+            node.position = REMOVED_POSITION;
         });
         heap.clear();
     }
@@ -228,27 +339,93 @@ class QueryHeap
         const auto index = node_index.peek_index(node);
         auto &reference = inserted_nodes[index];
         reference.weight = weight;
-        heap.increase(reference.handle, std::make_pair(weight, index));
+        heap[reference.position].weight = weight;
+        Upheap(reference.position);
     }
 
   private:
-    using HeapData = std::pair<Weight, Key>;
-    using HeapContainer = boost::heap::d_ary_heap<HeapData,
-                                                  boost::heap::arity<4>,
-                                                  boost::heap::mutable_<true>,
-                                                  boost::heap::compare<std::greater<HeapData>>>;
-    using HeapHandle = typename HeapContainer::handle_type;
+    // Intrusive 4-ary min-heap: the heap only holds weight/index pairs in one contiguous
+    // array and every inserted node knows its current position in that array, which makes
+    // DecreaseKey a plain sift-up without any handle indirection.
+    static constexpr std::size_t ARITY = 4;
+    static constexpr Key REMOVED_POSITION = std::numeric_limits<Key>::max();
+
+    struct HeapElement
+    {
+        Weight weight;
+        Key index;
+
+        // ties are broken by insertion order
+        bool operator<(const HeapElement &other) const
+        {
+            return weight < other.weight || (weight == other.weight && index < other.index);
+        }
+    };
 
     struct HeapNode
     {
-        HeapHandle handle;
+        Key position;
         NodeID node;
         Weight weight;
         Data data;
     };
 
+    void Upheap(std::size_t position)
+    {
+        const auto element = heap[position];
+        while (position > 0)
+        {
+            const auto parent = (position - 1) / ARITY;
+            if (!(element < heap[parent]))
+            {
+                break;
+            }
+            Place(heap[parent], position);
+            position = parent;
+        }
+        Place(element, position);
+    }
+
+    void Downheap(std::size_t position)
+    {
+        const auto element = heap[position];
+        const auto size = heap.size();
+        while (true)
+        {
+            const auto first_child = ARITY * position + 1;
+            if (first_child >= size)
+            {
+                break;
+            }
+
+            const auto last_child = std::min(first_child + ARITY, size);
+            auto min_child = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child)
+            {
+                if (heap[child] < heap[min_child])
+                {
+                    min_child = child;
+                }
+            }
+
+            if (!(heap[min_child] < element))
+            {
+                break;
+            }
+            Place(heap[min_child], position);
+            position = min_child;
+        }
+        Place(element, position);
+    }
+
+    void Place(const HeapElement &element, const std::size_t position)
+    {
+        heap[position] = element;
+        inserted_nodes[element.index].position = static_cast<Key>(position);
+    }
+
     std::vector<HeapNode> inserted_nodes;
-    HeapContainer heap;
+    std::vector<HeapElement> heap;
     IndexStorage node_index;
 };
 }
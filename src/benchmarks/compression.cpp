@@ -0,0 +1,130 @@
+#include "server/compressor.hpp"
+#include "server/http/compression_type.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/json_writer.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+// Table response with a size x size duration matrix, similar to what the table service renders
+std::vector<char> makeTableResponse(const std::size_t size)
+{
+    std::mt19937 g(1337);
+    std::uniform_int_distribution<int> duration_distribution(0, 100000);
+
+    std::vector<char> buffer;
+    util::json::Writer writer(buffer);
+    writer.StartObject();
+    writer.Key("code");
+    writer.String("Ok");
+    writer.Key("durations");
+    writer.StartArray();
+    for (auto row : util::irange<std::size_t>(0, size))
+    {
+        (void)row;
+        writer.StartArray();
+        for (auto column : util::irange<std::size_t>(0, size))
+        {
+            (void)column;
+            writer.Number(duration_distribution(g) / 10.);
+        }
+        writer.EndArray();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer;
+}
+
+// Compression as done before the compressor existed: a new stream for every reply
+void compressWithNewStream(const std::vector<char> &input, std::vector<char> &output)
+{
+    boost::iostreams::gzip_params compression_parameters;
+    compression_parameters.level = boost::iostreams::zlib::best_speed;
+
+    output.clear();
+    boost::iostreams::filtering_ostream gzip_stream;
+    gzip_stream.push(boost::iostreams::gzip_compressor(compression_parameters));
+    gzip_stream.push(boost::iostreams::back_inserter(output));
+    gzip_stream.write(input.data(), input.size());
+    boost::iostreams::close(gzip_stream);
+}
+
+template <typename Compress>
+void measure(const std::string &name,
+             const std::vector<char> &input,
+             const std::size_t replies,
+             Compress &&compress)
+{
+    std::vector<char> output;
+    const auto cpu_start = std::clock();
+    TIMER_START(compression);
+    for (auto reply : util::irange<std::size_t>(0, replies))
+    {
+        (void)reply;
+        compress(input, output);
+    }
+    TIMER_STOP(compression);
+    const auto cpu_msec = 1000. * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    const auto wall_msec = TIMER_MSEC(compression);
+    const auto megabytes = static_cast<double>(input.size() * replies) / (1024 * 1024);
+    util::Log() << "  " << name << ": " << megabytes / (wall_msec / 1000.) << " MB/s, "
+                << cpu_msec / replies << "ms CPU/reply, ratio "
+                << static_cast<double>(input.size()) / output.size();
+}
+}
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    auto &compressor = server::Compressor::thread_local_instance();
+
+    for (const std::size_t size : {10, 100, 1000})
+    {
+        const auto response = makeTableResponse(size);
+        // keep the total amount of data per measurement roughly the same
+        const std::size_t replies = std::max<std::size_t>(5, (256 << 20) / response.size() / 10);
+        util::Log() << size << "x" << size << " table, " << response.size() << " bytes, "
+                    << replies << " replies";
+
+        measure("gzip, new stream per reply",
+                response,
+                replies,
+                [](const std::vector<char> &input, std::vector<char> &output) {
+                    compressWithNewStream(input, output);
+                });
+        measure("gzip, reused stream",
+                response,
+                replies,
+                [&](const std::vector<char> &input, std::vector<char> &output) {
+                    compressor.compress(input, server::http::gzip_rfc1952, output);
+                });
+        measure("deflate, reused stream",
+                response,
+                replies,
+                [&](const std::vector<char> &input, std::vector<char> &output) {
+                    compressor.compress(input, server::http::deflate_rfc1951, output);
+                });
+#ifdef USE_ZSTD_LIBRARY
+        measure("zstd, reused context",
+                response,
+                replies,
+                [&](const std::vector<char> &input, std::vector<char> &output) {
+                    compressor.compress(input, server::http::zstd, output);
+                });
+#endif
+    }
+}
@@ -0,0 +1,92 @@
+#include "customizer/cell_customizer.hpp"
+#include "customizer/edge_based_graph.hpp"
+
+#include "partition/cell_storage.hpp"
+#include "partition/files.hpp"
+#include "partition/multi_level_partition.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+customizer::CellMetric measure(const std::string &name,
+                               const customizer::MultiLevelEdgeBasedGraph &graph,
+                               const partition::MultiLevelPartition &mlp,
+                               const partition::CellStorage &storage,
+                               const customizer::CustomizationEngine engine)
+{
+    const std::vector<bool> allowed_nodes(graph.GetNumberOfNodes(), true);
+    customizer::CellCustomizer customizer(mlp, engine);
+    auto metric = storage.MakeMetric();
+
+    TIMER_START(customize);
+    customizer.Customize(graph, storage, allowed_nodes, metric);
+    TIMER_STOP(customize);
+    util::Log() << name << ": " << TIMER_MSEC(customize) << "ms";
+
+    return metric;
+}
+}
+
+int main(int argc, char *argv[]) try
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm\n";
+        return EXIT_FAILURE;
+    }
+    util::LogPolicy::GetInstance().Unmute();
+
+    // needs the output of osrm-partition and osrm-customize
+    const boost::filesystem::path base{argv[1]};
+    const auto path = [&base](const std::string &extension) {
+        return boost::filesystem::path{base.string() + extension};
+    };
+
+    partition::MultiLevelPartition mlp;
+    partition::files::readPartition(path(".partition"), mlp);
+    partition::CellStorage storage;
+    partition::files::readCells(path(".cells"), storage);
+    customizer::MultiLevelEdgeBasedGraph graph;
+    partition::files::readGraph(path(".mldgr"), graph);
+
+    for (LevelID level = 1; level < mlp.GetNumberOfLevels(); ++level)
+    {
+        util::Log() << "Level " << static_cast<int>(level) << ": " << mlp.GetNumberOfCells(level)
+                    << " cells";
+    }
+
+    const auto dijkstra_metric =
+        measure("dijkstra", graph, mlp, storage, customizer::CustomizationEngine::Dijkstra);
+    const auto min_plus_metric =
+        measure("min-plus", graph, mlp, storage, customizer::CustomizationEngine::MinPlus);
+
+    const auto different_weights = std::inner_product(dijkstra_metric.weights.begin(),
+                                                      dijkstra_metric.weights.end(),
+                                                      min_plus_metric.weights.begin(),
+                                                      std::size_t{0},
+                                                      std::plus<std::size_t>(),
+                                                      std::not_equal_to<EdgeWeight>());
+    util::Log() << different_weights << " of " << dijkstra_metric.weights.size()
+                << " weights differ";
+
+    return different_weights == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
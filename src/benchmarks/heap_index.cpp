@@ -0,0 +1,143 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdlib>
+
+using namespace osrm;
+
+namespace
+{
+std::vector<util::Coordinate> randomCoordinates(const std::size_t num_coordinates)
+{
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    // Random coordinates in monaco
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> lon_distribution(7.4090, 7.4390);
+    std::uniform_real_distribution<double> lat_distribution(43.7270, 43.7500);
+
+    std::vector<util::Coordinate> coordinates;
+    for (std::size_t i = 0; i < num_coordinates; ++i)
+    {
+        coordinates.push_back(util::Coordinate{FloatLongitude{lon_distribution(generator)},
+                                               FloatLatitude{lat_distribution(generator)}});
+    }
+    return coordinates;
+}
+
+// Search heaps are thread-local and keep the node index they were created with,
+// so every configuration needs to run on a fresh thread.
+bool benchmark(EngineConfig config, const std::string &name)
+{
+    bool success = true;
+    std::thread thread([&] {
+        OSRM osrm{config};
+
+        const auto coordinates = randomCoordinates(1000);
+
+        TIMER_START(routes);
+        for (std::size_t i = 0; i + 1 < coordinates.size(); ++i)
+        {
+            RouteParameters params;
+            params.overview = RouteParameters::OverviewType::False;
+            params.coordinates = {coordinates[i], coordinates[i + 1]};
+
+            json::Object result;
+            if (osrm.Route(params, result) != Status::Ok &&
+                result.values.at("code").get<json::String>().value != "NoRoute")
+            {
+                success = false;
+                return;
+            }
+        }
+        TIMER_STOP(routes);
+
+        TableParameters params;
+        params.coordinates.assign(coordinates.begin(), coordinates.begin() + 100);
+
+        TIMER_START(tables);
+        const auto NUM = 10;
+        for (int i = 0; i < NUM; ++i)
+        {
+            json::Object result;
+            if (osrm.Table(params, result) != Status::Ok)
+            {
+                success = false;
+                return;
+            }
+        }
+        TIMER_STOP(tables);
+
+        std::cout << name << ": " << (TIMER_MSEC(routes) / (coordinates.size() - 1))
+                  << "ms/route, " << (TIMER_MSEC(tables) / NUM) << "ms/100x100 table"
+                  << std::endl;
+    });
+    thread.join();
+    return success;
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD]\n";
+        return EXIT_FAILURE;
+    }
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    config.max_heap_index_memory = 0;
+    if (!benchmark(config, algorithm + " hash map index"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    config.max_heap_index_memory = 1024;
+    if (!benchmark(config, algorithm + " generation array index"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
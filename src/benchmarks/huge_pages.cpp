@@ -0,0 +1,141 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+namespace
+{
+using namespace osrm;
+
+// Routes between random coordinates, the same for both runs
+std::vector<RouteParameters> makeQueries(const std::size_t num_queries)
+{
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    // Random routes in monaco
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> lon_distribution(7.4090, 7.4390);
+    std::uniform_real_distribution<double> lat_distribution(43.7270, 43.7500);
+
+    std::vector<RouteParameters> queries(num_queries);
+    for (auto &params : queries)
+    {
+        params.overview = RouteParameters::OverviewType::False;
+        for (auto i = 0; i < 2; ++i)
+        {
+            params.coordinates.push_back(
+                FloatCoordinate{FloatLongitude{lon_distribution(generator)},
+                                FloatLatitude{lat_distribution(generator)}});
+        }
+    }
+    return queries;
+}
+
+// Returns the sorted latencies of all queries in microseconds
+std::vector<double> measure(EngineConfig config, const std::vector<RouteParameters> &queries)
+{
+    OSRM osrm{config};
+
+    std::vector<double> latencies;
+    latencies.reserve(queries.size());
+    for (const auto &params : queries)
+    {
+        json::Object result;
+        TIMER_START(route);
+        const auto rc = osrm.Route(params, result);
+        TIMER_STOP(route);
+        if (rc != Status::Ok && result.values.at("code").get<json::String>().value != "NoRoute")
+        {
+            throw std::runtime_error("Route failed: " +
+                                     result.values.at("code").get<json::String>().value);
+        }
+        latencies.push_back(TIMER_USEC(route));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+double percentile(const std::vector<double> &sorted_latencies, const double p)
+{
+    const auto index = static_cast<std::size_t>(p * (sorted_latencies.size() - 1));
+    return sorted_latencies[index];
+}
+
+void report(const std::string &name, const std::vector<double> &latencies)
+{
+    double sum = 0;
+    for (const auto latency : latencies)
+        sum += latency;
+    std::cout << name << ": mean " << sum / latencies.size() << "us, p50 "
+              << percentile(latencies, 0.5) << "us, p99 " << percentile(latencies, 0.99) << "us"
+              << std::endl;
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD] [number of routes]\n";
+        return EXIT_FAILURE;
+    }
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto num_routes = argc > 3 ? std::stoul(argv[3]) : 10000;
+    const auto queries = makeQueries(num_routes);
+
+    // the datasets are loaded one after the other, only one is held in memory at a time
+    config.use_huge_pages = false;
+    const auto normal_latencies = measure(config, queries);
+    config.use_huge_pages = true;
+    const auto huge_latencies = measure(config, queries);
+
+    report(algorithm + ", 4K pages", normal_latencies);
+    report(algorithm + ", huge pages", huge_latencies);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
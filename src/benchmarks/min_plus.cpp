@@ -0,0 +1,103 @@
+#include "util/log.hpp"
+#include "util/min_plus.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+// Rows of a cell weight matrix, a share of the entries is unreachable
+std::vector<EdgeWeight>
+makeRows(const std::size_t num_rows, const std::size_t row_length, const int invalid_percent)
+{
+    std::mt19937 g(1337);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 1000);
+    std::uniform_int_distribution<int> percent_distribution(0, 99);
+
+    std::vector<EdgeWeight> rows(num_rows * row_length);
+    for (auto &weight : rows)
+    {
+        weight = percent_distribution(g) < invalid_percent ? INVALID_EDGE_WEIGHT
+                                                           : weight_distribution(g);
+    }
+    return rows;
+}
+
+template <typename RelaxRow>
+void measure(const std::string &name,
+             const std::vector<EdgeWeight> &rows,
+             const std::size_t row_length,
+             RelaxRow relax_row)
+{
+    // stands in for the heap of a search, the destinations of a row are scattered over it
+    std::vector<EdgeWeight> keys(1 << 16, INVALID_EDGE_WEIGHT);
+    TIMER_START(relax);
+    for (std::size_t repetition = 0; repetition < 10; ++repetition)
+    {
+        for (std::size_t offset = 0; offset < rows.size(); offset += row_length)
+        {
+            relax_row(rows.data() + offset, keys, static_cast<EdgeWeight>(offset % 100));
+        }
+    }
+    TIMER_STOP(relax);
+
+    EdgeWeight checksum = 0;
+    for (const auto key : keys)
+        checksum += key == INVALID_EDGE_WEIGHT ? 0 : key;
+    util::Log() << name << ": " << TIMER_MSEC(relax) << "ms (checksum " << checksum << ")";
+}
+}
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const std::size_t num_values = 1 << 24;
+    for (const std::size_t row_length : {8, 32, 128})
+    {
+        for (const int invalid_percent : {0, 50, 90})
+        {
+            util::Log() << "rows of " << row_length << " weights, " << invalid_percent
+                        << "% invalid";
+            const auto rows = makeRows(num_values / row_length, row_length, invalid_percent);
+            std::vector<std::uint32_t> destinations(row_length);
+            std::mt19937 g(42);
+            std::uniform_int_distribution<std::uint32_t> key_distribution(0, (1 << 16) - 1);
+            for (auto &destination : destinations)
+                destination = key_distribution(g);
+
+            measure("scalar",
+                    rows,
+                    row_length,
+                    [&](const EdgeWeight *row, auto &keys, const EdgeWeight weight) {
+                        for (std::size_t index = 0; index < row_length; ++index)
+                        {
+                            if (row[index] != INVALID_EDGE_WEIGHT)
+                            {
+                                const auto to_weight = weight + row[index];
+                                auto &key = keys[destinations[index]];
+                                if (to_weight < key)
+                                    key = to_weight;
+                            }
+                        }
+                    });
+            measure("vectorized",
+                    rows,
+                    row_length,
+                    [&](const EdgeWeight *row, auto &keys, const EdgeWeight weight) {
+                        util::forEachValidWeight(row, row_length, [&](const std::size_t index) {
+                            const auto to_weight = weight + row[index];
+                            auto &key = keys[destinations[index]];
+                            if (to_weight < key)
+                                key = to_weight;
+                        });
+                    });
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#include "util/query_heap.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+struct HeapData
+{
+    NodeID parent;
+};
+
+// Random graph with a grid backbone so that every node is reachable
+struct Graph
+{
+    std::vector<std::size_t> offsets;
+    std::vector<NodeID> targets;
+    std::vector<EdgeWeight> weights;
+};
+
+Graph makeGraph(const std::size_t width, const std::size_t height)
+{
+    std::mt19937 g(1337);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 100);
+    std::uniform_int_distribution<std::size_t> node_distribution(0, width * height - 1);
+
+    Graph graph;
+    graph.offsets.push_back(0);
+    for (auto y : util::irange<std::size_t>(0, height))
+    {
+        for (auto x : util::irange<std::size_t>(0, width))
+        {
+            const auto add_edge = [&](const std::size_t target) {
+                graph.targets.push_back(static_cast<NodeID>(target));
+                graph.weights.push_back(weight_distribution(g));
+            };
+            if (x > 0)
+                add_edge(y * width + x - 1);
+            if (x + 1 < width)
+                add_edge(y * width + x + 1);
+            if (y > 0)
+                add_edge((y - 1) * width + x);
+            if (y + 1 < height)
+                add_edge((y + 1) * width + x);
+            // shortcut-like long range edge
+            add_edge(node_distribution(g));
+            graph.offsets.push_back(graph.targets.size());
+        }
+    }
+    return graph;
+}
+
+template <typename Heap>
+EdgeWeight dijkstra(const Graph &graph, Heap &heap, const NodeID source, const std::size_t limit)
+{
+    heap.Clear();
+    heap.Insert(source, 0, {source});
+
+    EdgeWeight weight = 0;
+    std::size_t settled = 0;
+    while (!heap.Empty() && settled++ < limit)
+    {
+        const auto node = heap.DeleteMin();
+        weight = heap.GetKey(node);
+        for (auto edge : util::irange(graph.offsets[node], graph.offsets[node + 1]))
+        {
+            const auto to = graph.targets[edge];
+            const auto to_weight = weight + graph.weights[edge];
+            if (!heap.WasInserted(to))
+            {
+                heap.Insert(to, to_weight, {node});
+            }
+            else if (!heap.WasRemoved(to) && to_weight < heap.GetKey(to))
+            {
+                heap.GetData(to) = {node};
+                heap.DecreaseKey(to, to_weight);
+            }
+        }
+    }
+    return weight;
+}
+
+template <typename Heap>
+void measure(const std::string &name,
+             const Graph &graph,
+             Heap &heap,
+             const std::vector<NodeID> &sources,
+             const std::size_t limit)
+{
+    EdgeWeight checksum = 0;
+    TIMER_START(search);
+    for (const auto source : sources)
+    {
+        checksum += dijkstra(graph, heap, source, limit);
+    }
+    TIMER_STOP(search);
+    util::Log() << name << ": " << TIMER_MSEC(search) / sources.size()
+                << "ms/search (checksum " << checksum << ")";
+}
+}
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const std::size_t width = 1000;
+    const std::size_t height = 1000;
+    const std::size_t num_nodes = width * height;
+    const auto graph = makeGraph(width, height);
+
+    std::mt19937 g(42);
+    std::uniform_int_distribution<NodeID> node_distribution(0, num_nodes - 1);
+    std::vector<NodeID> sources(100);
+    std::generate(sources.begin(), sources.end(), [&] { return node_distribution(g); });
+
+    for (const std::size_t limit : {1000, 100000})
+    {
+        util::Log() << "settling " << limit << " nodes per search";
+        {
+            util::QueryHeap<NodeID,
+                            NodeID,
+                            EdgeWeight,
+                            HeapData,
+                            util::ArrayStorage<NodeID, NodeID>>
+                heap(num_nodes);
+            measure("array storage", graph, heap, sources, limit);
+        }
+        {
+            util::QueryHeap<NodeID,
+                            NodeID,
+                            EdgeWeight,
+                            HeapData,
+                            util::UnorderedMapStorage<NodeID, int>>
+                heap(num_nodes);
+            measure("unordered map storage", graph, heap, sources, limit);
+        }
+        {
+            util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::AdaptiveStorage<NodeID, int>>
+                heap(num_nodes, num_nodes * util::AdaptiveStorage<NodeID, int>::ARRAY_BYTES_PER_NODE);
+            measure("generation array storage", graph, heap, sources, limit);
+        }
+    }
+}
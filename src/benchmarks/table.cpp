@@ -0,0 +1,127 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <boost/assert.hpp>
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD] [number of coordinates]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto num_coordinates = argc > 3 ? std::stoul(argv[3]) : 250;
+
+    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
+    OSRM osrm{config};
+
+    // Random square table in monaco
+    TableParameters params;
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> lon_distribution(7.4090, 7.4390);
+    std::uniform_real_distribution<double> lat_distribution(43.7270, 43.7500);
+    for (std::size_t i = 0; i < num_coordinates; ++i)
+    {
+        params.coordinates.push_back(
+            FloatCoordinate{FloatLongitude{lon_distribution(generator)},
+                            FloatLatitude{lat_distribution(generator)}});
+    }
+
+    TIMER_START(tables);
+    auto NUM = 10;
+    for (int i = 0; i < NUM; ++i)
+    {
+        json::Object result;
+        const auto rc = osrm.Table(params, result);
+        if (rc != Status::Ok ||
+            result.values.at("durations").get<json::Array>().values.size() != num_coordinates)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    TIMER_STOP(tables);
+    std::cout << algorithm << ": " << (TIMER_MSEC(tables) / NUM) << "ms/req at "
+              << num_coordinates << "x" << num_coordinates << " table" << std::endl;
+    std::cout << algorithm << ": "
+              << (TIMER_MSEC(tables) / NUM / (num_coordinates * num_coordinates) * 1000)
+              << "us/entry" << std::endl;
+
+    // Rendering a json::Object tree (library users) vs. streaming with json::Writer (osrm-routed)
+    TIMER_START(render_tree);
+    for (int i = 0; i < NUM; ++i)
+    {
+        json::Object result;
+        std::vector<char> buffer;
+        osrm.Table(params, result);
+        json::render(buffer, result);
+    }
+    TIMER_STOP(render_tree);
+
+    TIMER_START(render_writer);
+    for (int i = 0; i < NUM; ++i)
+    {
+        std::vector<char> buffer;
+        json::Writer writer(buffer);
+        if (osrm.Table(params, writer) != Status::Ok)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    TIMER_STOP(render_writer);
+    std::cout << algorithm << ": " << (TIMER_MSEC(render_tree) / NUM)
+              << "ms/req rendered from json::Object, " << (TIMER_MSEC(render_writer) / NUM)
+              << "ms/req with json::Writer" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -14,9 +14,14 @@
 
 #include "updater/updater.hpp"
 
+#include "util/exception.hpp"
 #include "util/log.hpp"
 #include "util/timing_util.hpp"
 
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+
 namespace osrm
 {
 namespace customizer
@@ -131,6 +136,101 @@ std::vector<CellMetric> customizeFilteredMetrics(const MultiLevelEdgeBasedGraph
 
     return metrics;
 }
+
+// Reads the graph and the cell metrics written by the last run. They can only be reused if they
+// are newer than the partition they were computed for and have a metric per exclude filter.
+bool readPreviousCustomization(const CustomizationConfig &config,
+                               const partition::CellStorage &storage,
+                               const std::size_t num_metrics,
+                               MultiLevelEdgeBasedGraph &previous_graph,
+                               std::vector<CellMetric> &previous_metrics)
+{
+    const auto graph_path = config.GetPath(".osrm.mldgr");
+    const auto metrics_path = config.GetPath(".osrm.cell_metrics");
+    if (!boost::filesystem::exists(graph_path) || !boost::filesystem::exists(metrics_path))
+    {
+        util::Log() << "No previous customization found";
+        return false;
+    }
+
+    const auto previous_time = std::min(boost::filesystem::last_write_time(graph_path),
+                                        boost::filesystem::last_write_time(metrics_path));
+    for (const auto &extension : {".osrm.partition", ".osrm.cells"})
+    {
+        if (boost::filesystem::last_write_time(config.GetPath(extension)) > previous_time)
+        {
+            util::Log() << "Previous customization is older than " << config.GetPath(extension);
+            return false;
+        }
+    }
+
+    try
+    {
+        partition::files::readGraph(graph_path, previous_graph);
+        files::readCellMetrics(metrics_path, previous_metrics);
+    }
+    catch (const util::exception &exception)
+    {
+        util::Log(logWARNING) << "Could not read the previous customization: "
+                              << exception.what();
+        return false;
+    }
+
+    const auto metric_size = storage.MakeMetric().weights.size();
+    const auto fits_storage = [metric_size](const CellMetric &metric) {
+        return metric.weights.size() == metric_size && metric.durations.size() == metric_size;
+    };
+    if (previous_metrics.size() != num_metrics ||
+        !std::all_of(previous_metrics.begin(), previous_metrics.end(), fits_storage))
+    {
+        util::Log() << "Previous customization does not match the cells";
+        return false;
+    }
+
+    return true;
+}
+
+// Updates the metrics of the last run in place of customizing all cells, only the cells that
+// read a changed edge and their parents (if their values changed in turn) are customized again.
+bool customizeChangedMetrics(const CustomizationConfig &config,
+                             const MultiLevelEdgeBasedGraph &graph,
+                             const partition::CellStorage &storage,
+                             const CellCustomizer &customizer,
+                             const std::vector<std::vector<bool>> &node_filters,
+                             std::vector<CellMetric> &metrics)
+{
+    MultiLevelEdgeBasedGraph previous_graph;
+    if (!readPreviousCustomization(config, storage, node_filters.size(), previous_graph, metrics))
+    {
+        return false;
+    }
+
+    const auto changed_cells = customizer.FindChangedCells(graph, previous_graph);
+    if (!changed_cells)
+    {
+        util::Log() << "The edges of the graph differ from the previous customization";
+        return false;
+    }
+
+    std::size_t num_cells = 0;
+    std::size_t num_changed_cells = 0;
+    for (const auto &level_cells : *changed_cells)
+    {
+        num_cells += level_cells.size();
+        num_changed_cells += std::count(level_cells.begin(), level_cells.end(), true);
+    }
+    util::Log() << num_changed_cells << " of " << num_cells << " cells read changed edges";
+
+    for (const auto index : util::irange<std::size_t>(0, metrics.size()))
+    {
+        const auto num_customized = customizer.CustomizeChanged(
+            graph, storage, node_filters[index], metrics[index], *changed_cells);
+        util::Log() << "Customized " << num_customized << " of " << num_cells
+                    << " cells for metric " << index;
+    }
+
+    return true;
+}
 }
 
 int Customizer::Run(const CustomizationConfig &config)
@@ -158,7 +258,13 @@ int Customizer::Run(const CustomizationConfig &config)
 
     TIMER_START(cell_customize);
     auto filter = excludeFlagsToNodeFilter(graph, node_data, properties);
-    auto metrics = customizeFilteredMetrics(graph, storage, CellCustomizer{mlp}, filter);
+    const CellCustomizer customizer{mlp, config.engine};
+    std::vector<CellMetric> metrics;
+    if (!config.incremental ||
+        !customizeChangedMetrics(config, graph, storage, customizer, filter, metrics))
+    {
+        metrics = customizeFilteredMetrics(graph, storage, customizer, filter);
+    }
     TIMER_STOP(cell_customize);
     util::Log() << "Cells customization took " << TIMER_SEC(cell_customize) << " seconds";
 
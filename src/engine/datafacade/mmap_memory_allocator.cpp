@@ -0,0 +1,163 @@
+#include "engine/datafacade/mmap_memory_allocator.hpp"
+#include "storage/storage.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
+#include "util/log.hpp"
+
+#include "boost/assert.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+namespace
+{
+// Precedes the data layout in the memory image
+struct MemoryImageHeader
+{
+    util::FingerPrint fingerprint;
+    std::uint64_t memory_size;
+};
+
+const constexpr std::size_t LAYOUT_OFFSET = sizeof(MemoryImageHeader);
+const constexpr std::size_t MEMORY_OFFSET = LAYOUT_OFFSET + sizeof(storage::DataLayout);
+
+bool isImageUpToDate(const storage::StorageConfig &config, const boost::filesystem::path &image)
+{
+    if (!boost::filesystem::is_regular_file(image) ||
+        boost::filesystem::file_size(image) < MEMORY_OFFSET)
+    {
+        return false;
+    }
+
+    const auto image_time = boost::filesystem::last_write_time(image);
+    for (const auto &path : config.GetExistingInputPaths())
+    {
+        if (boost::filesystem::last_write_time(path) > image_time)
+        {
+            util::Log() << "Memory image " << image << " is older than " << path;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool isImageCompatible(const boost::iostreams::mapped_file_source &image)
+{
+    if (image.size() < MEMORY_OFFSET)
+    {
+        return false;
+    }
+
+    MemoryImageHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    const auto valid_fingerprint = util::FingerPrint::GetValid();
+    // the data layout can change with every version, the fingerprint has to match exactly
+    if (std::memcmp(&header.fingerprint, &valid_fingerprint, sizeof(util::FingerPrint)) != 0)
+    {
+        return false;
+    }
+
+    return image.size() == MEMORY_OFFSET + header.memory_size;
+}
+
+// Returns false if the image can't be written, e.g. to a read-only directory
+bool writeImage(const storage::StorageConfig &config, const boost::filesystem::path &image)
+{
+    storage::Storage storage(config);
+    storage::DataLayout layout;
+    storage.PopulateLayout(layout);
+
+    const MemoryImageHeader header{util::FingerPrint::GetValid(), layout.GetSizeOfLayout()};
+
+    // Processes starting concurrently must never map a partially written image,
+    // it is moved into place only when it is complete.
+    const auto temporary_image =
+        image.parent_path() /
+        boost::filesystem::unique_path(image.filename().string() + ".%%%%-%%%%-%%%%");
+    try
+    {
+        boost::iostreams::mapped_file_params parameters(temporary_image.string());
+        parameters.flags = boost::iostreams::mapped_file::readwrite;
+        parameters.new_file_size = MEMORY_OFFSET + header.memory_size;
+        boost::iostreams::mapped_file mapped_image(parameters);
+
+        std::memcpy(mapped_image.data(), &header, sizeof(header));
+        std::memcpy(mapped_image.data() + LAYOUT_OFFSET, &layout, sizeof(layout));
+        storage.PopulateData(layout, mapped_image.data() + MEMORY_OFFSET);
+        mapped_image.close();
+
+        boost::filesystem::rename(temporary_image, image);
+    }
+    catch (const std::exception &exc)
+    {
+        boost::system::error_code ignored;
+        boost::filesystem::remove(temporary_image, ignored);
+        util::Log(logWARNING) << "Writing memory image " << image << " failed: " << exc.what();
+        return false;
+    }
+    return true;
+}
+}
+
+MMapMemoryAllocator::MMapMemoryAllocator(const storage::StorageConfig &config,
+                                         const boost::filesystem::path &image_path)
+{
+    const auto image = image_path.empty() ? config.GetPath(".osrm.memory") : image_path;
+
+    if (isImageUpToDate(config, image))
+    {
+        mapped_image.open(image.string());
+    }
+
+    if (!mapped_image.is_open() || !isImageCompatible(mapped_image))
+    {
+        mapped_image.close();
+
+        util::Log() << "Writing memory image " << image;
+        if (!writeImage(config, image))
+        {
+            util::Log(logWARNING) << "Loading the data into process memory instead";
+            fallback_allocator = std::make_unique<ProcessMemoryAllocator>(config, false);
+            layout = &fallback_allocator->GetLayout();
+            memory = fallback_allocator->GetMemory();
+            return;
+        }
+        mapped_image.open(image.string());
+
+        if (!isImageCompatible(mapped_image))
+        {
+            throw util::exception("Memory image " + image.string() + " is corrupted" +
+                                  SOURCE_REF);
+        }
+    }
+
+    util::Log() << "Mapped memory image " << image << " (" << mapped_image.size() << " bytes)";
+
+    // the facades only read from the memory block, a read-only mapping is enough
+    layout = reinterpret_cast<storage::DataLayout *>(const_cast<char *>(mapped_image.data()) +
+                                                     LAYOUT_OFFSET);
+    memory = const_cast<char *>(mapped_image.data()) + MEMORY_OFFSET;
+}
+
+MMapMemoryAllocator::~MMapMemoryAllocator() {}
+
+storage::DataLayout &MMapMemoryAllocator::GetLayout() { return *layout; }
+char *MMapMemoryAllocator::GetMemory() { return memory; }
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
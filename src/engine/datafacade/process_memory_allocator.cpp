@@ -1,5 +1,8 @@
 #include "engine/datafacade/process_memory_allocator.hpp"
 #include "storage/storage.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
 
 #include "boost/assert.hpp"
 
@@ -10,7 +13,8 @@ namespace engine
 namespace datafacade
 {
 
-ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config)
+ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                               const bool use_huge_pages)
 {
     storage::Storage storage(config);
 
@@ -19,14 +23,46 @@ ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &con
     storage.PopulateLayout(*internal_layout);
 
     // Allocate the memory block, then load data from files into it
-    internal_memory = std::make_unique<char[]>(internal_layout->GetSizeOfLayout());
-    storage.PopulateData(*internal_layout, internal_memory.get());
+    internal_memory = std::make_unique<util::ProcessMemory>(internal_layout->GetSizeOfLayout(),
+                                                            use_huge_pages);
+    storage.PopulateData(*internal_layout, internal_memory->get());
+}
+
+ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                               const bool use_huge_pages,
+                                               std::shared_ptr<ContiguousBlockAllocator> base)
+    : base_allocator(std::move(base))
+{
+    storage::Storage storage(config);
+
+    // Only the metric blocks are sized, all other blocks are read from the base
+    internal_layout = std::make_unique<storage::DataLayout>();
+    storage.PopulateLayout(*internal_layout);
+    internal_layout->base_layout = &base_allocator->GetLayout();
+    internal_layout->base_memory = base_allocator->GetMemory();
+
+    const auto mismatch = storage.FindBaseMismatch(
+        *internal_layout, base_allocator->GetLayout(), base_allocator->GetMemory());
+    if (mismatch != storage::DataLayout::NUM_BLOCKS)
+    {
+        throw util::exception("Block " + std::string(storage::block_id_to_name[mismatch]) +
+                              " of " + config.base_path.string() +
+                              " differs from the base dataset, metrics have to share its "
+                              "extracted and partitioned data" +
+                              SOURCE_REF);
+    }
+
+    internal_memory = std::make_unique<util::ProcessMemory>(internal_layout->GetSizeOfLayout(),
+                                                            use_huge_pages);
+    storage.PopulateUpdatableData(*internal_layout, internal_memory->get());
+    util::Log() << "Loaded metric " << config.base_path << " with "
+                << internal_layout->GetSizeOfLayout() << " bytes of metric data";
 }
 
 ProcessMemoryAllocator::~ProcessMemoryAllocator() {}
 
 storage::DataLayout &ProcessMemoryAllocator::GetLayout() { return *internal_layout.get(); }
-char *ProcessMemoryAllocator::GetMemory() { return internal_memory.get(); }
+char *ProcessMemoryAllocator::GetMemory() { return internal_memory->get(); }
 
 } // namespace datafacade
 } // namespace engine
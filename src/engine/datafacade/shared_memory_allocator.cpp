@@ -1,4 +1,6 @@
 #include "engine/datafacade/shared_memory_allocator.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/log.hpp"
 
 #include "boost/assert.hpp"
@@ -16,14 +18,30 @@ SharedMemoryAllocator::SharedMemoryAllocator(storage::SharedDataType data_region
 
     BOOST_ASSERT(storage::SharedMemory::RegionExists(data_region));
     m_large_memory = storage::makeSharedMemory(data_region);
+
+    m_layout = *reinterpret_cast<storage::DataLayout *>(m_large_memory->Ptr());
+    if (m_layout.base_region != storage::REGION_NONE)
+    {
+        util::Log(logDEBUG) << "Sharing static data of region "
+                            << regionToString(m_layout.base_region);
+
+        if (!storage::SharedMemory::RegionExists(m_layout.base_region))
+        {
+            throw util::exception("Base region " + regionToString(m_layout.base_region) +
+                                  " of " + regionToString(data_region) + " does not exist" +
+                                  SOURCE_REF);
+        }
+        m_base_memory = storage::makeSharedMemory(m_layout.base_region);
+
+        auto base_ptr = static_cast<char *>(m_base_memory->Ptr());
+        m_layout.base_layout = reinterpret_cast<const storage::DataLayout *>(base_ptr);
+        m_layout.base_memory = base_ptr + sizeof(storage::DataLayout);
+    }
 }
 
 SharedMemoryAllocator::~SharedMemoryAllocator() {}
 
-storage::DataLayout &SharedMemoryAllocator::GetLayout()
-{
-    return *reinterpret_cast<storage::DataLayout *>(m_large_memory->Ptr());
-}
+storage::DataLayout &SharedMemoryAllocator::GetLayout() { return m_layout; }
 char *SharedMemoryAllocator::GetMemory()
 {
     return reinterpret_cast<char *>(m_large_memory->Ptr()) + sizeof(storage::DataLayout);
@@ -1,5 +1,7 @@
 #include "engine/engine_config.hpp"
 
+#include <algorithm>
+
 namespace osrm
 {
 namespace engine
@@ -20,9 +22,28 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
                               unlimited_or_more_than(max_results_nearest, 0) &&
-                              max_alternatives >= 0;
+                              max_alternatives >= 0 && max_alternative_threads >= 1 &&
+                              max_table_threads >= 1 &&
+                              (max_table_memory == -1 || max_table_memory > 0) &&
+                              max_match_threads >= 1 && max_trip_threads >= 1 &&
+                              max_heap_index_memory >= 0 && max_tile_cache_memory >= 0 &&
+                              max_result_cache_memory >= 0;
+
+    // memory images are only written for datasets loaded from files, huge pages only back
+    // process memory
+    const bool memory_valid =
+        !(use_shared_memory && use_mmap) && !(use_huge_pages && (use_shared_memory || use_mmap));
+
+    // metrics share the static data loaded into process memory
+    const bool metrics_valid =
+        metrics.empty() ||
+        (!use_shared_memory &&
+         std::all_of(metrics.begin(), metrics.end(), [](const auto &name_and_config) {
+             return !name_and_config.first.empty() && name_and_config.second.IsValid();
+         }));
 
-    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) && limits_valid;
+    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) &&
+           limits_valid && memory_valid && metrics_valid;
 }
 }
 }
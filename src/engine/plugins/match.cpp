@@ -9,15 +9,25 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
+#include "util/lru_cache.hpp"
+#include "util/std_hash.hpp"
 #include "util/string_util.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <cstdint>
 #include <cstdlib>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace osrm
@@ -109,9 +119,35 @@ void filterCandidates(const std::vector<util::Coordinate> &coordinates,
     }
 }
 
-Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
-                                  const api::MatchParameters &parameters,
-                                  util::json::Object &json_result) const
+namespace
+{
+// Candidate lookup as {longitude, latitude, radius, bearing, bearing range, approach},
+// a bearing of -1 looks up candidates without a bearing
+using CandidateQuery =
+    std::tuple<std::int32_t, std::int32_t, double, short, short, std::uint8_t>;
+
+struct CandidateQueryHash
+{
+    std::size_t operator()(const CandidateQuery &query) const
+    {
+        return hash_val(std::get<0>(query),
+                        std::get<1>(query),
+                        std::get<2>(query),
+                        std::get<3>(query),
+                        std::get<4>(query),
+                        std::get<5>(query));
+    }
+};
+
+using CandidateCache =
+    util::LRUCache<CandidateQuery, std::vector<PhantomNodeWithDistance>, CandidateQueryHash>;
+}
+
+template <typename ResultT, typename GetCandidates>
+Status MatchPlugin::MatchTrace(const RoutingAlgorithmsInterface &algorithms,
+                               const api::MatchParameters &parameters,
+                               GetCandidates &&get_candidates,
+                               ResultT &json_result) const
 {
     if (!algorithms.HasMapMatching())
     {
@@ -191,7 +227,7 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                        });
     }
 
-    auto candidates_lists = GetPhantomNodesInRange(facade, tidied.parameters, search_radiuses);
+    auto candidates_lists = get_candidates(facade, tidied.parameters, search_radiuses);
 
     filterCandidates(tidied.parameters.coordinates, candidates_lists);
     if (std::all_of(candidates_lists.begin(),
@@ -247,6 +283,171 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     return Status::Ok;
 }
+
+template <typename ResultT>
+Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                                  const api::MatchParameters &parameters,
+                                  ResultT &json_result) const
+{
+    return MatchTrace(algorithms,
+                      parameters,
+                      [this](const datafacade::BaseDataFacade &facade,
+                             const api::MatchParameters &trace,
+                             const std::vector<double> &search_radiuses) {
+                          return GetPhantomNodesInRange(facade, trace, search_radiuses);
+                      },
+                      json_result);
+}
+
+Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                                  const std::vector<api::MatchParameters> &parameters,
+                                  const BatchCallback &callback) const
+{
+    // Traces of a batch often share coordinates, e.g. of vehicles waiting at the same spot or
+    // of traces that are sent again, their candidates are only looked up once. The cache is
+    // bounded, large batches evict the least recently used candidates.
+    CandidateCache candidate_cache(CANDIDATE_CACHE_SIZE);
+    const auto get_candidates = [&candidate_cache](const datafacade::BaseDataFacade &facade,
+                                                   const api::MatchParameters &trace,
+                                                   const std::vector<double> &search_radiuses) {
+        CandidateLists candidates_lists(trace.coordinates.size());
+        BOOST_ASSERT(search_radiuses.size() == trace.coordinates.size());
+
+        const bool use_hints = !trace.hints.empty();
+        const bool use_bearings = !trace.bearings.empty();
+        const bool use_approaches = !trace.approaches.empty();
+
+        for (const auto i : util::irange<std::size_t>(0UL, trace.coordinates.size()))
+        {
+            const auto &coordinate = trace.coordinates[i];
+            if (use_hints && trace.hints[i] && trace.hints[i]->IsValid(coordinate, facade))
+            {
+                candidates_lists[i].push_back(PhantomNodeWithDistance{
+                    trace.hints[i]->phantom,
+                    util::coordinate_calculation::haversineDistance(
+                        coordinate, trace.hints[i]->phantom.location),
+                });
+                continue;
+            }
+
+            Approach approach = engine::Approach::UNRESTRICTED;
+            if (use_approaches && trace.approaches[i])
+                approach = trace.approaches[i].get();
+
+            const bool use_bearing = use_bearings && trace.bearings[i];
+            const CandidateQuery query{static_cast<std::int32_t>(coordinate.lon),
+                                       static_cast<std::int32_t>(coordinate.lat),
+                                       search_radiuses[i],
+                                       use_bearing ? trace.bearings[i]->bearing : -1,
+                                       use_bearing ? trace.bearings[i]->range : -1,
+                                       static_cast<std::uint8_t>(approach)};
+
+            if (candidate_cache.Get(query, candidates_lists[i]))
+            {
+                continue;
+            }
+
+            if (use_bearing)
+            {
+                candidates_lists[i] =
+                    facade.NearestPhantomNodesInRange(coordinate,
+                                                      search_radiuses[i],
+                                                      trace.bearings[i]->bearing,
+                                                      trace.bearings[i]->range,
+                                                      approach);
+            }
+            else
+            {
+                candidates_lists[i] =
+                    facade.NearestPhantomNodesInRange(coordinate, search_radiuses[i], approach);
+            }
+            // another thread might have inserted the same candidates in the meantime
+            candidate_cache.Put(query,
+                                candidates_lists[i],
+                                sizeof(CandidateQuery) +
+                                    candidates_lists[i].size() * sizeof(PhantomNodeWithDistance));
+        }
+
+        return candidates_lists;
+    };
+
+    // the order of the exclude classes does not matter
+    const auto get_exclude_classes = [](const api::MatchParameters &trace_parameters) {
+        auto exclude = trace_parameters.exclude;
+        std::sort(exclude.begin(), exclude.end());
+        exclude.erase(std::unique(exclude.begin(), exclude.end()), exclude.end());
+        return exclude;
+    };
+    const auto exclude_classes = get_exclude_classes(parameters.front());
+
+    std::mutex callback_mutex;
+    std::atomic<bool> all_matched{true};
+    const auto match_trace = [&](const std::size_t index) {
+        util::json::Object json_result;
+        Status status;
+        // all traces are matched on the dataset selected by the first one
+        if (parameters[index].metric != parameters.front().metric)
+        {
+            status = Error(
+                "InvalidValue", "All traces of a batch need the same metric.", json_result);
+        }
+        else if (get_exclude_classes(parameters[index]) != exclude_classes)
+        {
+            status = Error("InvalidValue",
+                           "All traces of a batch need the same exclude classes.",
+                           json_result);
+        }
+        else
+        {
+            status = MatchTrace(algorithms, parameters[index], get_candidates, json_result);
+        }
+
+        if (status != Status::Ok)
+        {
+            all_matched = false;
+        }
+
+        std::lock_guard<std::mutex> lock(callback_mutex);
+        callback(index, status, json_result);
+    };
+
+    const auto number_of_threads = std::min(max_match_threads, parameters.size());
+    if (number_of_threads <= 1)
+    {
+        for (const auto index : util::irange<std::size_t>(0UL, parameters.size()))
+        {
+            match_trace(index);
+        }
+    }
+    else
+    {
+        // Every thread uses its own thread local search heaps
+        tbb::task_arena arena(static_cast<int>(number_of_threads));
+        arena.execute([&] {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, parameters.size(), 1),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto index = range.begin(), end = range.end();
+                                       index != end;
+                                       ++index)
+                                  {
+                                      match_trace(index);
+                                  }
+                              });
+        });
+    }
+
+    return all_matched ? Status::Ok : Status::Error;
+}
+
+template Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::MatchParameters &,
+                                           util::json::Object &) const;
+template Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::MatchParameters &,
+                                           api::BinaryWriter &) const;
+template Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::MatchParameters &,
+                                           util::json::Writer &) const;
 }
 }
 }
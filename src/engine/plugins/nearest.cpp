@@ -19,9 +19,10 @@ namespace plugins
 
 NearestPlugin::NearestPlugin(const int max_results_) : max_results{max_results_} {}
 
+template <typename ResultT>
 Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                     const api::NearestParameters &params,
-                                    util::json::Object &json_result) const
+                                    ResultT &json_result) const
 {
     BOOST_ASSERT(params.IsValid());
 
@@ -60,6 +61,13 @@ Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms
 
     return Status::Ok;
 }
+
+template Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                             const api::NearestParameters &,
+                                             util::json::Object &) const;
+template Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                             const api::NearestParameters &,
+                                             api::BinaryWriter &) const;
 }
 }
 }
@@ -23,14 +23,24 @@ namespace engine
 namespace plugins
 {
 
-TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : max_locations_distance_table(max_locations_distance_table)
+TablePlugin::TablePlugin(const int max_locations_distance_table,
+                         const int max_table_threads,
+                         const int max_table_memory,
+                         const ResultCache &result_cache)
+    : max_locations_distance_table(max_locations_distance_table), result_cache(result_cache)
 {
+    concurrency.max_threads = static_cast<std::size_t>(std::max(max_table_threads, 1));
+    if (max_table_memory > 0)
+    {
+        concurrency.max_heap_memory = static_cast<std::size_t>(max_table_memory) * 1024 * 1024;
+    }
 }
 
+template <typename ResultT>
 Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                   const api::TableParameters &params,
-                                  util::json::Object &result) const
+                                  const unsigned timestamp,
+                                  ResultT &result) const
 {
     if (!algorithms.HasManyToManySearch())
     {
@@ -81,19 +91,44 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     }
 
     auto snapped_phantoms = SnapPhantomNodes(phantom_nodes);
-    auto result_table =
-        algorithms.ManyToManySearch(snapped_phantoms, params.sources, params.destinations);
 
-    if (result_table.empty())
-    {
-        return Error("NoTable", "No table found", result);
-    }
-
-    api::TableAPI table_api{facade, params};
-    table_api.MakeResponse(result_table, snapped_phantoms, result);
-
-    return Status::Ok;
+    // repeated requests are answered from the cache, if enabled
+    const auto make_key = [&] { return ResultCache::MakeKey(params, snapped_phantoms); };
+    const auto make_response = [&]() -> Status {
+        const bool distances_requested =
+            params.annotations & api::TableParameters::AnnotationsType::Distance;
+        auto result_tables = algorithms.ManyToManySearch(snapped_phantoms,
+                                                         params.sources,
+                                                         params.destinations,
+                                                         distances_requested,
+                                                         concurrency);
+
+        if (result_tables.first.empty() || (distances_requested && result_tables.second.empty()))
+        {
+            return Error("NoTable", "No table found", result);
+        }
+
+        api::TableAPI table_api{facade, params};
+        table_api.MakeResponse(result_tables, snapped_phantoms, result);
+
+        return Status::Ok;
+    };
+
+    return result_cache.Serve(timestamp, make_key, result, make_response);
 }
+
+template Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::TableParameters &,
+                                           const unsigned,
+                                           util::json::Object &) const;
+template Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::TableParameters &,
+                                           const unsigned,
+                                           api::BinaryWriter &) const;
+template Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                           const api::TableParameters &,
+                                           const unsigned,
+                                           util::json::Writer &) const;
 }
 }
 }
@@ -2,6 +2,8 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "util/coordinate_calculation.hpp"
+#include "util/log.hpp"
+#include "util/std_hash.hpp"
 #include "util/string_view.hpp"
 #include "util/vector_tile.hpp"
 #include "util/web_mercator.hpp"
@@ -879,12 +881,46 @@ void encodeVectorTile(const DataFacadeBase &facade,
 }
 }
 
+TilePlugin::TilePlugin(const std::size_t max_cache_size)
+    : cache(max_cache_size), cache_timestamp(0)
+{
+}
+
+std::size_t TilePlugin::TileKeyHash::operator()(const TileKey &key) const
+{
+    return hash_val(key.timestamp, key.x, key.y, key.z);
+}
+
 Status TilePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                  const api::TileParameters &parameters,
+                                 const unsigned timestamp,
                                  std::string &pbf_buffer) const
 {
     BOOST_ASSERT(parameters.IsValid());
 
+    // Tiles are always rendered without exclude classes, the timestamp in the key keeps tiles
+    // of old data from being returned while other threads still see the previous timestamp.
+    const auto use_cache = cache.GetMaxSize() > 0;
+    const TileKey key{timestamp, parameters.x, parameters.y, parameters.z};
+    if (use_cache)
+    {
+        if (cache_timestamp.exchange(timestamp) != timestamp)
+        {
+            const auto statistics = cache.GetStatistics();
+            util::Log(logDEBUG) << "Clearing tile cache for data timestamp " << timestamp << ", "
+                                << statistics.hits << " hits, " << statistics.misses
+                                << " misses";
+            cache.Clear();
+        }
+
+        std::shared_ptr<const std::string> cached_tile;
+        if (cache.Get(key, cached_tile))
+        {
+            pbf_buffer.append(*cached_tile);
+            return Status::Ok;
+        }
+    }
+
     const auto &facade = algorithms.GetFacade();
     auto edges = getEdges(facade, parameters.x, parameters.y, parameters.z);
 
@@ -899,8 +935,19 @@ Status TilePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         turns = algorithms.GetTileTurns(edges, edge_index);
     }
 
+    if (!use_cache)
+    {
+        encodeVectorTile(
+            facade, parameters.x, parameters.y, parameters.z, edges, edge_index, turns, pbf_buffer);
+        return Status::Ok;
+    }
+
+    auto tile = std::make_shared<std::string>();
     encodeVectorTile(
-        facade, parameters.x, parameters.y, parameters.z, edges, edge_index, turns, pbf_buffer);
+        facade, parameters.x, parameters.y, parameters.z, edges, edge_index, turns, *tile);
+    pbf_buffer.append(*tile);
+    const auto size = tile->size();
+    cache.Put(key, std::move(tile), size);
 
     return Status::Ok;
 }
@@ -2,8 +2,9 @@
 
 #include "engine/api/trip_api.hpp"
 #include "engine/api/trip_parameters.hpp"
-#include "engine/trip/trip_brute_force.hpp"
 #include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
 #include "engine/trip/trip_nearest_neighbour.hpp"
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
@@ -11,6 +12,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -217,14 +219,18 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     // compute the duration table of all phantom nodes
     auto result_table = util::DistTableWrapper<EdgeWeight>(
-        algorithms.ManyToManySearch(snapped_phantoms, {}, {}), number_of_locations);
+        algorithms.ManyToManySearch(snapped_phantoms, {}, {}, false, {}).first,
+        number_of_locations);
 
     if (result_table.size() == 0)
     {
         return Status::Error;
     }
 
-    const constexpr std::size_t BF_MAX_FEASABLE = 10;
+    // local search restarts share the time budget, their number does not depend on the threads
+    // so results are the same for every max_trip_threads
+    const constexpr std::size_t LOCAL_SEARCH_RESTARTS = 8;
+    const constexpr std::chrono::milliseconds LOCAL_SEARCH_TIME_BUDGET{100};
     BOOST_ASSERT_MSG(result_table.size() == number_of_locations * number_of_locations,
                      "Distance Table has wrong size");
 
@@ -241,13 +247,20 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     std::vector<NodeID> trip;
     trip.reserve(number_of_locations);
     // get an optimized order in which the destinations should be visited
-    if (number_of_locations < BF_MAX_FEASABLE)
+    if (number_of_locations <= trip::HELD_KARP_MAX_LOCATIONS)
     {
-        trip = trip::BruteForceTrip(number_of_locations, result_table);
+        trip = trip::HeldKarpTrip(number_of_locations, result_table);
     }
-    else
+
+    // the exact solver finds no trip if every trip uses a leg excluded for a fixed start and end
+    if (trip.empty())
     {
         trip = trip::FarthestInsertionTrip(number_of_locations, result_table);
+        trip = trip::LocalSearchTrip(result_table,
+                                     trip,
+                                     LOCAL_SEARCH_TIME_BUDGET,
+                                     LOCAL_SEARCH_RESTARTS,
+                                     max_trip_threads);
     }
 
     // rotate result such that roundtrip starts at node with index 0
@@ -21,14 +21,21 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute, int max_alternatives)
-    : max_locations_viaroute(max_locations_viaroute), max_alternatives(max_alternatives)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute,
+                               int max_alternatives,
+                               int max_alternative_threads,
+                               const ResultCache &result_cache)
+    : max_locations_viaroute(max_locations_viaroute), max_alternatives(max_alternatives),
+      max_alternative_threads(static_cast<std::size_t>(std::max(max_alternative_threads, 1))),
+      result_cache(result_cache)
 {
 }
 
+template <typename ResultT>
 Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                      const api::RouteParameters &route_parameters,
-                                     util::json::Object &json_result) const
+                                     const unsigned timestamp,
+                                     ResultT &json_result) const
 {
     BOOST_ASSERT(route_parameters.IsValid());
 
@@ -96,65 +103,88 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
     };
     util::for_each_pair(snapped_phantoms, build_phantom_pairs);
 
-    api::RouteAPI route_api{facade, route_parameters};
-
-    InternalManyRoutesResult routes;
-
-    // TODO: in v6 we should remove the boolean and only keep the number parameter.
-    // For now just force them to be in sync. and keep backwards compatibility.
-    const auto wants_alternatives =
-        (max_alternatives > 0) &&
-        (route_parameters.alternatives || route_parameters.number_of_alternatives > 0);
-    const auto number_of_alternatives = std::max(1u, route_parameters.number_of_alternatives);
-
-    // Alternatives do not support vias, only direct s,t queries supported
-    // See the implementation notes and high-level outline.
-    // https://github.com/Project-OSRM/osrm-backend/issues/3905
-    if (1 == start_end_nodes.size() && algorithms.HasAlternativePathSearch() && wants_alternatives)
-    {
-        routes = algorithms.AlternativePathSearch(start_end_nodes.front(), number_of_alternatives);
-    }
-    else if (1 == start_end_nodes.size() && algorithms.HasDirectShortestPathSearch())
-    {
-        routes = algorithms.DirectShortestPathSearch(start_end_nodes.front());
-    }
-    else
-    {
-        routes = algorithms.ShortestPathSearch(start_end_nodes, route_parameters.continue_straight);
-    }
+    // repeated requests are answered from the cache, if enabled
+    const auto make_key = [&] { return ResultCache::MakeKey(route_parameters, snapped_phantoms); };
+    const auto make_response = [&]() -> Status {
+        api::RouteAPI route_api{facade, route_parameters};
+
+        InternalManyRoutesResult routes;
+
+        // TODO: in v6 we should remove the boolean and only keep the number parameter.
+        // For now just force them to be in sync. and keep backwards compatibility.
+        const auto wants_alternatives =
+            (max_alternatives > 0) &&
+            (route_parameters.alternatives || route_parameters.number_of_alternatives > 0);
+        const auto number_of_alternatives = std::max(1u, route_parameters.number_of_alternatives);
+
+        // Alternatives do not support vias, only direct s,t queries supported
+        // See the implementation notes and high-level outline.
+        // https://github.com/Project-OSRM/osrm-backend/issues/3905
+        if (1 == start_end_nodes.size() && algorithms.HasAlternativePathSearch() &&
+            wants_alternatives)
+        {
+            routes = algorithms.AlternativePathSearch(
+                start_end_nodes.front(), number_of_alternatives, max_alternative_threads);
+        }
+        else if (1 == start_end_nodes.size() && algorithms.HasDirectShortestPathSearch())
+        {
+            routes = algorithms.DirectShortestPathSearch(start_end_nodes.front());
+        }
+        else
+        {
+            routes =
+                algorithms.ShortestPathSearch(start_end_nodes, route_parameters.continue_straight);
+        }
 
-    // The post condition for all path searches is we have at least one route in our result.
-    // This route might be invalid by means of INVALID_EDGE_WEIGHT as shortest path weight.
-    BOOST_ASSERT(!routes.routes.empty());
+        // The post condition for all path searches is we have at least one route in our result.
+        // This route might be invalid by means of INVALID_EDGE_WEIGHT as shortest path weight.
+        BOOST_ASSERT(!routes.routes.empty());
 
-    // we can only know this after the fact, different SCC ids still
-    // allow for connection in one direction.
+        // we can only know this after the fact, different SCC ids still
+        // allow for connection in one direction.
 
-    if (routes.routes[0].is_valid())
-    {
-        route_api.MakeResponse(routes, json_result);
-    }
-    else
-    {
-        auto first_component_id = snapped_phantoms.front().component.id;
-        auto not_in_same_component = std::any_of(snapped_phantoms.begin(),
-                                                 snapped_phantoms.end(),
-                                                 [first_component_id](const PhantomNode &node) {
-                                                     return node.component.id != first_component_id;
-                                                 });
-
-        if (not_in_same_component)
+        if (routes.routes[0].is_valid())
         {
-            return Error("NoRoute", "Impossible route between points", json_result);
+            route_api.MakeResponse(routes, json_result);
         }
         else
         {
-            return Error("NoRoute", "No route found between points", json_result);
+            auto first_component_id = snapped_phantoms.front().component.id;
+            auto not_in_same_component =
+                std::any_of(snapped_phantoms.begin(),
+                            snapped_phantoms.end(),
+                            [first_component_id](const PhantomNode &node) {
+                                return node.component.id != first_component_id;
+                            });
+
+            if (not_in_same_component)
+            {
+                return Error("NoRoute", "Impossible route between points", json_result);
+            }
+            else
+            {
+                return Error("NoRoute", "No route found between points", json_result);
+            }
         }
-    }
 
-    return Status::Ok;
+        return Status::Ok;
+    };
+
+    return result_cache.Serve(timestamp, make_key, json_result, make_response);
 }
+
+template Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                              const api::RouteParameters &,
+                                              const unsigned,
+                                              util::json::Object &) const;
+template Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                              const api::RouteParameters &,
+                                              const unsigned,
+                                              api::BinaryWriter &) const;
+template Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &,
+                                              const api::RouteParameters &,
+                                              const unsigned,
+                                              util::json::Writer &) const;
 }
 }
 }
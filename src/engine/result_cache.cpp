@@ -0,0 +1,145 @@
+#include "engine/result_cache.hpp"
+
+#include "util/log.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+// Appends values to a cache key. Every variable length value is prefixed with its length, so
+// different parameters can not produce the same key.
+class KeyWriter
+{
+  public:
+    explicit KeyWriter(std::string &key) : key(key) {}
+
+    template <typename T> void Add(const T value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only raw bytes are written");
+        key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void Add(const std::string &value)
+    {
+        Add(value.size());
+        key.append(value);
+    }
+
+    void Add(const util::Coordinate coordinate)
+    {
+        Add(static_cast<std::int32_t>(coordinate.lon));
+        Add(static_cast<std::int32_t>(coordinate.lat));
+    }
+
+    void Add(const boost::optional<bool> value)
+    {
+        Add(static_cast<std::int8_t>(value ? *value : -1));
+    }
+
+    // Fields one by one, the unused bits of a PhantomNode are not initialized
+    void Add(const PhantomNode &phantom)
+    {
+        Add(phantom.forward_segment_id.id);
+        Add(phantom.forward_segment_id.enabled);
+        Add(phantom.reverse_segment_id.id);
+        Add(phantom.reverse_segment_id.enabled);
+        Add(phantom.forward_weight);
+        Add(phantom.reverse_weight);
+        Add(phantom.forward_weight_offset);
+        Add(phantom.reverse_weight_offset);
+        Add(phantom.forward_duration);
+        Add(phantom.reverse_duration);
+        Add(phantom.forward_duration_offset);
+        Add(phantom.reverse_duration_offset);
+        Add(phantom.component.id);
+        Add(phantom.component.is_tiny);
+        Add(phantom.location);
+        Add(phantom.input_location);
+        Add(phantom.fwd_segment_position);
+        Add(static_cast<std::uint8_t>(
+            phantom.IsValidForwardSource() | phantom.IsValidForwardTarget() << 1 |
+            phantom.IsValidReverseSource() << 2 | phantom.IsValidReverseTarget() << 3));
+    }
+
+    template <typename T> void Add(const std::vector<T> &values)
+    {
+        Add(values.size());
+        for (const auto &value : values)
+        {
+            Add(value);
+        }
+    }
+
+  private:
+    std::string &key;
+};
+
+void AddBaseParameters(KeyWriter &writer,
+                       const api::BaseParameters &parameters,
+                       const std::vector<PhantomNode> &snapped_phantoms)
+{
+    // the coordinates are part of the phantoms as their input location
+    writer.Add(snapped_phantoms);
+
+    // the order of the exclude classes does not matter
+    auto exclude = parameters.exclude;
+    std::sort(exclude.begin(), exclude.end());
+    exclude.erase(std::unique(exclude.begin(), exclude.end()), exclude.end());
+    writer.Add(exclude);
+
+    writer.Add(parameters.metric);
+    writer.Add(parameters.generate_hints);
+}
+}
+
+std::string ResultCache::MakeKey(const api::RouteParameters &parameters,
+                                 const std::vector<PhantomNode> &snapped_phantoms)
+{
+    std::string key;
+    KeyWriter writer(key);
+    writer.Add('r');
+    AddBaseParameters(writer, parameters, snapped_phantoms);
+    writer.Add(parameters.steps);
+    writer.Add(parameters.alternatives);
+    writer.Add(parameters.number_of_alternatives);
+    writer.Add(parameters.annotations);
+    writer.Add(parameters.annotations_type);
+    writer.Add(parameters.geometries);
+    writer.Add(parameters.overview);
+    writer.Add(parameters.continue_straight);
+    return key;
+}
+
+std::string ResultCache::MakeKey(const api::TableParameters &parameters,
+                                 const std::vector<PhantomNode> &snapped_phantoms)
+{
+    std::string key;
+    KeyWriter writer(key);
+    writer.Add('t');
+    AddBaseParameters(writer, parameters, snapped_phantoms);
+    writer.Add(parameters.sources);
+    writer.Add(parameters.destinations);
+    writer.Add(parameters.annotations);
+    return key;
+}
+
+void ResultCache::Invalidate(const unsigned timestamp) const
+{
+    if (cache_timestamp.exchange(timestamp) != timestamp)
+    {
+        const auto statistics = cache.GetStatistics();
+        util::Log(logDEBUG) << "Clearing result cache for data timestamp " << timestamp << ", "
+                            << statistics.hits << " hits, " << statistics.misses << " misses, "
+                            << statistics.evictions << " evictions";
+        cache.Clear();
+    }
+}
+}
+}
@@ -5,11 +5,16 @@
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <tuple>
 #include <type_traits>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -77,6 +82,45 @@ struct WeightedViaNodeUnpackedPath
     UnpackedEdges edges;
 };
 
+// Unpacked sub-path of an overlay edge, without the overlay edge's source node.
+struct UnpackedOverlayEdge
+{
+    NodeID source;
+    NodeID target;
+    UnpackedNodes nodes;
+    UnpackedEdges edges;
+};
+
+// Sorted by source and target for lookups
+using UnpackedOverlayEdges = std::vector<UnpackedOverlayEdge>;
+
+// Search heaps owned by a single thread of the parallel unpacking
+struct UnpackingHeaps
+{
+    Heap forward_heap;
+    Heap reverse_heap;
+};
+
+// Set of node, cell or edge ids for the overlap checks. A sorted vector is more compact and
+// faster to probe than a hash set for the few thousand ids of a handful of paths.
+template <typename T> class SortedIdSet
+{
+  public:
+    template <typename InputIt> void Insert(InputIt first, InputIt last)
+    {
+        const auto old_size = ids.size();
+        ids.insert(ids.end(), first, last);
+        std::sort(ids.begin() + old_size, ids.end());
+        std::inplace_merge(ids.begin(), ids.begin() + old_size, ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    bool Contains(const T id) const { return std::binary_search(ids.begin(), ids.end(), id); }
+
+  private:
+    std::vector<T> ids;
+};
+
 // Filters candidates which are on not unique.
 // Returns an iterator to the uniquified range's new end.
 // Note: mutates the range in-place invalidating iterators.
@@ -184,14 +228,17 @@ filterViaCandidatesByViaNotOnPath(const WeightedViaNodePackedPath &path, RandIt
     if (path.path.empty())
         return last;
 
-    std::unordered_set<NodeID> nodes;
-    nodes.reserve(path.path.size() + 1);
+    std::vector<NodeID> path_nodes;
+    path_nodes.reserve(path.path.size() + 1);
 
-    nodes.insert(std::get<0>(path.path.front()));
+    path_nodes.push_back(std::get<0>(path.path.front()));
     for (const auto &edge : path.path)
-        nodes.insert(std::get<1>(edge));
+        path_nodes.push_back(std::get<1>(edge));
+
+    SortedIdSet<NodeID> nodes;
+    nodes.Insert(begin(path_nodes), end(path_nodes));
 
-    const auto via_on_path = [&](const auto via) { return nodes.count(via.node) > 0; };
+    const auto via_on_path = [&](const auto via) { return nodes.Contains(via.node); };
 
     return std::remove_if(first, last, via_on_path);
 }
@@ -226,18 +273,23 @@ RandIt filterPackedPathsByCellSharing(RandIt first, RandIt last, const Partition
     if (shortest_path.path.empty())
         return last;
 
-    std::unordered_set<CellID> cells;
-    cells.reserve(size * (shortest_path.path.size() + 1) * (1. + kAtMostLongerBy));
+    SortedIdSet<CellID> cells;
+    std::vector<CellID> path_cells;
+    const auto insert_path_cells = [&](const PackedPath &path) {
+        path_cells.clear();
+        path_cells.push_back(get_cell(std::get<0>(path.front())));
+        for (const auto &edge : path)
+            path_cells.push_back(get_cell(std::get<1>(edge)));
+        cells.Insert(begin(path_cells), end(path_cells));
+    };
 
-    cells.insert(get_cell(std::get<0>(shortest_path.path.front())));
-    for (const auto &edge : shortest_path.path)
-        cells.insert(get_cell(std::get<1>(edge)));
+    insert_path_cells(shortest_path.path);
 
     const auto over_sharing_limit = [&](const auto &packed) {
         const auto not_seen = [&](const PackedEdge edge) {
             const auto source_cell = get_cell(std::get<0>(edge));
             const auto target_cell = get_cell(std::get<1>(edge));
-            return cells.count(source_cell) < 1 && cells.count(target_cell) < 1;
+            return !cells.Contains(source_cell) && !cells.Contains(target_cell);
         };
 
         const auto different = std::count_if(begin(packed.path), end(packed.path), not_seen);
@@ -254,10 +306,7 @@ RandIt filterPackedPathsByCellSharing(RandIt first, RandIt last, const Partition
         }
         else
         {
-            cells.insert(get_cell(std::get<0>(packed.path.front())));
-            for (const auto &edge : packed.path)
-                cells.insert(get_cell(std::get<1>(edge)));
-
+            insert_path_cells(packed.path);
             return false;
         }
     };
@@ -373,50 +422,20 @@ RandIt filterPackedPathsByLocalOptimality(const WeightedViaNodePackedPath &path,
     return std::remove_if(first, last, is_not_locally_optimal);
 }
 
-// Filters unpacked paths compared to all other paths. Mutates range in-place.
-// Returns an iterator to the filtered range's new end.
-template <typename RandIt> RandIt filterUnpackedPathsBySharing(RandIt first, RandIt last)
+// Checks if an unpacked path shares too many edges with the paths kept before it.
+inline bool isUnpackedPathOverSharingLimit(const SortedIdSet<EdgeID> &edges,
+                                           const WeightedViaNodeUnpackedPath &unpacked)
 {
-    util::static_assert_iter_category<RandIt, std::random_access_iterator_tag>();
-    util::static_assert_iter_value<RandIt, WeightedViaNodeUnpackedPath>();
+    const auto not_seen = [&](const EdgeID edge) { return !edges.Contains(edge); };
+    const auto different = std::count_if(begin(unpacked.edges), end(unpacked.edges), not_seen);
 
-    const auto size = static_cast<std::size_t>(last - first);
+    const auto difference = different / static_cast<double>(unpacked.edges.size());
+    BOOST_ASSERT(difference >= 0.);
+    BOOST_ASSERT(difference <= 1.);
 
-    if (size < 2)
-        return last;
+    const auto sharing = 1. - difference;
 
-    const auto &shortest_path = *first;
-
-    if (shortest_path.edges.empty())
-        return last;
-
-    std::unordered_set<EdgeID> edges;
-    edges.reserve(size * shortest_path.edges.size() * (1. + kAtMostLongerBy));
-
-    edges.insert(begin(shortest_path.edges), begin(shortest_path.edges));
-
-    const auto over_sharing_limit = [&](const auto &unpacked) {
-        const auto not_seen = [&](const EdgeID edge) { return edges.count(edge) < 1; };
-        const auto different = std::count_if(begin(unpacked.edges), end(unpacked.edges), not_seen);
-
-        const auto difference = different / static_cast<double>(unpacked.edges.size());
-        BOOST_ASSERT(difference >= 0.);
-        BOOST_ASSERT(difference <= 1.);
-
-        const auto sharing = 1. - difference;
-
-        if (sharing > kAtLeastDifferentBy)
-        {
-            return true;
-        }
-        else
-        {
-            edges.insert(begin(unpacked.edges), end(unpacked.edges));
-            return false;
-        }
-    };
-
-    return std::remove_if(first + 1, last, over_sharing_limit);
+    return sharing > kAtLeastDifferentBy;
 }
 
 // Filters annotated routes by stretch based on duration. Mutates range in-place.
@@ -442,116 +461,248 @@ filterAnnotatedRoutesByStretch(RandIt first, RandIt last, const InternalRouteRes
     return std::remove_if(first, last, over_duration_limit);
 }
 
-// Unpacks a range of WeightedViaNodePackedPaths into a range of WeightedViaNodeUnpackedPaths.
-// Note: destroys search engine heaps for recursive unpacking. Extract heap data you need before.
-template <typename InputIt, typename OutIt>
-void unpackPackedPaths(InputIt first,
-                       InputIt last,
-                       OutIt out,
-                       SearchEngineData<Algorithm> &search_engine_data,
-                       const Facade &facade,
-                       const PhantomNodes &phantom_node_pair)
+// Unpacks a WeightedViaNodePackedPath into a WeightedViaNodeUnpackedPath. Overlay edges found in
+// the sorted known_overlay_edges are copied from there, all others are searched with the heaps.
+// If new_overlay_edges is set, the overlay edges searched for are appended to it.
+// Note: destroys the heaps' contents. Extract heap data you need before.
+inline WeightedViaNodeUnpackedPath
+unpackPackedPath(const WeightedViaNodePackedPath &weighted_packed_path,
+                 SearchEngineData<Algorithm> &search_engine_data,
+                 Heap &forward_heap,
+                 Heap &reverse_heap,
+                 const Facade &facade,
+                 const PhantomNodes &phantom_node_pair,
+                 const UnpackedOverlayEdges &known_overlay_edges,
+                 UnpackedOverlayEdges *new_overlay_edges)
 {
-    util::static_assert_iter_category<InputIt, std::input_iterator_tag>();
-    util::static_assert_iter_category<OutIt, std::output_iterator_tag>();
-    util::static_assert_iter_value<InputIt, WeightedViaNodePackedPath>();
-
     const bool force_loop_forward = needsLoopForward(phantom_node_pair);
     const bool force_loop_backward = needsLoopBackwards(phantom_node_pair);
 
     const Partition &partition = facade.GetMultiLevelPartition();
 
-    Heap &forward_heap = *search_engine_data.forward_heap_1;
-    Heap &reverse_heap = *search_engine_data.reverse_heap_1;
+    const auto packed_path_weight = weighted_packed_path.via.weight;
+    const auto packed_path_via = weighted_packed_path.via.node;
+
+    const auto &packed_path = weighted_packed_path.path;
 
-    for (auto it = first; it != last; ++it, ++out)
+    //
+    // Todo: dup. code with mld::search except for level entry: we run a slight mld::search
+    //       adaption here and then dispatch to mld::search for recursively descending down.
+    //
+
+    std::vector<NodeID> unpacked_nodes;
+    std::vector<EdgeID> unpacked_edges;
+    unpacked_nodes.reserve(packed_path.size());
+    unpacked_edges.reserve(packed_path.size());
+
+    // Beware the edge case when start, via, end are all the same.
+    // In this case we return a single node, no edges. We also don't unpack.
+    if (packed_path.empty())
     {
-        const auto packed_path_weight = it->via.weight;
-        const auto packed_path_via = it->via.node;
+        const auto source_node = packed_path_via;
+        unpacked_nodes.push_back(source_node);
+    }
+    else
+    {
+        const auto source_node = std::get<0>(packed_path.front());
+        unpacked_nodes.push_back(source_node);
+    }
 
-        const auto &packed_path = it->path;
+    const auto by_source_and_target = [](const UnpackedOverlayEdge &edge,
+                                         const std::pair<NodeID, NodeID> &key) {
+        return std::tie(edge.source, edge.target) < std::tie(key.first, key.second);
+    };
 
-        //
-        // Todo: dup. code with mld::search except for level entry: we run a slight mld::search
-        //       adaption here and then dispatch to mld::search for recursively descending down.
-        //
+    for (auto const &packed_edge : packed_path)
+    {
+        NodeID source, target;
+        bool overlay_edge;
+        std::tie(source, target, overlay_edge) = packed_edge;
+        if (!overlay_edge)
+        { // a base graph edge
+            unpacked_nodes.push_back(target);
+            unpacked_edges.push_back(facade.FindEdge(source, target));
+            continue;
+        }
 
-        std::vector<NodeID> unpacked_nodes;
-        std::vector<EdgeID> unpacked_edges;
-        unpacked_nodes.reserve(packed_path.size());
-        unpacked_edges.reserve(packed_path.size());
+        // an overlay graph edge the shortest path has already unpacked
+        const auto known = std::lower_bound(begin(known_overlay_edges),
+                                            end(known_overlay_edges),
+                                            std::make_pair(source, target),
+                                            by_source_and_target);
+        if (known != end(known_overlay_edges) && known->source == source &&
+            known->target == target)
+        {
+            unpacked_nodes.insert(unpacked_nodes.end(), known->nodes.begin(), known->nodes.end());
+            unpacked_edges.insert(unpacked_edges.end(), known->edges.begin(), known->edges.end());
+            continue;
+        }
 
-        // Beware the edge case when start, via, end are all the same.
-        // In this case we return a single node, no edges. We also don't unpack.
-        if (packed_path.empty())
+        // an overlay graph edge
+        LevelID level = getNodeQueryLevel(partition, source, phantom_node_pair); // XXX
+        CellID parent_cell_id = partition.GetCell(level, source);
+        BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
+
+        LevelID sublevel = level - 1;
+
+        // Here heaps can be reused, let's go deeper!
+        forward_heap.Clear();
+        reverse_heap.Clear();
+        forward_heap.Insert(source, 0, {source});
+        reverse_heap.Insert(target, 0, {target});
+
+        BOOST_ASSERT(!facade.ExcludeNode(source));
+        BOOST_ASSERT(!facade.ExcludeNode(target));
+
+        // TODO: when structured bindings will be allowed change to
+        // auto [subpath_weight, subpath_source, subpath_target, subpath] = ...
+        EdgeWeight subpath_weight;
+        std::vector<NodeID> subpath_nodes;
+        std::vector<EdgeID> subpath_edges;
+        std::tie(subpath_weight, subpath_nodes, subpath_edges) = search(search_engine_data,
+                                                                        facade,
+                                                                        forward_heap,
+                                                                        reverse_heap,
+                                                                        force_loop_forward,
+                                                                        force_loop_backward,
+                                                                        INVALID_EDGE_WEIGHT,
+                                                                        sublevel,
+                                                                        parent_cell_id);
+        BOOST_ASSERT(!subpath_edges.empty());
+        BOOST_ASSERT(subpath_nodes.size() > 1);
+        BOOST_ASSERT(subpath_nodes.front() == source);
+        BOOST_ASSERT(subpath_nodes.back() == target);
+        unpacked_nodes.insert(
+            unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
+        unpacked_edges.insert(unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
+
+        if (new_overlay_edges)
         {
-            const auto source_node = packed_path_via;
-            unpacked_nodes.push_back(source_node);
+            subpath_nodes.erase(subpath_nodes.begin());
+            new_overlay_edges->push_back(UnpackedOverlayEdge{
+                source, target, std::move(subpath_nodes), std::move(subpath_edges)});
+        }
+    }
+
+    return WeightedViaNodeUnpackedPath{WeightedViaNode{packed_path_via, packed_path_weight},
+                                       std::move(unpacked_nodes),
+                                       std::move(unpacked_edges)};
+}
+
+// Unpacks the shortest path and then the alternative packed paths [first, last) in rank order
+// into unpacked_paths, keeping alternatives that pass the sharing check against all paths kept
+// before them. Alternatives are unpacked in batches of max_threads paths, concurrently on one
+// pair of heaps per thread, and reuse the overlay edges the shortest path unpacked. Unpacking
+// stops as soon as max_number_of_paths paths are kept: later candidates can not replace them.
+// Note: destroys the thread-local search engine heaps. Extract heap data you need before.
+template <typename RandIt>
+void unpackPackedPathsBySharing(const WeightedViaNodePackedPath &shortest_path,
+                                RandIt first,
+                                RandIt last,
+                                std::vector<WeightedViaNodeUnpackedPath> &unpacked_paths,
+                                const std::size_t max_number_of_paths,
+                                SearchEngineData<Algorithm> &search_engine_data,
+                                const Facade &facade,
+                                const PhantomNodes &phantom_node_pair,
+                                const std::size_t max_threads)
+{
+    util::static_assert_iter_category<RandIt, std::random_access_iterator_tag>();
+    util::static_assert_iter_value<RandIt, WeightedViaNodePackedPath>();
+    BOOST_ASSERT(max_number_of_paths >= 1);
+
+    Heap &forward_heap = *search_engine_data.forward_heap_1;
+    Heap &reverse_heap = *search_engine_data.reverse_heap_1;
+
+    UnpackedOverlayEdges shortest_path_overlay_edges;
+    unpacked_paths.push_back(unpackPackedPath(shortest_path,
+                                              search_engine_data,
+                                              forward_heap,
+                                              reverse_heap,
+                                              facade,
+                                              phantom_node_pair,
+                                              {},
+                                              &shortest_path_overlay_edges));
+    std::sort(begin(shortest_path_overlay_edges),
+              end(shortest_path_overlay_edges),
+              [](const auto &lhs, const auto &rhs) {
+                  return std::tie(lhs.source, lhs.target) < std::tie(rhs.source, rhs.target);
+              });
+
+    // Without edges on the shortest path there is nothing to share, all paths are kept.
+    const bool check_sharing = !unpacked_paths.front().edges.empty();
+
+    SortedIdSet<EdgeID> edges;
+    edges.Insert(begin(unpacked_paths.front().edges), end(unpacked_paths.front().edges));
+
+    const auto batch_size = std::max<std::size_t>(max_threads, 1);
+    std::vector<WeightedViaNodeUnpackedPath> batch;
+
+    // The arena and the heaps of its threads are only set up by the first parallel batch
+    tbb::task_arena arena(static_cast<int>(batch_size));
+    const auto number_of_nodes = facade.GetNumberOfNodes();
+    const auto max_heap_index_memory = search_engine_data.max_heap_index_memory;
+    tbb::enumerable_thread_specific<UnpackingHeaps> heaps([&] {
+        return UnpackingHeaps{Heap(number_of_nodes, max_heap_index_memory),
+                              Heap(number_of_nodes, max_heap_index_memory)};
+    });
+
+    auto batch_first = first;
+    while (batch_first != last && unpacked_paths.size() < max_number_of_paths)
+    {
+        const auto batch_last =
+            batch_first + std::min<std::size_t>(batch_size, std::distance(batch_first, last));
+        batch.resize(std::distance(batch_first, batch_last));
+
+        if (batch.size() == 1)
+        {
+            batch.front() = unpackPackedPath(*batch_first,
+                                             search_engine_data,
+                                             forward_heap,
+                                             reverse_heap,
+                                             facade,
+                                             phantom_node_pair,
+                                             shortest_path_overlay_edges,
+                                             nullptr);
         }
         else
         {
-            const auto source_node = std::get<0>(packed_path.front());
-            unpacked_nodes.push_back(source_node);
+            arena.execute([&] {
+                tbb::parallel_for(
+                    tbb::blocked_range<std::size_t>(0, batch.size(), 1),
+                    [&](const tbb::blocked_range<std::size_t> &range) {
+                        auto &local_heaps = heaps.local();
+                        for (auto index = range.begin(), end = range.end(); index != end; ++index)
+                        {
+                            batch[index] = unpackPackedPath(*(batch_first + index),
+                                                            search_engine_data,
+                                                            local_heaps.forward_heap,
+                                                            local_heaps.reverse_heap,
+                                                            facade,
+                                                            phantom_node_pair,
+                                                            shortest_path_overlay_edges,
+                                                            nullptr);
+                        }
+                    });
+            });
         }
 
-        for (auto const &packed_edge : packed_path)
+        for (auto &unpacked : batch)
         {
-            NodeID source, target;
-            bool overlay_edge;
-            std::tie(source, target, overlay_edge) = packed_edge;
-            if (!overlay_edge)
-            { // a base graph edge
-                unpacked_nodes.push_back(target);
-                unpacked_edges.push_back(facade.FindEdge(source, target));
-            }
-            else
-            { // an overlay graph edge
-                LevelID level = getNodeQueryLevel(partition, source, phantom_node_pair); // XXX
-                CellID parent_cell_id = partition.GetCell(level, source);
-                BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
-
-                LevelID sublevel = level - 1;
-
-                // Here heaps can be reused, let's go deeper!
-                forward_heap.Clear();
-                reverse_heap.Clear();
-                forward_heap.Insert(source, 0, {source});
-                reverse_heap.Insert(target, 0, {target});
-
-                BOOST_ASSERT(!facade.ExcludeNode(source));
-                BOOST_ASSERT(!facade.ExcludeNode(target));
-
-                // TODO: when structured bindings will be allowed change to
-                // auto [subpath_weight, subpath_source, subpath_target, subpath] = ...
-                EdgeWeight subpath_weight;
-                std::vector<NodeID> subpath_nodes;
-                std::vector<EdgeID> subpath_edges;
-                std::tie(subpath_weight, subpath_nodes, subpath_edges) = search(search_engine_data,
-                                                                                facade,
-                                                                                forward_heap,
-                                                                                reverse_heap,
-                                                                                force_loop_forward,
-                                                                                force_loop_backward,
-                                                                                INVALID_EDGE_WEIGHT,
-                                                                                sublevel,
-                                                                                parent_cell_id);
-                BOOST_ASSERT(!subpath_edges.empty());
-                BOOST_ASSERT(subpath_nodes.size() > 1);
-                BOOST_ASSERT(subpath_nodes.front() == source);
-                BOOST_ASSERT(subpath_nodes.back() == target);
-                unpacked_nodes.insert(
-                    unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
-                unpacked_edges.insert(
-                    unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
+            if (unpacked_paths.size() >= max_number_of_paths)
+                break;
+
+            if (check_sharing)
+            {
+                if (isUnpackedPathOverSharingLimit(edges, unpacked))
+                    continue;
+
+                edges.Insert(begin(unpacked.edges), end(unpacked.edges));
             }
-        }
 
-        WeightedViaNodeUnpackedPath unpacked_path{
-            WeightedViaNode{packed_path_via, packed_path_weight},
-            std::move(unpacked_nodes),
-            std::move(unpacked_edges)};
+            unpacked_paths.push_back(std::move(unpacked));
+        }
 
-        out = std::move(unpacked_path);
+        batch_first = batch_last;
     }
 }
 
@@ -768,7 +919,8 @@ inline std::vector<EdgeWeight> retrievePackedPathWeightsFromHeap(const Heap &for
 InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &search_engine_data,
                                                const Facade &facade,
                                                const PhantomNodes &phantom_node_pair,
-                                               unsigned number_of_alternatives)
+                                               unsigned number_of_alternatives,
+                                               const std::size_t max_threads)
 {
     const auto max_number_of_alternatives = number_of_alternatives;
     const auto max_number_of_alternatives_to_unpack =
@@ -881,32 +1033,29 @@ InternalManyRoutesResult alternativePathSearch(SearchEngineData<Algorithm> &sear
     const auto paths_last = begin(weighted_packed_paths) + 1 + number_of_filtered_alternative_paths;
     const auto number_of_packed_paths = paths_last - paths_first;
 
-    std::vector<WeightedViaNodeUnpackedPath> unpacked_paths;
-    unpacked_paths.reserve(number_of_packed_paths);
-
-    // Note: re-uses (read: destroys) heaps; we don't need them from here on anyway.
-    unpackPackedPaths(paths_first,
-                      paths_last,
-                      std::back_inserter(unpacked_paths),
-                      search_engine_data,
-                      facade,
-                      phantom_node_pair);
-
     //
     // Filter and rank a second time. This time instead of being fast and doing
     // heuristics on the packed path only we now have the detailed unpacked path.
     //
 
-    auto unpacked_paths_last = end(unpacked_paths);
+    std::vector<WeightedViaNodeUnpackedPath> unpacked_paths;
+    unpacked_paths.reserve(number_of_packed_paths);
 
-    unpacked_paths_last = filterUnpackedPathsBySharing(begin(unpacked_paths), end(unpacked_paths));
+    // Note: re-uses (read: destroys) heaps; we don't need them from here on anyway.
+    unpackPackedPathsBySharing(*paths_first,
+                               paths_first + 1,
+                               paths_last,
+                               unpacked_paths,
+                               static_cast<std::size_t>(max_number_of_alternatives) + 1,
+                               search_engine_data,
+                               facade,
+                               phantom_node_pair,
+                               max_threads);
 
     const auto unpacked_paths_first = begin(unpacked_paths);
-    const auto number_of_unpacked_paths =
-        std::min(static_cast<std::size_t>(max_number_of_alternatives) + 1,
-                 static_cast<std::size_t>(unpacked_paths_last - unpacked_paths_first));
+    const auto unpacked_paths_last = end(unpacked_paths);
+    const auto number_of_unpacked_paths = unpacked_paths.size();
     BOOST_ASSERT(number_of_unpacked_paths >= 1);
-    unpacked_paths_last = unpacked_paths_first + number_of_unpacked_paths;
 
     //
     // Annotate the unpacked path and transform to proper internal route result.
@@ -1,11 +1,23 @@
 #include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/min_plus.hpp"
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -19,11 +31,18 @@ namespace
 {
 struct NodeBucket
 {
-    unsigned target_id; // essentially a row in the weight matrix
+    NodeID parent_node;
+    unsigned column_index; // a column in the weight/duration matrix
     EdgeWeight weight;
     EdgeWeight duration;
-    NodeBucket(const unsigned target_id, const EdgeWeight weight, const EdgeWeight duration)
-        : target_id(target_id), weight(weight), duration(duration)
+    bool from_clique_arc;
+    NodeBucket(const NodeID parent_node,
+               const unsigned column_index,
+               const EdgeWeight weight,
+               const EdgeWeight duration,
+               const bool from_clique_arc)
+        : parent_node(parent_node), column_index(column_index), weight(weight),
+          duration(duration), from_clique_arc(from_clique_arc)
     {
     }
 };
@@ -31,6 +50,38 @@ struct NodeBucket
 // FIXME This should be replaced by an std::unordered_multimap, though this needs benchmarking
 using SearchSpaceWithBuckets = std::unordered_map<NodeID, std::vector<NodeBucket>>;
 
+// Edges of a table entry path as {from node ID, to node ID, from_clique_arc}
+using PackedEdge = std::tuple<NodeID, NodeID, bool>;
+using PackedPath = std::vector<PackedEdge>;
+
+inline bool isFromCliqueArc(const ManyToManyHeapData &) { return false; }
+
+inline bool isFromCliqueArc(const ManyToManyMultiLayerDijkstraHeapData &data)
+{
+    return data.from_clique_arc;
+}
+
+inline const NodeBucket &findBucket(const SearchSpaceWithBuckets &search_space_with_buckets,
+                                    const NodeID node,
+                                    const unsigned column_idx)
+{
+    const auto node_buckets = search_space_with_buckets.find(node);
+    BOOST_ASSERT(node_buckets != search_space_with_buckets.end());
+    // the buckets of a node are stored in the order of the backward searches
+    const auto bucket = std::lower_bound(
+        node_buckets->second.begin(),
+        node_buckets->second.end(),
+        column_idx,
+        [](const NodeBucket &lhs, const unsigned rhs) { return lhs.column_index < rhs; });
+    BOOST_ASSERT(bucket != node_buckets->second.end());
+    BOOST_ASSERT(bucket->column_index == column_idx);
+    return *bucket;
+}
+
+// Rough estimate of the memory a many-to-many heap needs for each settled node: the
+// heap node with its data, the entry in the priority queue and the entry in the node index.
+const constexpr std::size_t HEAP_BYTES_PER_SETTLED_NODE = 64;
+
 inline bool addLoopWeight(const DataFacade<ch::Algorithm> &facade,
                           const NodeID node,
                           EdgeWeight &weight,
@@ -103,6 +154,19 @@ addLoopWeight(const DataFacade<mld::Algorithm> &, const NodeID, EdgeWeight &, Ed
     return false;
 }
 
+inline LevelID getNodeQueryLevel(const partition::MultiLevelPartitionView &partition,
+                                 const NodeID node,
+                                 const PhantomNode &phantom_node)
+{
+    auto highest_diffrent_level = [&partition, node](const SegmentID &phantom_node) {
+        if (phantom_node.enabled)
+            return partition.GetHighestDifferentLevel(phantom_node.id, node);
+        return INVALID_LEVEL_ID;
+    };
+    return std::min(highest_diffrent_level(phantom_node.forward_segment_id),
+                    highest_diffrent_level(phantom_node.reverse_segment_id));
+}
+
 template <bool DIRECTION>
 void relaxOutgoingEdges(const DataFacade<mld::Algorithm> &facade,
                         const NodeID node,
@@ -117,13 +181,7 @@ void relaxOutgoingEdges(const DataFacade<mld::Algorithm> &facade,
     const auto &cells = facade.GetCellStorage();
     const auto &metric = facade.GetCellMetric();
 
-    auto highest_diffrent_level = [&partition, node](const SegmentID &phantom_node) {
-        if (phantom_node.enabled)
-            return partition.GetHighestDifferentLevel(phantom_node.id, node);
-        return INVALID_LEVEL_ID;
-    };
-    const auto level = std::min(highest_diffrent_level(phantom_node.forward_segment_id),
-                                highest_diffrent_level(phantom_node.reverse_segment_id));
+    const auto level = getNodeQueryLevel(partition, node, phantom_node);
 
     const auto &node_data = query_heap.GetData(node);
 
@@ -132,18 +190,19 @@ void relaxOutgoingEdges(const DataFacade<mld::Algorithm> &facade,
         const auto &cell = cells.GetCell(metric, level, partition.GetCell(level, node));
         if (DIRECTION == FORWARD_DIRECTION)
         { // Shortcuts in forward direction
-            auto destination = cell.GetDestinationNodes().begin();
-            auto shortcut_durations = cell.GetOutDuration(node);
-            for (auto shortcut_weight : cell.GetOutWeight(node))
-            {
-                BOOST_ASSERT(destination != cell.GetDestinationNodes().end());
-                BOOST_ASSERT(!shortcut_durations.empty());
-                const NodeID to = *destination;
+            const auto destinations = cell.GetDestinationNodes().begin();
+            const auto shortcut_durations = cell.GetOutDuration(node).begin();
+            const auto shortcut_weights = cell.GetOutWeight(node);
+            util::forEachValidWeight(
+                shortcut_weights.begin(), shortcut_weights.size(), [&](const std::size_t index) {
+                    const NodeID to = destinations[index];
+                    if (node == to)
+                    {
+                        return;
+                    }
 
-                if (shortcut_weight != INVALID_EDGE_WEIGHT && node != to)
-                {
-                    const auto to_weight = weight + shortcut_weight;
-                    const auto to_duration = duration + shortcut_durations.front();
+                    const auto to_weight = weight + shortcut_weights[index];
+                    const auto to_duration = duration + shortcut_durations[index];
                     if (!query_heap.WasInserted(to))
                     {
                         query_heap.Insert(to, to_weight, {node, true, to_duration});
@@ -153,14 +212,10 @@ void relaxOutgoingEdges(const DataFacade<mld::Algorithm> &facade,
                         query_heap.GetData(to) = {node, true, to_duration};
                         query_heap.DecreaseKey(to, to_weight);
                     }
-                }
-                ++destination;
-                shortcut_durations.advance_begin(1);
-            }
-            BOOST_ASSERT(shortcut_durations.empty());
+                });
         }
         else
-        { // Shortcuts in backward direction
+        { // Shortcuts in backward direction, the columns are strided and read one by one
             auto source = cell.GetSourceNodes().begin();
             auto shortcut_durations = cell.GetInDuration(node);
             for (auto shortcut_weight : cell.GetInWeight(node))
@@ -232,6 +287,7 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
                         const SearchSpaceWithBuckets &search_space_with_buckets,
                         std::vector<EdgeWeight> &weights_table,
                         std::vector<EdgeWeight> &durations_table,
+                        std::vector<NodeID> &middle_nodes_table,
                         const PhantomNode &phantom_node)
 {
     const NodeID node = query_heap.DeleteMin();
@@ -247,12 +303,19 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
         for (const NodeBucket &current_bucket : bucket_list)
         {
             // get target id from bucket entry
-            const unsigned column_idx = current_bucket.target_id;
+            const unsigned column_idx = current_bucket.column_index;
             const EdgeWeight target_weight = current_bucket.weight;
             const EdgeWeight target_duration = current_bucket.duration;
 
-            auto &current_weight = weights_table[row_idx * number_of_targets + column_idx];
-            auto &current_duration = durations_table[row_idx * number_of_targets + column_idx];
+            const auto entry_idx = row_idx * number_of_targets + column_idx;
+            auto &current_weight = weights_table[entry_idx];
+            auto &current_duration = durations_table[entry_idx];
+
+            // middle nodes are only tracked if the paths need to be unpacked later on
+            const auto update_middle_node = [&] {
+                if (!middle_nodes_table.empty())
+                    middle_nodes_table[entry_idx] = node;
+            };
 
             // check if new weight is better
             auto new_weight = source_weight + target_weight;
@@ -262,12 +325,15 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
             {
                 if (addLoopWeight(facade, node, new_weight, new_duration))
                 {
+                    if (new_weight < current_weight)
+                        update_middle_node();
                     current_weight = std::min(current_weight, new_weight);
                     current_duration = std::min(current_duration, new_duration);
                 }
             }
             else if (new_weight < current_weight)
             {
+                update_middle_node();
                 current_weight = new_weight;
                 current_duration = new_duration;
             }
@@ -287,23 +353,176 @@ void backwardRoutingStep(const DataFacade<Algorithm> &facade,
 {
     const NodeID node = query_heap.DeleteMin();
     const EdgeWeight target_weight = query_heap.GetKey(node);
-    const EdgeWeight target_duration = query_heap.GetData(node).duration;
+    const auto &target_data = query_heap.GetData(node);
 
     // store settled nodes in search space bucket
-    search_space_with_buckets[node].emplace_back(column_idx, target_weight, target_duration);
+    search_space_with_buckets[node].emplace_back(target_data.parent,
+                                                 column_idx,
+                                                 target_weight,
+                                                 target_data.duration,
+                                                 isFromCliqueArc(target_data));
 
     relaxOutgoingEdges<REVERSE_DIRECTION>(
-        facade, node, target_weight, target_duration, query_heap, phantom_node);
+        facade, node, target_weight, target_data.duration, query_heap, phantom_node);
+}
+
+// Traces the path of a table entry from the source to the middle node in the forward heap
+// and from the middle node to the target in the parents stored with the buckets.
+template <typename ManyToManyQueryHeap>
+void retrievePackedPath(const ManyToManyQueryHeap &query_heap,
+                        const SearchSpaceWithBuckets &search_space_with_buckets,
+                        const NodeID middle_node,
+                        const unsigned column_idx,
+                        PackedPath &forward_packed_path,
+                        PackedPath &reverse_packed_path)
+{
+    forward_packed_path.clear();
+    reverse_packed_path.clear();
+
+    NodeID current = middle_node;
+    NodeID parent = query_heap.GetData(current).parent;
+    while (current != parent)
+    {
+        forward_packed_path.emplace_back(
+            parent, current, isFromCliqueArc(query_heap.GetData(current)));
+        current = parent;
+        parent = query_heap.GetData(parent).parent;
+    }
+    std::reverse(forward_packed_path.begin(), forward_packed_path.end());
+
+    const auto &middle_bucket = findBucket(search_space_with_buckets, middle_node, column_idx);
+    if (query_heap.GetKey(middle_node) + middle_bucket.weight < 0)
+    { // the entry was only valid with the CH loop edge at the middle node
+        forward_packed_path.emplace_back(middle_node, middle_node, false);
+    }
+
+    NodeID bucket_node = middle_node;
+    const auto *bucket = &middle_bucket;
+    while (bucket_node != bucket->parent_node)
+    {
+        reverse_packed_path.emplace_back(
+            bucket_node, bucket->parent_node, bucket->from_clique_arc);
+        bucket_node = bucket->parent_node;
+        bucket = &findBucket(search_space_with_buckets, bucket_node, column_idx);
+    }
+}
+
+inline double getPackedPathDistance(SearchEngineData<ch::Algorithm> &,
+                                    const DataFacade<ch::Algorithm> &facade,
+                                    const NodeID middle_node,
+                                    const PackedPath &forward_packed_path,
+                                    const PackedPath &reverse_packed_path,
+                                    const PhantomNode &source_phantom,
+                                    const PhantomNode &target_phantom)
+{
+    std::vector<NodeID> packed_path;
+    packed_path.reserve(forward_packed_path.size() + reverse_packed_path.size() + 1);
+    packed_path.push_back(forward_packed_path.empty() ? middle_node
+                                                      : std::get<0>(forward_packed_path.front()));
+    for (const auto &packed_edge : forward_packed_path)
+        packed_path.push_back(std::get<1>(packed_edge));
+    for (const auto &packed_edge : reverse_packed_path)
+        packed_path.push_back(std::get<1>(packed_edge));
+
+    std::vector<PathData> unpacked_path;
+    ch::unpackPath(facade,
+                   packed_path.begin(),
+                   packed_path.end(),
+                   {source_phantom, target_phantom},
+                   unpacked_path);
+
+    return getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
+}
+
+inline double getPackedPathDistance(SearchEngineData<mld::Algorithm> &engine_working_data,
+                                    const DataFacade<mld::Algorithm> &facade,
+                                    const NodeID middle_node,
+                                    const PackedPath &forward_packed_path,
+                                    const PackedPath &reverse_packed_path,
+                                    const PhantomNode &source_phantom,
+                                    const PhantomNode &target_phantom)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+
+    std::vector<NodeID> unpacked_nodes;
+    std::vector<EdgeID> unpacked_edges;
+    unpacked_nodes.push_back(forward_packed_path.empty()
+                                 ? middle_node
+                                 : std::get<0>(forward_packed_path.front()));
+
+    // Clique arcs are unpacked with the same sub-level search as in mld::search. The level
+    // of an arc is the query level of the node it was relaxed from, which is the tail of the
+    // arc in the forward search and the head of the arc in the backward search.
+    const auto unpack = [&](const PackedPath &packed_path,
+                            const PhantomNode &phantom_node,
+                            const bool forward) {
+        for (const auto &packed_edge : packed_path)
+        {
+            NodeID source, target;
+            bool overlay_edge;
+            std::tie(source, target, overlay_edge) = packed_edge;
+            if (!overlay_edge)
+            { // a base graph edge
+                unpacked_nodes.push_back(target);
+                unpacked_edges.push_back(facade.FindEdge(source, target));
+                continue;
+            }
+
+            const auto level =
+                getNodeQueryLevel(partition, forward ? source : target, phantom_node);
+            const auto parent_cell_id = partition.GetCell(level, source);
+            BOOST_ASSERT(parent_cell_id == partition.GetCell(level, target));
+
+            engine_working_data.InitializeOrClearFirstThreadLocalStorage(
+                facade.GetNumberOfNodes());
+            auto &forward_heap = *engine_working_data.forward_heap_1;
+            auto &reverse_heap = *engine_working_data.reverse_heap_1;
+            forward_heap.Insert(source, 0, {source});
+            reverse_heap.Insert(target, 0, {target});
+
+            std::vector<NodeID> subpath_nodes;
+            std::vector<EdgeID> subpath_edges;
+            std::tie(std::ignore, subpath_nodes, subpath_edges) =
+                mld::search(engine_working_data,
+                            facade,
+                            forward_heap,
+                            reverse_heap,
+                            DO_NOT_FORCE_LOOPS,
+                            DO_NOT_FORCE_LOOPS,
+                            INVALID_EDGE_WEIGHT,
+                            static_cast<LevelID>(level - 1),
+                            parent_cell_id);
+            BOOST_ASSERT(subpath_nodes.size() > 1);
+            BOOST_ASSERT(subpath_nodes.front() == source);
+            BOOST_ASSERT(subpath_nodes.back() == target);
+            unpacked_nodes.insert(
+                unpacked_nodes.end(), std::next(subpath_nodes.begin()), subpath_nodes.end());
+            unpacked_edges.insert(unpacked_edges.end(), subpath_edges.begin(), subpath_edges.end());
+        }
+    };
+    unpack(forward_packed_path, source_phantom, true);
+    unpack(reverse_packed_path, target_phantom, false);
+
+    std::vector<PathData> unpacked_path;
+    annotatePath(
+        facade, {source_phantom, target_phantom}, unpacked_nodes, unpacked_edges, unpacked_path);
+
+    return getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
 }
 }
 
 template <typename Algorithm>
-std::vector<EdgeWeight> manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
-                                         const DataFacade<Algorithm> &facade,
-                                         const std::vector<PhantomNode> &phantom_nodes,
-                                         const std::vector<std::size_t> &source_indices,
-                                         const std::vector<std::size_t> &target_indices)
+std::pair<std::vector<EdgeWeight>, std::vector<double>>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const DataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices,
+                 const bool calculate_distance,
+                 const ManyToManyConcurrency &concurrency)
 {
+    using QueryHeap = typename SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
     const auto number_of_sources =
         source_indices.empty() ? phantom_nodes.size() : source_indices.size();
     const auto number_of_targets =
@@ -312,12 +531,20 @@ std::vector<EdgeWeight> manyToManySearch(SearchEngineData<Algorithm> &engine_wor
 
     std::vector<EdgeWeight> weights_table(number_of_entries, INVALID_EDGE_WEIGHT);
     std::vector<EdgeWeight> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+    std::vector<double> distances_table;
+    std::vector<NodeID> middle_nodes_table;
+    if (calculate_distance)
+    {
+        distances_table.resize(number_of_entries, INVALID_TABLE_DISTANCE);
+        middle_nodes_table.resize(number_of_entries, SPECIAL_NODEID);
+    }
 
     engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(facade.GetNumberOfNodes());
 
     auto &query_heap = *(engine_working_data.many_to_many_heap);
 
     SearchSpaceWithBuckets search_space_with_buckets;
+    std::size_t number_of_buckets = 0;
 
     unsigned column_idx = 0;
     const auto search_target_phantom = [&](const PhantomNode &phantom) {
@@ -329,30 +556,65 @@ std::vector<EdgeWeight> manyToManySearch(SearchEngineData<Algorithm> &engine_wor
         while (!query_heap.Empty())
         {
             backwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets, phantom);
+            ++number_of_buckets;
         }
         ++column_idx;
     };
 
     // for each source do forward search
-    unsigned row_idx = 0;
-    const auto search_source_phantom = [&](const PhantomNode &phantom) {
+    const auto search_source_phantom = [&](QueryHeap &heap, const unsigned row_idx) {
+        const auto &phantom = source_indices.empty() ? phantom_nodes[row_idx]
+                                                     : phantom_nodes[source_indices[row_idx]];
+
         // clear heap and insert source nodes
-        query_heap.Clear();
-        insertSourceInHeap(query_heap, phantom);
+        heap.Clear();
+        insertSourceInHeap(heap, phantom);
 
         // explore search space
-        while (!query_heap.Empty())
+        while (!heap.Empty())
         {
             forwardRoutingStep(facade,
                                row_idx,
                                number_of_targets,
-                               query_heap,
+                               heap,
                                search_space_with_buckets,
                                weights_table,
                                durations_table,
+                               middle_nodes_table,
                                phantom);
         }
-        ++row_idx;
+
+        if (!calculate_distance)
+            return;
+
+        // Distances are not part of the metric, so the paths of all entries of this row are
+        // unpacked while the forward search space is still in the heap.
+        PackedPath forward_packed_path;
+        PackedPath reverse_packed_path;
+        for (const auto column_idx : util::irange<unsigned>(0, number_of_targets))
+        {
+            const auto entry_idx = row_idx * number_of_targets + column_idx;
+            const auto middle_node = middle_nodes_table[entry_idx];
+            if (middle_node == SPECIAL_NODEID)
+                continue;
+
+            const auto &target_phantom = target_indices.empty()
+                                             ? phantom_nodes[column_idx]
+                                             : phantom_nodes[target_indices[column_idx]];
+            retrievePackedPath(heap,
+                               search_space_with_buckets,
+                               middle_node,
+                               column_idx,
+                               forward_packed_path,
+                               reverse_packed_path);
+            distances_table[entry_idx] = getPackedPathDistance(engine_working_data,
+                                                               facade,
+                                                               middle_node,
+                                                               forward_packed_path,
+                                                               reverse_packed_path,
+                                                               phantom,
+                                                               target_phantom);
+        }
     };
 
     if (target_indices.empty())
@@ -371,38 +633,70 @@ std::vector<EdgeWeight> manyToManySearch(SearchEngineData<Algorithm> &engine_wor
         }
     }
 
-    if (source_indices.empty())
+    // The forward search spaces are about as large as the backward ones, so the average
+    // backward search space tells us how much memory each additional heap will need. Heaps
+    // with an array node index also hold an entry for every node of the graph.
+    const auto average_search_space_size =
+        number_of_buckets / std::max<std::size_t>(number_of_targets, 1) + 1;
+    const auto heap_index_memory = QueryHeap::IndexStorageType::GetArrayMemory(
+        facade.GetNumberOfNodes(), engine_working_data.max_heap_index_memory);
+    const auto heap_memory_estimate =
+        average_search_space_size * HEAP_BYTES_PER_SETTLED_NODE + heap_index_memory;
+    const auto number_of_threads =
+        std::min<std::size_t>({std::max<std::size_t>(concurrency.max_threads, 1),
+                               number_of_sources,
+                               concurrency.max_heap_memory / heap_memory_estimate});
+
+    if (number_of_threads <= 1)
     {
-        for (const auto &phantom : phantom_nodes)
+        for (const auto row_idx : util::irange<unsigned>(0, number_of_sources))
         {
-            search_source_phantom(phantom);
+            search_source_phantom(query_heap, row_idx);
         }
     }
     else
     {
-        for (const auto index : source_indices)
-        {
-            const auto &phantom = phantom_nodes[index];
-            search_source_phantom(phantom);
-        }
+        // Every thread of the arena uses its own thread local heap, which is kept for later
+        // requests like all other heaps. The calling thread is done with its heap after the
+        // backward searches. The buckets are only read from here on and every forward search
+        // writes to a different row of the tables.
+        tbb::task_arena arena(static_cast<int>(number_of_threads));
+        arena.execute([&] {
+            tbb::parallel_for(tbb::blocked_range<unsigned>(0, number_of_sources),
+                              [&](const tbb::blocked_range<unsigned> &range) {
+                                  engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                                      facade.GetNumberOfNodes());
+                                  auto &heap = *engine_working_data.many_to_many_heap;
+                                  for (auto row_idx = range.begin(), end = range.end();
+                                       row_idx != end;
+                                       ++row_idx)
+                                  {
+                                      search_source_phantom(heap, row_idx);
+                                  }
+                              });
+        });
     }
 
-    return durations_table;
+    return std::make_pair(std::move(durations_table), std::move(distances_table));
 }
 
-template std::vector<EdgeWeight>
+template std::pair<std::vector<EdgeWeight>, std::vector<double>>
 manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                  const DataFacade<ch::Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
-                 const std::vector<std::size_t> &target_indices);
+                 const std::vector<std::size_t> &target_indices,
+                 const bool calculate_distance,
+                 const ManyToManyConcurrency &concurrency);
 
-template std::vector<EdgeWeight>
+template std::pair<std::vector<EdgeWeight>, std::vector<double>>
 manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                  const DataFacade<mld::Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
-                 const std::vector<std::size_t> &target_indices);
+                 const std::vector<std::size_t> &target_indices,
+                 const bool calculate_distance,
+                 const ManyToManyConcurrency &concurrency);
 
 } // namespace routing_algorithms
 } // namespace engine
@@ -137,6 +137,9 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
     auto &forward_heap = *engine_working_data.forward_heap_1;
     auto &reverse_heap = *engine_working_data.reverse_heap_1;
 
+    std::vector<std::size_t> target_indices;
+    std::vector<PhantomNode> target_phantoms;
+
     std::size_t breakage_begin = map_matching::INVALID_STATE;
     std::vector<std::size_t> split_points;
     std::vector<std::size_t> prev_unbroken_timestamps;
@@ -211,23 +214,42 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                     continue;
                 }
 
+                // Only the transitions to s_prime update current_viterbi[s_prime], so all
+                // candidates that can still be improved are known before the search
+                target_indices.clear();
+                target_phantoms.clear();
                 for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
                 {
                     const double emission_pr = emission_log_probabilities[t][s_prime];
-                    double new_value = prev_viterbi[s] + emission_pr;
-                    if (current_viterbi[s_prime] > new_value)
+                    if (current_viterbi[s_prime] > prev_viterbi[s] + emission_pr)
                     {
                         continue;
                     }
+                    target_indices.push_back(s_prime);
+                    target_phantoms.push_back(current_timestamps_list[s_prime].phantom_node);
+                }
+
+                if (target_indices.empty())
+                {
+                    continue;
+                }
 
-                    double network_distance =
-                        getNetworkDistance(engine_working_data,
-                                           facade,
-                                           forward_heap,
-                                           reverse_heap,
-                                           prev_unbroken_timestamps_list[s].phantom_node,
-                                           current_timestamps_list[s_prime].phantom_node,
-                                           weight_upper_bound);
+                // one search from s to all remaining candidates of this timestamp
+                const auto network_distances =
+                    getNetworkDistances(engine_working_data,
+                                        facade,
+                                        forward_heap,
+                                        reverse_heap,
+                                        prev_unbroken_timestamps_list[s].phantom_node,
+                                        target_phantoms,
+                                        weight_upper_bound);
+
+                for (const auto index : util::irange<std::size_t>(0UL, target_indices.size()))
+                {
+                    const auto s_prime = target_indices[index];
+                    const double emission_pr = emission_log_probabilities[t][s_prime];
+                    double new_value = prev_viterbi[s] + emission_pr;
+                    const double network_distance = network_distances[index];
 
                     // get distance diff between loc1/2 and locs/s_prime
                     const auto d_t = std::abs(network_distance - haversine_distance);
@@ -1,5 +1,7 @@
 #include "engine/routing_algorithms/routing_base_ch.hpp"
 
+#include "util/integer_range.hpp"
+
 namespace osrm
 {
 namespace engine
@@ -190,6 +192,113 @@ double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
 
     return getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
 }
+
+std::vector<double> getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                        const DataFacade<Algorithm> &facade,
+                                        SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                        SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                        const PhantomNode &source_phantom,
+                                        const std::vector<PhantomNode> &target_phantoms,
+                                        EdgeWeight weight_upper_bound)
+{
+    std::vector<double> distances(target_phantoms.size(), std::numeric_limits<double>::max());
+
+    forward_heap.Clear();
+    reverse_heap.Clear();
+
+    insertNodesInHeap<FORWARD_DIRECTION>(forward_heap, source_phantom);
+    if (forward_heap.Empty())
+    {
+        return distances;
+    }
+
+    // Settle the forward search space up to the bound. The reverse heap stays empty, so no
+    // middle node is found here and the search only stops at the bound.
+    const auto min_edge_offset = std::min(0, forward_heap.MinKey());
+    NodeID middle = SPECIAL_NODEID;
+    EdgeWeight weight = weight_upper_bound;
+    while (!forward_heap.Empty())
+    {
+        routingStep<FORWARD_DIRECTION>(facade,
+                                       forward_heap,
+                                       reverse_heap,
+                                       middle,
+                                       weight,
+                                       min_edge_offset,
+                                       DO_NOT_FORCE_LOOPS,
+                                       DO_NOT_FORCE_LOOPS);
+    }
+
+    std::vector<NodeID> packed_path;
+    std::vector<PathData> unpacked_path;
+    for (const auto index : util::irange<std::size_t>(0UL, target_phantoms.size()))
+    {
+        const auto &target_phantom = target_phantoms[index];
+
+        // A target behind the source on the same segment can only be reached with a loop
+        // through the source node, which is handled by the bidirectional search.
+        if (needsLoopForward(source_phantom, target_phantom) ||
+            needsLoopBackwards(source_phantom, target_phantom))
+        {
+            continue;
+        }
+
+        // The reverse search meets the settled forward search space, the forward heap is
+        // only read from here on.
+        reverse_heap.Clear();
+        insertNodesInHeap<REVERSE_DIRECTION>(reverse_heap, target_phantom);
+
+        middle = SPECIAL_NODEID;
+        weight = weight_upper_bound;
+        while (!reverse_heap.Empty())
+        {
+            routingStep<REVERSE_DIRECTION>(facade,
+                                           reverse_heap,
+                                           forward_heap,
+                                           middle,
+                                           weight,
+                                           min_edge_offset,
+                                           DO_NOT_FORCE_LOOPS,
+                                           DO_NOT_FORCE_LOOPS);
+        }
+
+        if (weight_upper_bound <= weight || SPECIAL_NODEID == middle)
+        {
+            continue;
+        }
+
+        packed_path.clear();
+        retrievePackedPathFromHeap(forward_heap, reverse_heap, middle, packed_path);
+
+        unpacked_path.clear();
+        unpackPath(facade,
+                   packed_path.begin(),
+                   packed_path.end(),
+                   {source_phantom, target_phantom},
+                   unpacked_path);
+
+        distances[index] = getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
+    }
+
+    // The loops are rare, they reuse the heaps after all other targets are done
+    for (const auto index : util::irange<std::size_t>(0UL, target_phantoms.size()))
+    {
+        const auto &target_phantom = target_phantoms[index];
+        if (needsLoopForward(source_phantom, target_phantom) ||
+            needsLoopBackwards(source_phantom, target_phantom))
+        {
+            distances[index] = getNetworkDistance(engine_working_data,
+                                                  facade,
+                                                  forward_heap,
+                                                  reverse_heap,
+                                                  source_phantom,
+                                                  target_phantom,
+                                                  weight_upper_bound);
+        }
+    }
+
+    return distances;
+}
 } // namespace ch
 
 namespace corech
@@ -421,6 +530,31 @@ double getNetworkDistance(SearchEngineData<Algorithm> &engine_working_data,
 
     return getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
 }
+
+std::vector<double> getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                        const DataFacade<Algorithm> &facade,
+                                        SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                        SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                        const PhantomNode &source_phantom,
+                                        const std::vector<PhantomNode> &target_phantoms,
+                                        EdgeWeight weight_upper_bound)
+{
+    // The core search needs both heaps to find the core entry points, so there is nothing to
+    // share between the targets
+    std::vector<double> distances;
+    distances.reserve(target_phantoms.size());
+    for (const auto &target_phantom : target_phantoms)
+    {
+        distances.push_back(getNetworkDistance(engine_working_data,
+                                               facade,
+                                               forward_heap,
+                                               reverse_heap,
+                                               source_phantom,
+                                               target_phantom,
+                                               weight_upper_bound));
+    }
+    return distances;
+}
 } // namespace corech
 
 } // namespace routing_algorithms
@@ -23,7 +23,7 @@ void SearchEngineData<CH>::InitializeOrClearFirstThreadLocalStorage(unsigned num
     }
     else
     {
-        forward_heap_1.reset(new QueryHeap(number_of_nodes));
+        forward_heap_1.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 
     if (reverse_heap_1.get())
@@ -32,7 +32,7 @@ void SearchEngineData<CH>::InitializeOrClearFirstThreadLocalStorage(unsigned num
     }
     else
     {
-        reverse_heap_1.reset(new QueryHeap(number_of_nodes));
+        reverse_heap_1.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 
@@ -44,7 +44,7 @@ void SearchEngineData<CH>::InitializeOrClearSecondThreadLocalStorage(unsigned nu
     }
     else
     {
-        forward_heap_2.reset(new QueryHeap(number_of_nodes));
+        forward_heap_2.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 
     if (reverse_heap_2.get())
@@ -53,7 +53,7 @@ void SearchEngineData<CH>::InitializeOrClearSecondThreadLocalStorage(unsigned nu
     }
     else
     {
-        reverse_heap_2.reset(new QueryHeap(number_of_nodes));
+        reverse_heap_2.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 
@@ -65,7 +65,7 @@ void SearchEngineData<CH>::InitializeOrClearThirdThreadLocalStorage(unsigned num
     }
     else
     {
-        forward_heap_3.reset(new QueryHeap(number_of_nodes));
+        forward_heap_3.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 
     if (reverse_heap_3.get())
@@ -74,7 +74,7 @@ void SearchEngineData<CH>::InitializeOrClearThirdThreadLocalStorage(unsigned num
     }
     else
     {
-        reverse_heap_3.reset(new QueryHeap(number_of_nodes));
+        reverse_heap_3.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 
@@ -86,7 +86,7 @@ void SearchEngineData<CH>::InitializeOrClearManyToManyThreadLocalStorage(unsigne
     }
     else
     {
-        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes));
+        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 
@@ -104,7 +104,7 @@ void SearchEngineData<MLD>::InitializeOrClearFirstThreadLocalStorage(unsigned nu
     }
     else
     {
-        forward_heap_1.reset(new QueryHeap(number_of_nodes));
+        forward_heap_1.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 
     if (reverse_heap_1.get())
@@ -113,7 +113,7 @@ void SearchEngineData<MLD>::InitializeOrClearFirstThreadLocalStorage(unsigned nu
     }
     else
     {
-        reverse_heap_1.reset(new QueryHeap(number_of_nodes));
+        reverse_heap_1.reset(new QueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 
@@ -125,7 +125,7 @@ void SearchEngineData<MLD>::InitializeOrClearManyToManyThreadLocalStorage(unsign
     }
     else
     {
-        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes));
+        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes, max_heap_index_memory));
     }
 }
 }
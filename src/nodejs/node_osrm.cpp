@@ -72,6 +72,11 @@ NAN_MODULE_INIT(Engine::Init)
  * @param {Boolean} [options.shared_memory] Connects to the persistent shared memory datastore.
  *        This requires you to run `osrm-datastore` prior to creating an `OSRM` object.
  * @param {String} [options.path] The path to the `.osrm` files. This is mutually exclusive with setting {options.shared_memory} to true.
+ * @param {Boolean} [options.mmap] Maps the data from a memory image (`<path>.memory`) instead of loading it into process memory.
+ *        The image is written on the first start and shared by all processes mapping it. Requires {options.path}.
+ * @param {Object} [options.metrics] Additional metrics as an object of metric names to `.osrm` paths, e.g. `{truck: 'truck/berlin.osrm'}`.
+ *        Every path is a dataset customized from the same partitioned data as {options.path}, only its weights are loaded.
+ *        Queries choose a metric with the `metric` option. Requires {options.path}.
  * @param {Number} [options.max_locations_trip] Max. locations supported in trip query (default: unlimited).
  * @param {Number} [options.max_locations_viaroute] Max. locations supported in viaroute query (default: unlimited).
  * @param {Number} [options.max_locations_distance_table] Max. locations supported in distance table query (default: unlimited).
@@ -110,6 +115,11 @@ NAN_METHOD(Engine::New)
     }
 }
 
+// Services are overloaded for json::Writer and BinaryWriter, the bindings use json::Object
+template <typename ParameterT>
+using ObjectServiceMemFn = osrm::engine::Status (osrm::OSRM::*)(const ParameterT &,
+                                                                  osrm::json::Object &) const;
+
 template <typename ParameterParser, typename ServiceMemFn>
 inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
                   ParameterParser argsToParams,
@@ -216,7 +226,10 @@ inline void async(const Nan::FunctionCallbackInfo<v8::Value> &info,
 // clang-format on
 NAN_METHOD(Engine::route) //
 {
-    async(info, &argumentsToRouteParameter, &osrm::OSRM::Route, true);
+    async(info,
+          &argumentsToRouteParameter,
+          static_cast<ObjectServiceMemFn<osrm::RouteParameters>>(&osrm::OSRM::Route),
+          true);
 }
 
 // clang-format off
@@ -256,13 +269,16 @@ NAN_METHOD(Engine::route) //
 // clang-format on
 NAN_METHOD(Engine::nearest) //
 {
-    async(info, &argumentsToNearestParameter, &osrm::OSRM::Nearest, false);
+    async(info,
+          &argumentsToNearestParameter,
+          static_cast<ObjectServiceMemFn<osrm::NearestParameters>>(&osrm::OSRM::Nearest),
+          false);
 }
 
 // clang-format off
 /**
- * Computes duration tables for the given locations. Allows for both symmetric and asymmetric
- * tables.
+ * Computes duration and optionally distance tables for the given locations. Allows for both
+ * symmetric and asymmetric tables.
  *
  * @name table
  * @memberof OSRM
@@ -278,11 +294,14 @@ NAN_METHOD(Engine::nearest) //
  * @param {Array} [options.destinations] An array of `index` elements (`0 <= integer <
  * #coordinates`) to use location with given index as destination. Default is to use all.
  * @param {Array} [options.approaches] Keep waypoints on curb side. Can be `null` (unrestricted, default) or `curb`.
+ * @param {Array} [options.annotations] An array of the tables to return, `duration` (default) and/or `distance`.
  * @param {Function} callback
  *
- * @returns {Object} containing `durations`, `sources`, and `destinations`.
+ * @returns {Object} containing `durations`, `distances`, `sources`, and `destinations`.
  * **`durations`**: array of arrays that stores the matrix in row-major order. `durations[i][j]` gives the travel time from the i-th waypoint to the j-th waypoint.
- *                  Values are given in seconds.
+ *                  Values are given in seconds. Only returned if `annotations` contains `duration`.
+ * **`distances`**: array of arrays that stores the matrix in row-major order. `distances[i][j]` gives the distance of the fastest route from the i-th waypoint to the j-th waypoint.
+ *                  Values are given in meters. Only returned if `annotations` contains `distance`.
  * **`sources`**: array of [`Ẁaypoint`](#waypoint) objects describing all sources in order.
  * **`destinations`**: array of [`Ẁaypoint`](#waypoint) objects describing all destinations in order.
  *
@@ -304,7 +323,10 @@ NAN_METHOD(Engine::nearest) //
 // clang-format on
 NAN_METHOD(Engine::table) //
 {
-    async(info, &argumentsToTableParameter, &osrm::OSRM::Table, true);
+    async(info,
+          &argumentsToTableParameter,
+          static_cast<ObjectServiceMemFn<osrm::TableParameters>>(&osrm::OSRM::Table),
+          true);
 }
 
 // clang-format off
@@ -389,7 +411,10 @@ NAN_METHOD(Engine::tile)
 // clang-format on
 NAN_METHOD(Engine::match) //
 {
-    async(info, &argumentsToMatchParameter, &osrm::OSRM::Match, true);
+    async(info,
+          &argumentsToMatchParameter,
+          static_cast<ObjectServiceMemFn<osrm::MatchParameters>>(&osrm::OSRM::Match),
+          true);
 }
 
 // clang-format off
@@ -8,6 +8,7 @@
 #include "engine/engine.hpp"
 #include "engine/engine_config.hpp"
 #include "engine/status.hpp"
+#include "util/cache_statistics.hpp"
 
 #include <memory>
 
@@ -105,17 +106,46 @@ engine::Status OSRM::Route(const engine::api::RouteParameters &params,
     return engine_->Route(params, result);
 }
 
+engine::Status OSRM::Route(const engine::api::RouteParameters &params,
+                           engine::api::BinaryWriter &result) const
+{
+    return engine_->Route(params, result);
+}
+
+engine::Status OSRM::Route(const engine::api::RouteParameters &params,
+                           json::Writer &result) const
+{
+    return engine_->Route(params, result);
+}
+
 engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Object &result) const
 {
     return engine_->Table(params, result);
 }
 
+engine::Status OSRM::Table(const engine::api::TableParameters &params,
+                           engine::api::BinaryWriter &result) const
+{
+    return engine_->Table(params, result);
+}
+
+engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Writer &result) const
+{
+    return engine_->Table(params, result);
+}
+
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
     return engine_->Nearest(params, result);
 }
 
+engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
+                             engine::api::BinaryWriter &result) const
+{
+    return engine_->Nearest(params, result);
+}
+
 engine::Status OSRM::Trip(const engine::api::TripParameters &params, json::Object &result) const
 {
     return engine_->Trip(params, result);
@@ -126,9 +156,33 @@ engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Obj
     return engine_->Match(params, result);
 }
 
+engine::Status OSRM::Match(const engine::api::MatchParameters &params,
+                           engine::api::BinaryWriter &result) const
+{
+    return engine_->Match(params, result);
+}
+
+engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Writer &result) const
+{
+    return engine_->Match(params, result);
+}
+
+engine::Status OSRM::Match(const std::vector<engine::api::MatchParameters> &params,
+                           const MatchCallback &callback) const
+{
+    return engine_->Match(params, callback);
+}
+
 engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string &result) const
 {
     return engine_->Tile(params, result);
 }
 
+util::CacheStatistics OSRM::TileCacheStatistics() const { return engine_->TileCacheStatistics(); }
+
+util::CacheStatistics OSRM::ResultCacheStatistics() const
+{
+    return engine_->ResultCacheStatistics();
+}
+
 } // ns osrm
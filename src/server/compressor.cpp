@@ -0,0 +1,147 @@
+#include "server/compressor.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+
+#include <boost/assert.hpp>
+
+#include <string>
+
+namespace osrm
+{
+namespace server
+{
+
+namespace
+{
+// there's a trade-off between speed and size. speed wins
+const constexpr int ZLIB_LEVEL = Z_BEST_SPEED;
+const constexpr int ZLIB_WINDOW_BITS = 15;
+const constexpr int ZLIB_MEMORY_LEVEL = 8;
+// adding 16 to the window bits writes a gzip header and trailer instead of a zlib wrapper
+const constexpr int GZIP_WINDOW_BITS = ZLIB_WINDOW_BITS + 16;
+// negative window bits write raw deflate data
+const constexpr int DEFLATE_WINDOW_BITS = -ZLIB_WINDOW_BITS;
+#ifdef USE_ZSTD_LIBRARY
+const constexpr int ZSTD_LEVEL = 1;
+#endif
+
+void initStream(z_stream &stream, const int window_bits)
+{
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(&stream,
+                     ZLIB_LEVEL,
+                     Z_DEFLATED,
+                     window_bits,
+                     ZLIB_MEMORY_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw util::exception("Could not initialize zlib stream" + SOURCE_REF);
+    }
+}
+}
+
+Compressor::Compressor()
+{
+    initStream(gzip_stream, GZIP_WINDOW_BITS);
+    initStream(deflate_stream, DEFLATE_WINDOW_BITS);
+#ifdef USE_ZSTD_LIBRARY
+    zstd_context = ZSTD_createCCtx();
+    if (zstd_context == nullptr)
+    {
+        throw util::exception("Could not create zstd context" + SOURCE_REF);
+    }
+#endif
+}
+
+Compressor::~Compressor()
+{
+    deflateEnd(&gzip_stream);
+    deflateEnd(&deflate_stream);
+#ifdef USE_ZSTD_LIBRARY
+    ZSTD_freeCCtx(zstd_context);
+#endif
+}
+
+void Compressor::compress(const std::vector<char> &input,
+                          const http::compression_type type,
+                          std::vector<char> &output)
+{
+    switch (type)
+    {
+    case http::gzip_rfc1952:
+        deflate_buffer(gzip_stream, input, output);
+        break;
+    case http::deflate_rfc1951:
+        deflate_buffer(deflate_stream, input, output);
+        break;
+#ifdef USE_ZSTD_LIBRARY
+    case http::zstd:
+    {
+        output.resize(ZSTD_compressBound(input.size()));
+        const auto size = ZSTD_compressCCtx(
+            zstd_context, output.data(), output.size(), input.data(), input.size(), ZSTD_LEVEL);
+        if (ZSTD_isError(size))
+        {
+            throw util::exception(std::string("zstd compression failed: ") +
+                                  ZSTD_getErrorName(size) + SOURCE_REF);
+        }
+        output.resize(size);
+        break;
+    }
+#endif
+    default:
+        BOOST_ASSERT(type == http::no_compression);
+        output = input;
+        break;
+    }
+}
+
+const char *Compressor::content_encoding(const http::compression_type type)
+{
+    switch (type)
+    {
+    case http::gzip_rfc1952:
+        return "gzip";
+    case http::deflate_rfc1951:
+        return "deflate";
+    case http::zstd:
+        return "zstd";
+    default:
+        return "identity";
+    }
+}
+
+Compressor &Compressor::thread_local_instance()
+{
+    static thread_local Compressor compressor;
+    return compressor;
+}
+
+void Compressor::deflate_buffer(z_stream &stream,
+                                const std::vector<char> &input,
+                                std::vector<char> &output)
+{
+    // the bound includes the gzip header and trailer, so a single call finishes the stream
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const auto status = deflate(&stream, Z_FINISH);
+    const auto compressed_size = stream.total_out;
+    // keeps the allocated state for the next reply
+    deflateReset(&stream);
+
+    if (status != Z_STREAM_END)
+    {
+        throw util::exception("zlib compression failed" + SOURCE_REF);
+    }
+    output.resize(compressed_size);
+}
+}
+}
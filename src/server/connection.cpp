@@ -1,11 +1,10 @@
 #include "server/connection.hpp"
+#include "server/compressor.hpp"
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
 
 #include <iterator>
 #include <string>
@@ -16,16 +15,33 @@ namespace osrm
 namespace server
 {
 
-Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+Connection::Connection(boost::asio::io_service &io_service,
+                       RequestHandler &handler,
+                       const unsigned keepalive_timeout,
+                       const unsigned keepalive_max_requests,
+                       const std::size_t compression_min_size)
+    : strand(io_service), TCP_socket(io_service), timer(io_service), request_handler(handler),
+      pipelined_begin(nullptr), pipelined_end(nullptr), keepalive_timeout(keepalive_timeout),
+      keepalive_max_requests(keepalive_max_requests), compression_min_size(compression_min_size),
+      processed_requests(0), keep_alive(false)
 {
 }
 
 boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 
 /// Start the first asynchronous operation for the connection.
-void Connection::start()
+void Connection::start() { async_read(); }
+
+void Connection::async_read()
 {
+    if (keepalive_timeout > 0)
+    {
+        timer.expires_from_now(boost::posix_time::seconds(keepalive_timeout));
+        timer.async_wait(strand.wrap(boost::bind(&Connection::handle_timeout,
+                                                 this->shared_from_this(),
+                                                 boost::asio::placeholders::error)));
+    }
+
     TCP_socket.async_read_some(
         boost::asio::buffer(incoming_data_buffer),
         strand.wrap(boost::bind(&Connection::handle_read,
@@ -36,51 +52,55 @@ void Connection::start()
 
 void Connection::handle_read(const boost::system::error_code &error, std::size_t bytes_transferred)
 {
+    // cancels a pending timeout, a timeout that already fired sees the new expiry time
+    timer.expires_at(boost::posix_time::pos_infin);
+
     if (error)
     {
         return;
     }
 
+    process_buffer(incoming_data_buffer.data(), incoming_data_buffer.data() + bytes_transferred);
+}
+
+void Connection::process_buffer(char *begin, char *end)
+{
     // no error detected, let's parse the request
     http::compression_type compression_type(http::no_compression);
     RequestParser::RequestStatus result;
-    std::tie(result, compression_type) =
-        request_parser.parse(current_request,
-                             incoming_data_buffer.data(),
-                             incoming_data_buffer.data() + bytes_transferred);
+    std::tie(result, compression_type, pipelined_begin) =
+        request_parser.parse(current_request, begin, end);
+    pipelined_end = end;
 
     // the request has been parsed
     if (result == RequestParser::RequestStatus::valid)
     {
+        ++processed_requests;
+        keep_alive = current_request.keep_alive && keepalive_timeout > 0 &&
+                     processed_requests < keepalive_max_requests;
+
         current_request.endpoint = TCP_socket.remote_endpoint().address();
         request_handler.HandleRequest(current_request, current_reply);
+        current_reply.set_keep_alive(
+            keep_alive, keepalive_timeout, keepalive_max_requests - processed_requests);
 
-        // compress the result w/ gzip/deflate if requested
-        switch (compression_type)
+        // compress the result if requested, small replies are not worth the overhead
+        if (compression_type != http::no_compression &&
+            current_reply.content.size() >= compression_min_size)
         {
-        case http::deflate_rfc1951:
-            // use deflate for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "deflate"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+            current_reply.headers.insert(
+                current_reply.headers.begin(),
+                {"Content-Encoding", Compressor::content_encoding(compression_type)});
+            Compressor::thread_local_instance().compress(
+                current_reply.content, compression_type, compressed_output);
+            current_reply.set_size(compressed_output.size());
             output_buffer = current_reply.headers_to_buffers();
             output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::gzip_rfc1952:
-            // use gzip for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "gzip"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::no_compression:
-            // don't use any compression
+        }
+        else
+        {
             current_reply.set_uncompressed_size();
             output_buffer = current_reply.to_buffers();
-            break;
         }
         // write result to stream
         boost::asio::async_write(TCP_socket,
@@ -91,6 +111,7 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     }
     else if (result == RequestParser::RequestStatus::invalid)
     { // request is not parseable
+        keep_alive = false;
         current_reply = http::reply::stock_reply(http::reply::bad_request);
 
         boost::asio::async_write(TCP_socket,
@@ -102,48 +123,58 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     else
     {
         // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        async_read();
     }
 }
 
-/// Handle completion of a write operation.
-void Connection::handle_write(const boost::system::error_code &error)
+void Connection::handle_timeout(const boost::system::error_code &error)
 {
-    if (!error)
+    if (error == boost::asio::error::operation_aborted)
+    {
+        return;
+    }
+
+    // the timer might have been reset after this handler was queued
+    if (timer.expires_at() <= boost::asio::deadline_timer::traits_type::now())
     {
-        // Initiate graceful connection closure.
-        boost::system::error_code ignore_error;
-        TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+        close();
     }
 }
 
-std::vector<char> Connection::compress_buffers(const std::vector<char> &uncompressed_data,
-                                               const http::compression_type compression_type)
+/// Handle completion of a write operation.
+void Connection::handle_write(const boost::system::error_code &error)
 {
-    boost::iostreams::gzip_params compression_parameters;
+    if (error)
+    {
+        return;
+    }
 
-    // there's a trade-off between speed and size. speed wins
-    compression_parameters.level = boost::iostreams::zlib::best_speed;
-    // check which compression flavor is used
-    if (http::deflate_rfc1951 == compression_type)
+    if (!keep_alive)
     {
-        compression_parameters.noheader = true;
+        close();
+        return;
     }
 
-    std::vector<char> compressed_data;
-    // plug data into boost's compression stream
-    boost::iostreams::filtering_ostream gzip_stream;
-    gzip_stream.push(boost::iostreams::gzip_compressor(compression_parameters));
-    gzip_stream.push(boost::iostreams::back_inserter(compressed_data));
-    gzip_stream.write(&uncompressed_data[0], uncompressed_data.size());
-    boost::iostreams::close(gzip_stream);
+    // start over with the next request of a persistent connection
+    request_parser = RequestParser();
+    current_request = http::request();
+    current_reply = http::reply();
 
-    return compressed_data;
+    if (pipelined_begin != pipelined_end)
+    {
+        // pipelined requests are already in the buffer
+        process_buffer(pipelined_begin, pipelined_end);
+    }
+    else
+    {
+        async_read();
+    }
+}
+
+void Connection::close()
+{
+    boost::system::error_code ignore_error;
+    TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
 }
 }
 }
@@ -15,9 +15,9 @@ const char internal_server_error_html[] =
     "{\"code\": \"InternalError\",\"message\":\"Internal Server Error\"}";
 const char seperators[] = {':', ' '};
 const char crlf[] = {'\r', '\n'};
-const std::string http_ok_string = "HTTP/1.0 200 OK\r\n";
-const std::string http_bad_request_string = "HTTP/1.0 400 Bad Request\r\n";
-const std::string http_internal_server_error_string = "HTTP/1.0 500 Internal Server Error\r\n";
+const std::string http_ok_string = "HTTP/1.1 200 OK\r\n";
+const std::string http_bad_request_string = "HTTP/1.1 400 Bad Request\r\n";
+const std::string http_internal_server_error_string = "HTTP/1.1 500 Internal Server Error\r\n";
 
 void reply::set_size(const std::size_t size)
 {
@@ -32,6 +32,25 @@ void reply::set_size(const std::size_t size)
 
 void reply::set_uncompressed_size() { set_size(content.size()); }
 
+void reply::set_keep_alive(const bool keep_alive,
+                           const unsigned timeout,
+                           const unsigned remaining_requests)
+{
+    for (header &h : headers)
+    {
+        if ("Connection" == h.name)
+        {
+            h.value = keep_alive ? "keep-alive" : "close";
+        }
+    }
+    if (keep_alive)
+    {
+        headers.emplace_back("Keep-Alive",
+                             "timeout=" + std::to_string(timeout) + ", max=" +
+                                 std::to_string(remaining_requests));
+    }
+}
+
 std::vector<boost::asio::const_buffer> reply::to_buffers()
 {
     std::vector<boost::asio::const_buffer> buffers;
@@ -105,7 +124,7 @@ boost::asio::const_buffer reply::status_to_buffer(const reply::status_type statu
 
 reply::reply() : status(ok)
 {
-    // We do not currently support keep alive. Always set 'Connection: close'.
+    // Connections are closed unless the connection decides to keep them alive
     headers.emplace_back("Connection", "close");
 }
 }
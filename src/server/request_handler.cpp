@@ -15,6 +15,7 @@
 #include "osrm/osrm.hpp"
 #include "util/json_container.hpp"
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
@@ -65,6 +66,13 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         // check if the was an error with the request
         if (maybe_parsed_url && api_iterator == request_string.end())
         {
+            if (boost::icontains(current_request.accept, "application/x-osrm-binary"))
+            {
+                maybe_parsed_url->default_format =
+                    engine::api::BaseParameters::OutputFormatType::Binary;
+            }
+
+            maybe_parsed_url->body = current_request.body;
 
             const engine::Status status =
                 service_handler->RunQuery(*std::move(maybe_parsed_url), result);
@@ -99,7 +107,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         }
 
         current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
         current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                            "X-Requested-With, Content-Type");
         if (result.is<util::json::Object>())
@@ -110,6 +118,22 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
             util::json::render(current_reply.content, result.get<util::json::Object>());
         }
+        else if (result.is<std::vector<char>>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.json\"");
+
+            current_reply.content.swap(result.get<std::vector<char>>());
+        }
+        else if (result.is<service::BinaryResult>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/x-osrm-binary");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.bin\"");
+
+            current_reply.content.swap(result.get<service::BinaryResult>().buffer);
+        }
         else
         {
             BOOST_ASSERT(result.is<std::string>());
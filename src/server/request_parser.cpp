@@ -5,7 +5,9 @@
 #include "server/http/request.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace osrm
@@ -15,24 +17,39 @@ namespace server
 
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), content_length(0), http_version_major(0),
+      http_version_minor(0)
 {
 }
 
-std::tuple<RequestParser::RequestStatus, http::compression_type>
+std::tuple<RequestParser::RequestStatus, http::compression_type, char *>
 RequestParser::parse(http::request &current_request, char *begin, char *end)
 {
     while (begin != end)
     {
+        if (state == internal_state::body)
+        {
+            // the body is copied in one go instead of character by character
+            const auto missing = content_length - current_request.body.size();
+            const auto available = std::min<std::size_t>(missing, end - begin);
+            current_request.body.append(begin, available);
+            begin += available;
+            if (current_request.body.size() == content_length)
+            {
+                return std::make_tuple(RequestStatus::valid, selected_compression, begin);
+            }
+            continue;
+        }
+
         RequestStatus result = consume(current_request, *begin++);
         if (result != RequestStatus::indeterminate)
         {
-            return std::make_tuple(result, selected_compression);
+            return std::make_tuple(result, selected_compression, begin);
         }
     }
     RequestStatus result = RequestStatus::indeterminate;
 
-    return std::make_tuple(result, selected_compression);
+    return std::make_tuple(result, selected_compression, end);
 }
 
 RequestParser::RequestStatus RequestParser::consume(http::request &current_request,
@@ -116,6 +133,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
     case internal_state::http_version_major_start:
         if (is_digit(input))
         {
+            http_version_major = input - '0';
             state = internal_state::http_version_major;
             return RequestStatus::indeterminate;
         }
@@ -128,12 +146,14 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            http_version_major = http_version_major * 10 + input - '0';
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
     case internal_state::http_version_minor_start:
         if (is_digit(input))
         {
+            http_version_minor = input - '0';
             state = internal_state::http_version_minor;
             return RequestStatus::indeterminate;
         }
@@ -146,12 +166,16 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            http_version_minor = http_version_minor * 10 + input - '0';
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
     case internal_state::expecting_newline_1:
         if (input == '\n')
         {
+            // HTTP/1.1 connections are persistent by default
+            current_request.keep_alive =
+                http_version_major > 1 || (http_version_major == 1 && http_version_minor >= 1);
             state = internal_state::header_line_start;
             return RequestStatus::indeterminate;
         }
@@ -168,6 +192,13 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             {
                 selected_compression = http::gzip_rfc1952;
             }
+#ifdef USE_ZSTD_LIBRARY
+            /* zstd is faster than gzip at a similar ratio */
+            if (boost::icontains(current_header.value, "zstd"))
+            {
+                selected_compression = http::zstd;
+            }
+#endif
         }
 
         if (boost::iequals(current_header.name, "Referer"))
@@ -180,6 +211,39 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.agent = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Accept"))
+        {
+            current_request.accept = current_header.value;
+        }
+
+        if (boost::iequals(current_header.name, "Content-Length"))
+        {
+            try
+            {
+                content_length = boost::lexical_cast<std::size_t>(current_header.value);
+            }
+            catch (const boost::bad_lexical_cast &)
+            {
+                return RequestStatus::invalid;
+            }
+            if (content_length > MAX_CONTENT_LENGTH)
+            {
+                return RequestStatus::invalid;
+            }
+        }
+
+        if (boost::iequals(current_header.name, "Connection"))
+        {
+            if (boost::icontains(current_header.value, "close"))
+            {
+                current_request.keep_alive = false;
+            }
+            else if (boost::icontains(current_header.value, "keep-alive"))
+            {
+                current_request.keep_alive = true;
+            }
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -248,7 +312,18 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         return RequestStatus::invalid;
     default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length > 0)
+        {
+            // parse() reads the body
+            state = internal_state::body;
+            current_request.body.reserve(content_length);
+            return RequestStatus::indeterminate;
+        }
+        return RequestStatus::valid;
     }
 }
 
@@ -2,12 +2,21 @@
 
 #include "server/api/parameters_parser.hpp"
 #include "server/service/utils.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/match_parameters.hpp"
 
+#include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+#include "util/string_util.hpp"
 
 #include <boost/format.hpp>
 
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
 namespace osrm
 {
 namespace server
@@ -39,10 +48,14 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
 
     return help;
 }
+
+const constexpr char BATCH_QUERY[] = "batch";
 } // anon. ns
 
-engine::Status
-MatchService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status MatchService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      const OutputFormatType format,
+                                      ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -68,7 +81,124 @@ MatchService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Match(*parameters, json_result);
+    if (parameters->format.get_value_or(format) == OutputFormatType::Binary)
+    {
+        result = BinaryResult();
+        engine::api::BinaryWriter writer(result.get<BinaryResult>().buffer);
+        return BaseService::routing_machine.Match(*parameters, writer);
+    }
+
+    // the response is rendered straight into the reply buffer
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    return BaseService::routing_machine.Match(*parameters, writer);
+}
+
+engine::Status MatchService::RunBodyQuery(std::size_t prefix_length,
+                                          std::string &query,
+                                          const OutputFormatType format,
+                                          const std::string &body,
+                                          ResultT &result)
+{
+    if (query != BATCH_QUERY)
+    {
+        return RunQuery(prefix_length, query, format, result);
+    }
+
+    // Every line holds a trace in the same form as a GET request after the profile, e.g.
+    // {coordinates}?timestamps=...
+    std::vector<engine::api::MatchParameters> batch;
+    std::vector<std::size_t> batch_traces;
+    std::vector<util::json::Object> invalid_traces;
+    std::vector<std::size_t> invalid_trace_indices;
+
+    std::istringstream lines(body);
+    std::string line;
+    std::size_t trace = 0;
+    while (std::getline(lines, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::string trace_query;
+        util::URIDecode(line, trace_query);
+
+        util::json::Object error;
+        auto query_iterator = trace_query.begin();
+        auto parameters =
+            api::parseParameters<engine::api::MatchParameters>(query_iterator, trace_query.end());
+        if (!parameters || query_iterator != trace_query.end())
+        {
+            const auto position = std::distance(trace_query.begin(), query_iterator);
+            error.values["code"] = "InvalidQuery";
+            error.values["message"] = "Query string malformed close to position " +
+                                      std::to_string(position);
+        }
+        else if (!parameters->IsValid())
+        {
+            error.values["code"] = "InvalidOptions";
+            error.values["message"] = getWrongOptionHelp(*parameters);
+        }
+
+        if (error.values.empty())
+        {
+            batch.push_back(*std::move(parameters));
+            batch_traces.push_back(trace);
+        }
+        else
+        {
+            invalid_traces.push_back(std::move(error));
+            invalid_trace_indices.push_back(trace);
+        }
+        ++trace;
+    }
+
+    if (trace == 0)
+    {
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] = "Batch request needs at least one trace.";
+        return engine::Status::Error;
+    }
+
+    // Responses are written in the order the traces finish, the "trace" member refers to the
+    // line of the trace in the request body.
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    writer.StartObject();
+    writer.Key("code");
+    writer.String("Ok");
+    writer.Key("traces");
+    writer.StartArray();
+
+    const auto write_trace = [&writer](const std::size_t index, util::json::Object &response) {
+        response.values["trace"] = util::json::Number(index);
+        writer.Value(response);
+    };
+
+    for (const auto index : util::irange<std::size_t>(0UL, invalid_traces.size()))
+    {
+        write_trace(invalid_trace_indices[index], invalid_traces[index]);
+    }
+
+    BaseService::routing_machine.Match(
+        batch,
+        [&](const std::size_t index, const engine::Status, util::json::Object &response) {
+            write_trace(batch_traces[index], response);
+        });
+
+    writer.EndArray();
+    writer.EndObject();
+
+    // failed traces are reported in their own responses
+    return engine::Status::Ok;
 }
 }
 }
@@ -2,6 +2,7 @@
 #include "server/service/utils.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/nearest_parameters.hpp"
 
 #include "util/json_container.hpp"
@@ -35,8 +36,10 @@ std::string getWrongOptionHelp(const engine::api::NearestParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status NearestService::RunQuery(std::size_t prefix_length,
+                                        std::string &query,
+                                        const OutputFormatType format,
+                                        ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -62,6 +65,13 @@ NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format.get_value_or(format) == OutputFormatType::Binary)
+    {
+        result = BinaryResult();
+        engine::api::BinaryWriter writer(result.get<BinaryResult>().buffer);
+        return BaseService::routing_machine.Nearest(*parameters, writer);
+    }
+
     return BaseService::routing_machine.Nearest(*parameters, json_result);
 }
 }
@@ -2,9 +2,11 @@
 #include "server/service/utils.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/route_parameters.hpp"
 
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
 
 namespace osrm
 {
@@ -39,8 +41,10 @@ std::string getWrongOptionHelp(const engine::api::RouteParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-RouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status RouteService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      const OutputFormatType format,
+                                      ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -66,7 +70,17 @@ RouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Route(*parameters, json_result);
+    if (parameters->format.get_value_or(format) == OutputFormatType::Binary)
+    {
+        result = BinaryResult();
+        engine::api::BinaryWriter writer(result.get<BinaryResult>().buffer);
+        return BaseService::routing_machine.Route(*parameters, writer);
+    }
+
+    // the response is rendered straight into the reply buffer
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    return BaseService::routing_machine.Route(*parameters, writer);
 }
 }
 }
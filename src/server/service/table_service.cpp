@@ -1,9 +1,11 @@
 #include "server/service/table_service.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "engine/api/binary_writer.hpp"
 #include "engine/api/table_parameters.hpp"
 
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/format.hpp>
 
@@ -60,8 +62,10 @@ std::string getWrongOptionHelp(const engine::api::TableParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TableService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      const OutputFormatType format,
+                                      ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -87,7 +91,17 @@ TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Table(*parameters, json_result);
+    if (parameters->format.get_value_or(format) == OutputFormatType::Binary)
+    {
+        result = BinaryResult();
+        engine::api::BinaryWriter writer(result.get<BinaryResult>().buffer);
+        return BaseService::routing_machine.Table(*parameters, writer);
+    }
+
+    // the response is rendered straight into the reply buffer
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    return BaseService::routing_machine.Table(*parameters, writer);
 }
 }
 }
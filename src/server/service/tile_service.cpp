@@ -15,7 +15,10 @@ namespace server
 namespace service
 {
 
-engine::Status TileService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TileService::RunQuery(std::size_t prefix_length,
+                                     std::string &query,
+                                     const OutputFormatType,
+                                     ResultT &result)
 {
     auto query_iterator = query.begin();
     auto parameters =
@@ -41,7 +41,10 @@ std::string getWrongOptionHelp(const engine::api::TripParameters &parameters)
 }
 } // anon. ns
 
-engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TripService::RunQuery(std::size_t prefix_length,
+                                     std::string &query,
+                                     const OutputFormatType format,
+                                     ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -69,6 +72,14 @@ engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &que
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    // a default format from the Accept header falls back to JSON
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::Binary)
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = "The trip service only supports JSON responses";
+        return engine::Status::Error;
+    }
+
     return BaseService::routing_machine.Trip(*parameters, json_result);
 }
 }
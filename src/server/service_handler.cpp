@@ -49,7 +49,17 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
         return engine::Status::Error;
     }
 
-    return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result);
+    if (!parsed_url.body.empty())
+    {
+        return service->RunBodyQuery(parsed_url.prefix_length,
+                                     parsed_url.query,
+                                     parsed_url.default_format,
+                                     parsed_url.body,
+                                     result);
+    }
+
+    return service->RunQuery(
+        parsed_url.prefix_length, parsed_url.query, parsed_url.default_format, result);
 }
 }
 }
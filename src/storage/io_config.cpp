@@ -24,5 +24,22 @@ bool IOConfig::IsValid() const
     }
     return success;
 }
+
+std::vector<boost::filesystem::path> IOConfig::GetExistingInputPaths() const
+{
+    std::vector<boost::filesystem::path> paths;
+    for (const auto *files : {&required_input_files, &optional_input_files})
+    {
+        for (const auto &fileName : *files)
+        {
+            boost::filesystem::path path{base_path.string() + fileName.string()};
+            if (boost::filesystem::is_regular_file(path))
+            {
+                paths.push_back(std::move(path));
+            }
+        }
+    }
+    return paths;
+}
 }
 }
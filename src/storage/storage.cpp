@@ -34,11 +34,13 @@
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
+#include "util/integer_range.hpp"
 #include "util/log.hpp"
 #include "util/packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 #include "util/vector_view.hpp"
 
@@ -52,6 +54,10 @@
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 
+#include <tbb/parallel_invoke.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
 #include <cstdint>
 
 #include <fstream>
@@ -59,6 +65,7 @@
 #include <iterator>
 #include <new>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -74,9 +81,68 @@ using EdgeBasedGraph = util::StaticGraph<extractor::EdgeBasedEdge::EdgeData>;
 
 using Monitor = SharedMonitor<SharedDataTimestamp>;
 
+namespace
+{
+// guards the throughput against loads that finish within the timer resolution
+const constexpr double MIN_LOAD_SECONDS = 0.000001;
+
+bool isMetricRegion(const SharedDataType region)
+{
+    return region == REGION_3 || region == REGION_4;
+}
+
+// Reads a data file into its blocks on the task group and reports the throughput when done.
+// Every file fills its own blocks of the layout, so the files are read concurrently.
+template <typename Load>
+void loadFile(tbb::task_group &loading, const boost::filesystem::path &path, Load load)
+{
+    loading.run([path, load] {
+        TIMER_START(load_file);
+        load();
+        TIMER_STOP(load_file);
+
+        const auto megabytes = boost::filesystem::file_size(path) / (1024. * 1024.);
+        util::Log() << "Loaded " << path.filename().string() << ": " << megabytes << " MB in "
+                    << TIMER_SEC(load_file) << "s ("
+                    << megabytes / std::max(TIMER_SEC(load_file), MIN_LOAD_SECONDS) << " MB/s)";
+    });
+}
+}
+
+SharedDataType
+getNextRegion(SharedDataType in_use_region, SharedDataType in_use_base_region, bool only_metric)
+{
+    if (only_metric)
+    {
+        if (in_use_base_region == REGION_NONE)
+        {
+            throw util::exception("Metric updates need a dataset loaded by a full update" +
+                                  SOURCE_REF);
+        }
+        return in_use_region == REGION_3 ? REGION_4 : REGION_3;
+    }
+    return in_use_base_region == REGION_1 ? REGION_2 : REGION_1;
+}
+
+std::vector<SharedDataType> getRetiredRegions(SharedDataType in_use_region,
+                                              SharedDataType in_use_base_region,
+                                              bool only_metric)
+{
+    std::vector<SharedDataType> retired_regions;
+    if (in_use_region != REGION_NONE && (!only_metric || in_use_region != in_use_base_region))
+    {
+        retired_regions.push_back(in_use_region);
+    }
+    if (!only_metric && in_use_base_region != REGION_NONE && in_use_base_region != in_use_region)
+    {
+        retired_regions.push_back(in_use_base_region);
+    }
+    return retired_regions;
+}
+
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
 
-int Storage::Run(int max_wait)
+int Storage::Run(int max_wait, bool only_metric, bool use_huge_pages)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -114,8 +180,25 @@ int Storage::Run(int max_wait)
     Monitor monitor(SharedDataTimestamp{REGION_NONE, 0});
     auto in_use_region = monitor.data().region;
     auto next_timestamp = monitor.data().timestamp + 1;
-    auto next_region =
-        in_use_region == REGION_2 || in_use_region == REGION_NONE ? REGION_1 : REGION_2;
+
+    // The full region the data in use is based on
+    auto in_use_base_region = in_use_region;
+    if (isMetricRegion(in_use_region))
+    {
+        in_use_base_region = REGION_NONE;
+        if (storage::SharedMemory::RegionExists(in_use_region))
+        {
+            auto in_use_memory = makeSharedMemory(in_use_region);
+            in_use_base_region = static_cast<const DataLayout *>(in_use_memory->Ptr())->base_region;
+        }
+    }
+    if (in_use_base_region != REGION_NONE &&
+        !storage::SharedMemory::RegionExists(in_use_base_region))
+    {
+        in_use_base_region = REGION_NONE;
+    }
+
+    const auto next_region = getNextRegion(in_use_region, in_use_base_region, only_metric);
 
     // ensure that the shared memory region we want to write to is really removed
     // this is only needef for failure recovery because we actually wait for all clients
@@ -135,15 +218,41 @@ int Storage::Run(int max_wait)
     DataLayout layout;
     PopulateLayout(layout);
 
+    if (only_metric)
+    {
+        // Only the metric blocks are loaded, all others are shared with the base region
+        layout.base_region = in_use_base_region;
+
+        auto base_memory = makeSharedMemory(in_use_base_region);
+        const auto &base_layout = *static_cast<const DataLayout *>(base_memory->Ptr());
+        const auto mismatch = FindBaseMismatch(
+            layout, base_layout, static_cast<char *>(base_memory->Ptr()) + sizeof(DataLayout));
+        if (mismatch != DataLayout::NUM_BLOCKS)
+        {
+            throw util::exception("Block " + std::string(block_id_to_name[mismatch]) +
+                                  " differs from the data in " +
+                                  regionToString(in_use_base_region) +
+                                  ", the static data needs a full update" + SOURCE_REF);
+        }
+        util::Log() << "Sharing static data with " << regionToString(in_use_base_region);
+    }
+
     // Allocate shared memory block
     auto regions_size = sizeof(layout) + layout.GetSizeOfLayout();
     util::Log() << "Allocating shared memory of " << regions_size << " bytes";
-    auto data_memory = makeSharedMemory(next_region, regions_size);
+    auto data_memory = makeSharedMemory(next_region, regions_size, use_huge_pages);
 
     // Copy memory layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(data_memory->Ptr());
     memcpy(shared_memory_ptr, &layout, sizeof(layout));
-    PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    if (only_metric)
+    {
+        PopulateUpdatableData(layout, shared_memory_ptr + sizeof(layout));
+    }
+    else
+    {
+        PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    }
 
     { // Lock for write access shared region mutex
         boost::interprocess::scoped_lock<Monitor::mutex_type> lock(monitor.get_mutex(),
@@ -160,6 +269,7 @@ int Storage::Run(int max_wait)
                        "attached processes will not receive notifications and must be restarted";
                 Monitor::remove();
                 in_use_region = REGION_NONE;
+                in_use_base_region = REGION_NONE;
                 monitor = Monitor(SharedDataTimestamp{REGION_NONE, 0});
             }
         }
@@ -177,22 +287,29 @@ int Storage::Run(int max_wait)
                 << regionToString(next_region) << " with timestamp " << next_timestamp;
     monitor.notify_all();
 
+    const auto old_regions = getRetiredRegions(in_use_region, in_use_base_region, only_metric);
+
     // SHMCTL(2): Mark the segment to be destroyed. The segment will actually be destroyed
     // only after the last process detaches it.
-    if (in_use_region != REGION_NONE && storage::SharedMemory::RegionExists(in_use_region))
+    for (const auto old_region : old_regions)
     {
+        if (!storage::SharedMemory::RegionExists(old_region))
+        {
+            continue;
+        }
+
         util::UnbufferedLog() << "Marking old shared memory region "
-                              << regionToString(in_use_region) << " for removal... ";
+                              << regionToString(old_region) << " for removal... ";
 
         // aquire a handle for the old shared memory region before we mark it for deletion
         // we will need this to wait for all users to detach
-        auto in_use_shared_memory = makeSharedMemory(in_use_region);
+        auto old_shared_memory = makeSharedMemory(old_region);
 
-        storage::SharedMemory::Remove(in_use_region);
+        storage::SharedMemory::Remove(old_region);
         util::UnbufferedLog() << "ok.";
 
         util::UnbufferedLog() << "Waiting for clients to detach... ";
-        in_use_shared_memory->WaitForDetach();
+        old_shared_memory->WaitForDetach();
         util::UnbufferedLog() << " ok.";
     }
 
@@ -558,36 +675,22 @@ void Storage::PopulateLayout(DataLayout &layout)
 }
 
 void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
+{
+    TIMER_START(populate);
+    tbb::parallel_invoke([&] { PopulateStaticData(layout, memory_ptr); },
+                         [&] { PopulateUpdatableData(layout, memory_ptr); });
+    TIMER_STOP(populate);
+
+    const auto megabytes = layout.GetSizeOfLayout() / (1024. * 1024.);
+    util::Log() << "Loaded " << megabytes << " MB of data in " << TIMER_SEC(populate) << "s ("
+                << megabytes / std::max(TIMER_SEC(populate), MIN_LOAD_SECONDS) << " MB/s)";
+}
+
+void Storage::PopulateStaticData(const DataLayout &layout, char *memory_ptr)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
 
-    // read actual data into shared memory object //
-
-    // Load the HSGR file
-    if (boost::filesystem::exists(config.GetPath(".osrm.hsgr")))
-    {
-        auto graph_nodes_ptr = layout.GetBlockPtr<contractor::QueryGraphView::NodeArrayEntry, true>(
-            memory_ptr, storage::DataLayout::CH_GRAPH_NODE_LIST);
-        auto graph_edges_ptr = layout.GetBlockPtr<contractor::QueryGraphView::EdgeArrayEntry, true>(
-            memory_ptr, storage::DataLayout::CH_GRAPH_EDGE_LIST);
-        auto checksum = layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
-
-        util::vector_view<contractor::QueryGraphView::NodeArrayEntry> node_list(
-            graph_nodes_ptr, layout.num_entries[storage::DataLayout::CH_GRAPH_NODE_LIST]);
-        util::vector_view<contractor::QueryGraphView::EdgeArrayEntry> edge_list(
-            graph_edges_ptr, layout.num_entries[storage::DataLayout::CH_GRAPH_EDGE_LIST]);
-
-        contractor::QueryGraphView graph_view(std::move(node_list), std::move(edge_list));
-        contractor::files::readGraph(config.GetPath(".osrm.hsgr"), *checksum, graph_view);
-    }
-    else
-    {
-        layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
-        layout.GetBlockPtr<contractor::QueryGraphView::NodeArrayEntry, true>(
-            memory_ptr, DataLayout::CH_GRAPH_NODE_LIST);
-        layout.GetBlockPtr<contractor::QueryGraphView::EdgeArrayEntry, true>(
-            memory_ptr, DataLayout::CH_GRAPH_EDGE_LIST);
-    }
+    tbb::task_group loading;
 
     // store the filename of the on-disk portion of the RTree
     {
@@ -606,7 +709,7 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
     }
 
     // Name data
-    {
+    loadFile(loading, config.GetPath(".osrm.names"), [&] {
         io::FileReader name_file(config.GetPath(".osrm.names"), io::FileReader::VerifyFingerprint);
         std::size_t name_file_size = name_file.GetSize();
 
@@ -615,10 +718,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::NAME_CHAR_DATA);
 
         name_file.ReadInto<char>(name_char_ptr, name_file_size);
-    }
+    });
 
     // Turn lane data
-    {
+    loadFile(loading, config.GetPath(".osrm.tld"), [&] {
         io::FileReader lane_data_file(config.GetPath(".osrm.tld"),
                                       io::FileReader::VerifyFingerprint);
 
@@ -631,10 +734,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(lane_tuple_count * sizeof(util::guidance::LaneTupleIdPair) ==
                      layout.GetBlockSize(DataLayout::TURN_LANE_DATA));
         lane_data_file.ReadInto(turn_lane_data_ptr, lane_tuple_count);
-    }
+    });
 
     // Turn lane descriptions
-    {
+    loadFile(loading, config.GetPath(".osrm.tls"), [&] {
         auto offsets_ptr = layout.GetBlockPtr<std::uint32_t, true>(
             memory_ptr, storage::DataLayout::LANE_DESCRIPTION_OFFSETS);
         util::vector_view<std::uint32_t> offsets(
@@ -646,10 +749,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             masks_ptr, layout.num_entries[storage::DataLayout::LANE_DESCRIPTION_MASKS]);
 
         extractor::files::readTurnLaneDescriptions(config.GetPath(".osrm.tls"), offsets, masks);
-    }
+    });
 
     // Load edge-based nodes data
-    {
+    loadFile(loading, config.GetPath(".osrm.ebg_nodes"), [&] {
         auto geometry_id_list_ptr =
             layout.GetBlockPtr<GeometryID, true>(memory_ptr, storage::DataLayout::GEOMETRY_ID_LIST);
         util::vector_view<GeometryID> geometry_ids(
@@ -682,10 +785,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                                    std::move(classes));
 
         extractor::files::readNodeData(config.GetPath(".osrm.ebg_nodes"), node_data);
-    }
+    });
 
     // Load original edge data
-    {
+    loadFile(loading, config.GetPath(".osrm.edges"), [&] {
         const auto lane_data_id_ptr =
             layout.GetBlockPtr<LaneDataID, true>(memory_ptr, storage::DataLayout::LANE_DATA_ID);
         util::vector_view<LaneDataID> lane_data_ids(
@@ -719,90 +822,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                           std::move(post_turn_bearings));
 
         extractor::files::readTurnData(config.GetPath(".osrm.edges"), turn_data);
-    }
-
-    // load compressed geometry
-    {
-        auto geometries_index_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, storage::DataLayout::GEOMETRIES_INDEX);
-        util::vector_view<unsigned> geometry_begin_indices(
-            geometries_index_ptr, layout.num_entries[storage::DataLayout::GEOMETRIES_INDEX]);
-
-        auto num_entries = layout.num_entries[storage::DataLayout::GEOMETRIES_NODE_LIST];
-
-        auto geometries_node_list_ptr =
-            layout.GetBlockPtr<NodeID, true>(memory_ptr, storage::DataLayout::GEOMETRIES_NODE_LIST);
-        util::vector_view<NodeID> geometry_node_list(geometries_node_list_ptr, num_entries);
-
-        auto geometries_fwd_weight_list_ptr =
-            layout.GetBlockPtr<extractor::SegmentDataView::SegmentWeightVector::block_type, true>(
-                memory_ptr, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
-        extractor::SegmentDataView::SegmentWeightVector geometry_fwd_weight_list(
-            util::vector_view<extractor::SegmentDataView::SegmentWeightVector::block_type>(
-                geometries_fwd_weight_list_ptr,
-                layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]),
-            num_entries);
-
-        auto geometries_rev_weight_list_ptr =
-            layout.GetBlockPtr<extractor::SegmentDataView::SegmentWeightVector::block_type, true>(
-                memory_ptr, storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
-        extractor::SegmentDataView::SegmentWeightVector geometry_rev_weight_list(
-            util::vector_view<extractor::SegmentDataView::SegmentWeightVector::block_type>(
-                geometries_rev_weight_list_ptr,
-                layout.num_entries[storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST]),
-            num_entries);
-
-        auto geometries_fwd_duration_list_ptr =
-            layout.GetBlockPtr<extractor::SegmentDataView::SegmentDurationVector::block_type, true>(
-                memory_ptr, storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST);
-        extractor::SegmentDataView::SegmentDurationVector geometry_fwd_duration_list(
-            util::vector_view<extractor::SegmentDataView::SegmentDurationVector::block_type>(
-                geometries_fwd_duration_list_ptr,
-                layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST]),
-            num_entries);
-
-        auto geometries_rev_duration_list_ptr =
-            layout.GetBlockPtr<extractor::SegmentDataView::SegmentDurationVector::block_type, true>(
-                memory_ptr, storage::DataLayout::GEOMETRIES_REV_DURATION_LIST);
-        extractor::SegmentDataView::SegmentDurationVector geometry_rev_duration_list(
-            util::vector_view<extractor::SegmentDataView::SegmentDurationVector::block_type>(
-                geometries_rev_duration_list_ptr,
-                layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DURATION_LIST]),
-            num_entries);
-
-        auto geometries_fwd_datasources_list_ptr = layout.GetBlockPtr<DatasourceID, true>(
-            memory_ptr, storage::DataLayout::GEOMETRIES_FWD_DATASOURCES_LIST);
-        util::vector_view<DatasourceID> geometry_fwd_datasources_list(
-            geometries_fwd_datasources_list_ptr,
-            layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DATASOURCES_LIST]);
-
-        auto geometries_rev_datasources_list_ptr = layout.GetBlockPtr<DatasourceID, true>(
-            memory_ptr, storage::DataLayout::GEOMETRIES_REV_DATASOURCES_LIST);
-        util::vector_view<DatasourceID> geometry_rev_datasources_list(
-            geometries_rev_datasources_list_ptr,
-            layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DATASOURCES_LIST]);
-
-        extractor::SegmentDataView segment_data{std::move(geometry_begin_indices),
-                                                std::move(geometry_node_list),
-                                                std::move(geometry_fwd_weight_list),
-                                                std::move(geometry_rev_weight_list),
-                                                std::move(geometry_fwd_duration_list),
-                                                std::move(geometry_rev_duration_list),
-                                                std::move(geometry_fwd_datasources_list),
-                                                std::move(geometry_rev_datasources_list)};
-
-        extractor::files::readSegmentData(config.GetPath(".osrm.geometry"), segment_data);
-    }
-
-    {
-        const auto datasources_names_ptr = layout.GetBlockPtr<extractor::Datasources, true>(
-            memory_ptr, DataLayout::DATASOURCES_NAMES);
-        extractor::files::readDatasources(config.GetPath(".osrm.datasource_names"),
-                                          *datasources_names_ptr);
-    }
+    });
 
     // Loading list of coordinates
-    {
+    loadFile(loading, config.GetPath(".osrm.nbg_nodes"), [&] {
         const auto coordinates_ptr =
             layout.GetBlockPtr<util::Coordinate, true>(memory_ptr, DataLayout::COORDINATE_LIST);
         const auto osmnodeid_ptr =
@@ -816,30 +839,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.num_entries[DataLayout::COORDINATE_LIST]);
 
         extractor::files::readNodes(config.GetPath(".osrm.nbg_nodes"), coordinates, osm_node_ids);
-    }
-
-    // load turn weight penalties
-    {
-        io::FileReader turn_weight_penalties_file(config.GetPath(".osrm.turn_weight_penalties"),
-                                                  io::FileReader::VerifyFingerprint);
-        const auto number_of_penalties = turn_weight_penalties_file.ReadElementCount64();
-        const auto turn_weight_penalties_ptr =
-            layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_WEIGHT_PENALTIES);
-        turn_weight_penalties_file.ReadInto(turn_weight_penalties_ptr, number_of_penalties);
-    }
-
-    // load turn duration penalties
-    {
-        io::FileReader turn_duration_penalties_file(config.GetPath(".osrm.turn_duration_penalties"),
-                                                    io::FileReader::VerifyFingerprint);
-        const auto number_of_penalties = turn_duration_penalties_file.ReadElementCount64();
-        const auto turn_duration_penalties_ptr =
-            layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_DURATION_PENALTIES);
-        turn_duration_penalties_file.ReadInto(turn_duration_penalties_ptr, number_of_penalties);
-    }
+    });
 
     // store timestamp
-    {
+    loadFile(loading, config.GetPath(".osrm.timestamp"), [&] {
         io::FileReader timestamp_file(config.GetPath(".osrm.timestamp"),
                                       io::FileReader::VerifyFingerprint);
         const auto timestamp_size = timestamp_file.GetSize();
@@ -848,10 +851,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::TIMESTAMP);
         BOOST_ASSERT(timestamp_size == layout.num_entries[DataLayout::TIMESTAMP]);
         timestamp_file.ReadInto(timestamp_ptr, timestamp_size);
-    }
+    });
 
     // store search tree portion of rtree
-    {
+    loadFile(loading, config.GetPath(".osrm.ramIndex"), [&] {
         io::FileReader tree_node_file(config.GetPath(".osrm.ramIndex"),
                                       io::FileReader::VerifyFingerprint);
         // perform this read so that we're at the right stream position for the next
@@ -868,28 +871,18 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
 
         tree_node_file.ReadInto(rtree_levelsizes_ptr,
                                 layout.num_entries[DataLayout::R_SEARCH_TREE_LEVELS]);
-    }
-
-    if (boost::filesystem::exists(config.GetPath(".osrm.core")))
-    {
-        auto core_marker_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, storage::DataLayout::CH_CORE_MARKER);
-        util::vector_view<bool> is_core_node(
-            core_marker_ptr, layout.num_entries[storage::DataLayout::CH_CORE_MARKER]);
-
-        contractor::files::readCoreMarker(config.GetPath(".osrm.core"), is_core_node);
-    }
+    });
 
     // load profile properties
-    {
+    loadFile(loading, config.GetPath(".osrm.properties"), [&] {
         const auto profile_properties_ptr = layout.GetBlockPtr<extractor::ProfileProperties, true>(
             memory_ptr, DataLayout::PROPERTIES);
         extractor::files::readProfileProperties(config.GetPath(".osrm.properties"),
                                                 *profile_properties_ptr);
-    }
+    });
 
     // Load intersection data
-    {
+    loadFile(loading, config.GetPath(".osrm.icd"), [&] {
         auto bearing_class_id_ptr = layout.GetBlockPtr<BearingClassID, true>(
             memory_ptr, storage::DataLayout::BEARING_CLASSID);
         util::vector_view<BearingClassID> bearing_class_id(
@@ -923,12 +916,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
 
         extractor::files::readIntersections(
             config.GetPath(".osrm.icd"), intersection_bearings_view, entry_classes);
-    }
+    });
 
+    // Loading MLD Data
+    if (boost::filesystem::exists(config.GetPath(".osrm.partition")))
     {
-        // Loading MLD Data
-        if (boost::filesystem::exists(config.GetPath(".osrm.partition")))
-        {
+        loadFile(loading, config.GetPath(".osrm.partition"), [&] {
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_LEVEL_DATA) > 0);
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_CELL_TO_CHILDREN) > 0);
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_PARTITION) > 0);
@@ -952,10 +945,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             partition::MultiLevelPartitionView mlp{
                 std::move(level_data), std::move(partition), std::move(cell_to_children)};
             partition::files::readPartition(config.GetPath(".osrm.partition"), mlp);
-        }
+        });
+    }
 
-        if (boost::filesystem::exists(config.GetPath(".osrm.cells")))
-        {
+    if (boost::filesystem::exists(config.GetPath(".osrm.cells")))
+    {
+        loadFile(loading, config.GetPath(".osrm.cells"), [&] {
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_CELLS) > 0);
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_CELL_LEVEL_OFFSETS) > 0);
 
@@ -990,10 +985,182 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                                std::move(cells),
                                                std::move(level_offsets)};
             partition::files::readCells(config.GetPath(".osrm.cells"), storage);
-        }
+        });
+    }
 
-        if (boost::filesystem::exists(config.GetPath(".osrm.cell_metrics")))
+    loading.wait();
+}
+
+void Storage::PopulateUpdatableData(const DataLayout &layout, char *memory_ptr)
+{
+    BOOST_ASSERT(memory_ptr != nullptr);
+
+    tbb::task_group loading;
+
+    // Load the HSGR file
+    if (boost::filesystem::exists(config.GetPath(".osrm.hsgr")))
+    {
+        loadFile(loading, config.GetPath(".osrm.hsgr"), [&] {
+            auto graph_nodes_ptr =
+                layout.GetBlockPtr<contractor::QueryGraphView::NodeArrayEntry, true>(
+                    memory_ptr, storage::DataLayout::CH_GRAPH_NODE_LIST);
+            auto graph_edges_ptr =
+                layout.GetBlockPtr<contractor::QueryGraphView::EdgeArrayEntry, true>(
+                    memory_ptr, storage::DataLayout::CH_GRAPH_EDGE_LIST);
+            auto checksum =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
+
+            util::vector_view<contractor::QueryGraphView::NodeArrayEntry> node_list(
+                graph_nodes_ptr, layout.num_entries[storage::DataLayout::CH_GRAPH_NODE_LIST]);
+            util::vector_view<contractor::QueryGraphView::EdgeArrayEntry> edge_list(
+                graph_edges_ptr, layout.num_entries[storage::DataLayout::CH_GRAPH_EDGE_LIST]);
+
+            contractor::QueryGraphView graph_view(std::move(node_list), std::move(edge_list));
+            contractor::files::readGraph(config.GetPath(".osrm.hsgr"), *checksum, graph_view);
+        });
+    }
+    else
+    {
+        layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
+        layout.GetBlockPtr<contractor::QueryGraphView::NodeArrayEntry, true>(
+            memory_ptr, DataLayout::CH_GRAPH_NODE_LIST);
+        layout.GetBlockPtr<contractor::QueryGraphView::EdgeArrayEntry, true>(
+            memory_ptr, DataLayout::CH_GRAPH_EDGE_LIST);
+    }
+
+    // load compressed geometry
+    loadFile(loading, config.GetPath(".osrm.geometry"), [&] {
+        // The index and node list are static, metric updates share them with the base region
+        // and only read them into temporary storage.
+        std::vector<unsigned> base_geometry_begin_indices;
+        std::vector<NodeID> base_geometry_node_list;
+
+        auto num_entries = layout.num_entries[storage::DataLayout::GEOMETRIES_NODE_LIST];
+
+        unsigned *geometries_index_ptr;
+        NodeID *geometries_node_list_ptr;
+        if (layout.IsInBaseRegion(storage::DataLayout::GEOMETRIES_INDEX))
         {
+            base_geometry_begin_indices.resize(
+                layout.num_entries[storage::DataLayout::GEOMETRIES_INDEX]);
+            base_geometry_node_list.resize(num_entries);
+            geometries_index_ptr = base_geometry_begin_indices.data();
+            geometries_node_list_ptr = base_geometry_node_list.data();
+        }
+        else
+        {
+            geometries_index_ptr = layout.GetBlockPtr<unsigned, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_INDEX);
+            geometries_node_list_ptr = layout.GetBlockPtr<NodeID, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_NODE_LIST);
+        }
+        util::vector_view<unsigned> geometry_begin_indices(
+            geometries_index_ptr, layout.num_entries[storage::DataLayout::GEOMETRIES_INDEX]);
+        util::vector_view<NodeID> geometry_node_list(geometries_node_list_ptr, num_entries);
+
+        auto geometries_fwd_weight_list_ptr =
+            layout.GetBlockPtr<extractor::SegmentDataView::SegmentWeightVector::block_type, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
+        extractor::SegmentDataView::SegmentWeightVector geometry_fwd_weight_list(
+            util::vector_view<extractor::SegmentDataView::SegmentWeightVector::block_type>(
+                geometries_fwd_weight_list_ptr,
+                layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]),
+            num_entries);
+
+        auto geometries_rev_weight_list_ptr =
+            layout.GetBlockPtr<extractor::SegmentDataView::SegmentWeightVector::block_type, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
+        extractor::SegmentDataView::SegmentWeightVector geometry_rev_weight_list(
+            util::vector_view<extractor::SegmentDataView::SegmentWeightVector::block_type>(
+                geometries_rev_weight_list_ptr,
+                layout.num_entries[storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST]),
+            num_entries);
+
+        auto geometries_fwd_duration_list_ptr =
+            layout.GetBlockPtr<extractor::SegmentDataView::SegmentDurationVector::block_type, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST);
+        extractor::SegmentDataView::SegmentDurationVector geometry_fwd_duration_list(
+            util::vector_view<extractor::SegmentDataView::SegmentDurationVector::block_type>(
+                geometries_fwd_duration_list_ptr,
+                layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST]),
+            num_entries);
+
+        auto geometries_rev_duration_list_ptr =
+            layout.GetBlockPtr<extractor::SegmentDataView::SegmentDurationVector::block_type, true>(
+                memory_ptr, storage::DataLayout::GEOMETRIES_REV_DURATION_LIST);
+        extractor::SegmentDataView::SegmentDurationVector geometry_rev_duration_list(
+            util::vector_view<extractor::SegmentDataView::SegmentDurationVector::block_type>(
+                geometries_rev_duration_list_ptr,
+                layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DURATION_LIST]),
+            num_entries);
+
+        auto geometries_fwd_datasources_list_ptr = layout.GetBlockPtr<DatasourceID, true>(
+            memory_ptr, storage::DataLayout::GEOMETRIES_FWD_DATASOURCES_LIST);
+        util::vector_view<DatasourceID> geometry_fwd_datasources_list(
+            geometries_fwd_datasources_list_ptr,
+            layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DATASOURCES_LIST]);
+
+        auto geometries_rev_datasources_list_ptr = layout.GetBlockPtr<DatasourceID, true>(
+            memory_ptr, storage::DataLayout::GEOMETRIES_REV_DATASOURCES_LIST);
+        util::vector_view<DatasourceID> geometry_rev_datasources_list(
+            geometries_rev_datasources_list_ptr,
+            layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DATASOURCES_LIST]);
+
+        extractor::SegmentDataView segment_data{std::move(geometry_begin_indices),
+                                                std::move(geometry_node_list),
+                                                std::move(geometry_fwd_weight_list),
+                                                std::move(geometry_rev_weight_list),
+                                                std::move(geometry_fwd_duration_list),
+                                                std::move(geometry_rev_duration_list),
+                                                std::move(geometry_fwd_datasources_list),
+                                                std::move(geometry_rev_datasources_list)};
+
+        extractor::files::readSegmentData(config.GetPath(".osrm.geometry"), segment_data);
+    });
+
+    loadFile(loading, config.GetPath(".osrm.datasource_names"), [&] {
+        const auto datasources_names_ptr = layout.GetBlockPtr<extractor::Datasources, true>(
+            memory_ptr, DataLayout::DATASOURCES_NAMES);
+        extractor::files::readDatasources(config.GetPath(".osrm.datasource_names"),
+                                          *datasources_names_ptr);
+    });
+
+    // load turn weight penalties
+    loadFile(loading, config.GetPath(".osrm.turn_weight_penalties"), [&] {
+        io::FileReader turn_weight_penalties_file(config.GetPath(".osrm.turn_weight_penalties"),
+                                                  io::FileReader::VerifyFingerprint);
+        const auto number_of_penalties = turn_weight_penalties_file.ReadElementCount64();
+        const auto turn_weight_penalties_ptr =
+            layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_WEIGHT_PENALTIES);
+        turn_weight_penalties_file.ReadInto(turn_weight_penalties_ptr, number_of_penalties);
+    });
+
+    // load turn duration penalties
+    loadFile(loading, config.GetPath(".osrm.turn_duration_penalties"), [&] {
+        io::FileReader turn_duration_penalties_file(config.GetPath(".osrm.turn_duration_penalties"),
+                                                    io::FileReader::VerifyFingerprint);
+        const auto number_of_penalties = turn_duration_penalties_file.ReadElementCount64();
+        const auto turn_duration_penalties_ptr =
+            layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_DURATION_PENALTIES);
+        turn_duration_penalties_file.ReadInto(turn_duration_penalties_ptr, number_of_penalties);
+    });
+
+    if (boost::filesystem::exists(config.GetPath(".osrm.core")))
+    {
+        loadFile(loading, config.GetPath(".osrm.core"), [&] {
+            auto core_marker_ptr =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, storage::DataLayout::CH_CORE_MARKER);
+            util::vector_view<bool> is_core_node(
+                core_marker_ptr, layout.num_entries[storage::DataLayout::CH_CORE_MARKER]);
+
+            contractor::files::readCoreMarker(config.GetPath(".osrm.core"), is_core_node);
+        });
+    }
+
+    // Loading MLD metrics and graph
+    if (boost::filesystem::exists(config.GetPath(".osrm.cell_metrics")))
+    {
+        loadFile(loading, config.GetPath(".osrm.cell_metrics"), [&] {
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_CELLS) > 0);
             BOOST_ASSERT(layout.GetBlockSize(storage::DataLayout::MLD_CELL_LEVEL_OFFSETS) > 0);
 
@@ -1021,11 +1188,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             }
 
             customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
-        }
-
-        if (boost::filesystem::exists(config.GetPath(".osrm.mldgr")))
-        {
+        });
+    }
 
+    if (boost::filesystem::exists(config.GetPath(".osrm.mldgr")))
+    {
+        loadFile(loading, config.GetPath(".osrm.mldgr"), [&] {
             auto graph_nodes_ptr =
                 layout.GetBlockPtr<customizer::MultiLevelEdgeBasedGraphView::NodeArrayEntry, true>(
                     memory_ptr, storage::DataLayout::MLD_GRAPH_NODE_LIST);
@@ -1047,8 +1215,36 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             customizer::MultiLevelEdgeBasedGraphView graph_view(
                 std::move(node_list), std::move(edge_list), std::move(node_to_offset));
             partition::files::readGraph(config.GetPath(".osrm.mldgr"), graph_view);
-        }
+        });
+    }
+
+    loading.wait();
+}
+
+DataLayout::BlockID Storage::FindBaseMismatch(const DataLayout &layout,
+                                              const DataLayout &base_layout,
+                                              char *base_memory) const
+{
+    const auto mismatch = layout.FindBaseMismatch(base_layout);
+    if (mismatch != DataLayout::NUM_BLOCKS)
+    {
+        return mismatch;
+    }
+
+    // Equally sized blocks can still come from another extract, e.g. of newer OSM data
+    io::FileReader timestamp_file(config.GetPath(".osrm.timestamp"),
+                                  io::FileReader::VerifyFingerprint);
+    std::vector<char> timestamp(timestamp_file.GetSize());
+    timestamp_file.ReadInto(timestamp);
+
+    const auto base_timestamp = base_layout.GetBlockPtr<char>(base_memory, DataLayout::TIMESTAMP);
+    if (timestamp.size() != base_layout.GetBlockSize(DataLayout::TIMESTAMP) ||
+        !std::equal(timestamp.begin(), timestamp.end(), base_timestamp))
+    {
+        return DataLayout::TIMESTAMP;
     }
+
+    return DataLayout::NUM_BLOCKS;
 }
 }
 }
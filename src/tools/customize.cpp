@@ -24,6 +24,8 @@ enum class return_code : unsigned
 return_code
 parseArguments(int argc, char *argv[], customizer::CustomizationConfig &customization_config)
 {
+    std::string engine;
+
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
     generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
@@ -36,6 +38,15 @@ parseArguments(int argc, char *argv[], customizer::CustomizationConfig &customiz
          boost::program_options::value<unsigned int>(&customization_config.requested_num_threads)
              ->default_value(tbb::task_scheduler_init::default_num_threads()),
          "Number of threads to use")(
+            "incremental",
+            boost::program_options::bool_switch(&customization_config.incremental)
+                ->default_value(false),
+            "Only customize the cells affected by weights that changed since the last run, "
+            "falls back to a full customization if its results are missing or outdated")(
+            "engine",
+            boost::program_options::value<std::string>(&engine)->default_value("dijkstra"),
+            "Customization of the cells above the first level: dijkstra (a search per boundary "
+            "node) or min-plus (Floyd-Warshall over the sub-cell boundaries, for small cells)")(
             "segment-speed-file",
             boost::program_options::value<std::vector<std::string>>(
                 &customization_config.updater_config.segment_speed_lookup_paths)
@@ -124,6 +135,21 @@ parseArguments(int argc, char *argv[], customizer::CustomizationConfig &customiz
         return return_code::fail;
     }
 
+    if (engine == "dijkstra")
+    {
+        customization_config.engine = customizer::CustomizationEngine::Dijkstra;
+    }
+    else if (engine == "min-plus")
+    {
+        customization_config.engine = customizer::CustomizationEngine::MinPlus;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown customization engine " << engine
+                            << ", expected dijkstra or min-plus";
+        return return_code::fail;
+    }
+
     return return_code::ok;
 }
 
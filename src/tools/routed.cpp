@@ -26,6 +26,7 @@
 #include <new>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 boost::function0<void> console_ctrl_function;
@@ -72,7 +73,15 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              std::string &ip_address,
                                              int &ip_port,
                                              int &requested_num_threads,
+                                             int &keepalive_timeout,
+                                             int &keepalive_max_requests,
+                                             bool &sharded_server,
+                                             int &compression_min_size,
                                              bool &use_shared_memory,
+                                             bool &use_mmap,
+                                             boost::filesystem::path &memory_image_path,
+                                             bool &use_huge_pages,
+                                             std::vector<std::string> &metrics,
                                              std::string &algorithm,
                                              bool &trial,
                                              int &max_locations_trip,
@@ -80,7 +89,15 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
                                              int &max_results_nearest,
-                                             int &max_alternatives)
+                                             int &max_alternatives,
+                                             int &max_alternative_threads,
+                                             int &max_table_threads,
+                                             int &max_table_memory,
+                                             int &max_match_threads,
+                                             int &max_trip_threads,
+                                             int &max_heap_index_memory,
+                                             int &max_tile_cache_memory,
+                                             int &max_result_cache_memory)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -103,9 +120,36 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("threads,t",
          value<int>(&requested_num_threads)->default_value(8),
          "Number of threads to use") //
+        ("keepalive-timeout",
+         value<int>(&keepalive_timeout)->default_value(5),
+         "Seconds an idle persistent connection is kept open (0 disables keep-alive)") //
+        ("keepalive-requests",
+         value<int>(&keepalive_max_requests)->default_value(512),
+         "Max. number of requests served over one persistent connection") //
+        ("reuseport-sharding",
+         value<bool>(&sharded_server)->implicit_value(true)->default_value(false),
+         "Give every thread its own event loop and SO_REUSEPORT acceptor") //
+        ("compression-min-size",
+         value<int>(&compression_min_size)->default_value(1024),
+         "Min. size in bytes of a response that is compressed if the client accepts it") //
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("mmap",
+         value<bool>(&use_mmap)->implicit_value(true)->default_value(false),
+         "Map the data from a memory image (<base>.osrm.memory, written on the first start) "
+         "instead of loading it into process memory") //
+        ("mmap-image",
+         value<boost::filesystem::path>(&memory_image_path),
+         "Path of the memory image of --mmap, if <base>.osrm.memory can't be written") //
+        ("huge-pages",
+         value<bool>(&use_huge_pages)->implicit_value(true)->default_value(false),
+         "Back the data loaded into process memory with huge pages (reserved ones if "
+         "available, transparent huge pages otherwise)") //
+        ("metric",
+         value<std::vector<std::string>>(&metrics)->composing(),
+         "Additional metric <name>=<base.osrm>, a dataset customized from the same partitioned "
+         "data. Requests choose it with metric=<name>. Can be repeated.") //
         ("algorithm,a",
          value<std::string>(&algorithm)->default_value("CH"),
          "Algorithm to use for the data. Can be CH, CoreCH, MLD.") //
@@ -126,7 +170,33 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. results supported in nearest query") //
         ("max-alternatives",
          value<int>(&max_alternatives)->default_value(3),
-         "Max. number of alternatives supported in the MLD route query");
+         "Max. number of alternatives supported in the MLD route query") //
+        ("max-alternative-threads",
+         value<int>(&max_alternative_threads)->default_value(1),
+         "Max. number of threads used by a single MLD route query with alternatives") //
+        ("max-table-threads",
+         value<int>(&max_table_threads)->default_value(1),
+         "Max. number of threads used by a single distance table query") //
+        ("max-table-memory",
+         value<int>(&max_table_memory)->default_value(-1),
+         "Max. memory in MiB for the search heaps of a single distance table query (-1 for "
+         "unlimited)") //
+        ("max-match-threads",
+         value<int>(&max_match_threads)->default_value(1),
+         "Max. number of threads used by a single batch map matching query") //
+        ("max-trip-threads",
+         value<int>(&max_trip_threads)->default_value(1),
+         "Max. number of threads used by a single trip query") //
+        ("max-heap-index-memory",
+         value<int>(&max_heap_index_memory)->default_value(0),
+         "Max. memory in MiB for the array node index of a search heap, heaps on larger graphs "
+         "use a hash map (0 always uses a hash map)") //
+        ("max-tile-cache-memory",
+         value<int>(&max_tile_cache_memory)->default_value(0),
+         "Max. memory in MiB for caching encoded vector tiles (0 disables the cache)") //
+        ("max-result-cache-memory",
+         value<int>(&max_result_cache_memory)->default_value(0),
+         "Max. memory in MiB for caching route and table responses (0 disables the cache)");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -199,10 +269,13 @@ int main(int argc, const char *argv[]) try
 
     bool trial_run = false;
     std::string ip_address;
-    int ip_port, requested_thread_num;
+    int ip_port, requested_thread_num, keepalive_timeout, keepalive_max_requests;
+    int compression_min_size;
+    bool sharded_server = false;
 
     EngineConfig config;
     boost::filesystem::path base_path;
+    std::vector<std::string> metrics;
     std::string algorithm;
     const unsigned init_result = generateServerProgramOptions(argc,
                                                               argv,
@@ -210,7 +283,15 @@ int main(int argc, const char *argv[]) try
                                                               ip_address,
                                                               ip_port,
                                                               requested_thread_num,
+                                                              keepalive_timeout,
+                                                              keepalive_max_requests,
+                                                              sharded_server,
+                                                              compression_min_size,
                                                               config.use_shared_memory,
+                                                              config.use_mmap,
+                                                              config.memory_image_path,
+                                                              config.use_huge_pages,
+                                                              metrics,
                                                               algorithm,
                                                               trial_run,
                                                               config.max_locations_trip,
@@ -218,7 +299,15 @@ int main(int argc, const char *argv[]) try
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
                                                               config.max_results_nearest,
-                                                              config.max_alternatives);
+                                                              config.max_alternatives,
+                                                              config.max_alternative_threads,
+                                                              config.max_table_threads,
+                                                              config.max_table_memory,
+                                                              config.max_match_threads,
+                                                              config.max_trip_threads,
+                                                              config.max_heap_index_memory,
+                                                              config.max_tile_cache_memory,
+                                                              config.max_result_cache_memory);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -236,12 +325,52 @@ int main(int argc, const char *argv[]) try
         util::Log(logERROR) << "Required files are missing, cannot continue";
         return EXIT_FAILURE;
     }
+    for (const auto &metric : metrics)
+    {
+        const auto separator = metric.find('=');
+        if (separator == std::string::npos || separator == 0 || separator + 1 == metric.size())
+        {
+            util::Log(logERROR) << "Invalid metric " << metric << ", expected <name>=<base.osrm>";
+            return EXIT_FAILURE;
+        }
+        const auto name = metric.substr(0, separator);
+        config.metrics[name] = storage::StorageConfig(metric.substr(separator + 1));
+        if (!config.metrics[name].IsValid())
+        {
+            util::Log(logERROR) << "Required files of metric " << name << " are missing";
+            return EXIT_FAILURE;
+        }
+    }
+    if (keepalive_timeout < 0 || keepalive_max_requests < 1)
+    {
+        util::Log(logERROR) << "Invalid keep-alive settings";
+        return EXIT_FAILURE;
+    }
+    if (compression_min_size < 0)
+    {
+        util::Log(logERROR) << "Invalid compression threshold";
+        return EXIT_FAILURE;
+    }
     if (!config.IsValid())
     {
         if (base_path.empty() != config.use_shared_memory)
         {
             util::Log(logWARNING) << "Path settings and shared memory conflicts.";
         }
+        if (config.use_shared_memory && config.use_mmap)
+        {
+            util::Log(logWARNING) << "Shared memory and memory image settings conflict.";
+        }
+        if (config.use_huge_pages && (config.use_shared_memory || config.use_mmap))
+        {
+            util::Log(logWARNING) << "Huge pages only back data loaded into process memory, "
+                                     "use osrm-datastore --huge-pages for shared memory.";
+        }
+        if (config.use_shared_memory && !config.metrics.empty())
+        {
+            util::Log(logWARNING) << "Metrics can only be loaded next to a dataset loaded from "
+                                     "files, not with shared memory.";
+        }
         return EXIT_FAILURE;
     }
     config.algorithm = stringToAlgorithm(algorithm);
@@ -252,10 +381,25 @@ int main(int argc, const char *argv[]) try
     {
         util::Log() << "Loading from shared memory";
     }
+    else if (config.use_mmap)
+    {
+        util::Log() << "Loading from memory image";
+    }
+    else if (config.use_huge_pages)
+    {
+        util::Log() << "Loading into huge pages";
+    }
+    for (const auto &name_and_config : config.metrics)
+    {
+        util::Log() << "Metric " << name_and_config.first << ": "
+                    << name_and_config.second.base_path;
+    }
 
     util::Log() << "Threads: " << requested_thread_num;
     util::Log() << "IP address: " << ip_address;
     util::Log() << "IP port: " << ip_port;
+    util::Log() << "Keep-alive: " << keepalive_timeout << "s, " << keepalive_max_requests
+                << " requests";
 
 #ifndef _WIN32
     int sig = 0;
@@ -266,7 +410,14 @@ int main(int argc, const char *argv[]) try
 #endif
 
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto routing_server =
+        server::Server::CreateServer(ip_address,
+                                     ip_port,
+                                     requested_thread_num,
+                                     static_cast<unsigned>(keepalive_timeout),
+                                     static_cast<unsigned>(keepalive_max_requests),
+                                     sharded_server,
+                                     static_cast<std::size_t>(compression_min_size));
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
 
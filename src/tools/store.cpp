@@ -45,6 +45,8 @@ void springClean()
     {
         deleteRegion(storage::REGION_1);
         deleteRegion(storage::REGION_2);
+        deleteRegion(storage::REGION_3);
+        deleteRegion(storage::REGION_4);
         removeLocks();
     }
 }
@@ -53,7 +55,9 @@ void springClean()
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              bool &only_metric,
+                              bool &use_huge_pages)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -67,7 +71,19 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()("max-wait",
                                  boost::program_options::value<int>(&max_wait)->default_value(-1),
                                  "Maximum number of seconds to wait on a running data update "
-                                 "before aquiring the lock by force.");
+                                 "before aquiring the lock by force.")(
+        "only-metric",
+        boost::program_options::value<bool>(&only_metric)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Only load the data changed by osrm-contract or osrm-customize and share all other data "
+        "with the dataset in use.")(
+        "huge-pages",
+        boost::program_options::value<bool>(&use_huge_pages)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Back the shared memory with huge pages (reserved ones if available, transparent huge "
+        "pages otherwise).");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -159,7 +175,9 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    bool only_metric = false;
+    bool use_huge_pages = false;
+    if (!generateDataStoreOptions(argc, argv, base_path, max_wait, only_metric, use_huge_pages))
     {
         return EXIT_SUCCESS;
     }
@@ -171,7 +189,7 @@ int main(const int argc, const char *argv[]) try
     }
     storage::Storage storage(std::move(config));
 
-    return storage.Run(max_wait);
+    return storage.Run(max_wait, only_metric, use_huge_pages);
 }
 catch (const osrm::RuntimeError &e)
 {
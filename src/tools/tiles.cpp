@@ -0,0 +1,693 @@
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+#include "util/percent.hpp"
+#include "util/timing_util.hpp"
+#include "util/vector_tile.hpp"
+#include "util/version.hpp"
+#include "util/web_mercator.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/exception.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+#include "osrm/storage_config.hpp"
+#include "osrm/tile_parameters.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/program_options.hpp>
+
+#include <protozero/pbf_reader.hpp>
+
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <zlib.h>
+
+#ifdef USE_SQLITE3_LIBRARY
+#include <sqlite3.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+enum class OutputFormat
+{
+    Directory,
+    MBTiles
+};
+
+// Zoom levels served by the tile plugin, see TileParameters::IsValid
+const constexpr unsigned MIN_ZOOM = 12;
+const constexpr unsigned MAX_ZOOM = 19;
+
+struct TilesConfig
+{
+    EngineConfig engine_config;
+    boost::filesystem::path output_path;
+    OutputFormat format = OutputFormat::Directory;
+    util::FloatCoordinate south_west;
+    util::FloatCoordinate north_east;
+    unsigned min_zoom = MIN_ZOOM;
+    unsigned max_zoom = MAX_ZOOM;
+    unsigned requested_num_threads = 1;
+};
+
+// Tiles of one zoom level that cover the bounding box
+struct TileRange
+{
+    unsigned z;
+    unsigned min_x;
+    unsigned max_x;
+    unsigned min_y;
+    unsigned max_y;
+
+    std::uint64_t NumberOfTiles() const
+    {
+        return std::uint64_t{max_x - min_x + 1} * std::uint64_t{max_y - min_y + 1};
+    }
+};
+
+TileRange getTileRange(const util::FloatCoordinate south_west,
+                       const util::FloatCoordinate north_east,
+                       const unsigned z)
+{
+    const auto max_index = (1u << z) - 1;
+    const auto toIndex = [max_index](const double pixel) {
+        const auto index = std::floor(pixel / util::web_mercator::TILE_SIZE);
+        return static_cast<unsigned>(std::min<double>(std::max(index, 0.), max_index));
+    };
+
+    // tile rows count from the north
+    return TileRange{z,
+                     toIndex(util::web_mercator::degreeToPixel(south_west.lon, z)),
+                     toIndex(util::web_mercator::degreeToPixel(north_east.lon, z)),
+                     toIndex(util::web_mercator::degreeToPixel(north_east.lat, z)),
+                     toIndex(util::web_mercator::degreeToPixel(south_west.lat, z))};
+}
+
+// Tiles without roads still contain the empty layers, they are not written
+bool hasFeatures(const std::string &tile)
+{
+    protozero::pbf_reader tile_message(tile);
+    while (tile_message.next(util::vector_tile::LAYER_TAG))
+    {
+        protozero::pbf_reader layer_message = tile_message.get_message();
+        if (layer_message.next(util::vector_tile::FEATURE_TAG))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+class TileWriter
+{
+  public:
+    virtual ~TileWriter() = default;
+
+    // Converts a rendered tile into the stored format, called concurrently
+    virtual std::string Encode(std::string tile) const { return tile; }
+    virtual void Write(const unsigned z,
+                       const unsigned x,
+                       const unsigned y,
+                       const std::string &data) = 0;
+    virtual void Finish() {}
+};
+
+// Writes <output>/<z>/<x>/<y>.mvt like the /tile service returns them
+class DirectoryWriter final : public TileWriter
+{
+  public:
+    DirectoryWriter(const boost::filesystem::path &root) : root(root) {}
+
+    void Write(const unsigned z,
+               const unsigned x,
+               const unsigned y,
+               const std::string &data) override final
+    {
+        const auto directory = root / std::to_string(z) / std::to_string(x);
+        boost::filesystem::create_directories(directory);
+
+        const auto path = directory / (std::to_string(y) + ".mvt");
+        boost::filesystem::ofstream out(path, std::ios::binary);
+        out.write(data.data(), data.size());
+        if (!out)
+        {
+            throw util::exception("Could not write " + path.string() + SOURCE_REF);
+        }
+    }
+
+  private:
+    const boost::filesystem::path root;
+};
+
+#ifdef USE_SQLITE3_LIBRARY
+std::vector<std::pair<std::string, std::string>> makeMetadata(const TilesConfig &config)
+{
+    const auto min_lon = static_cast<double>(config.south_west.lon);
+    const auto min_lat = static_cast<double>(config.south_west.lat);
+    const auto max_lon = static_cast<double>(config.north_east.lon);
+    const auto max_lat = static_cast<double>(config.north_east.lat);
+
+    std::ostringstream bounds;
+    bounds.precision(7);
+    bounds << std::fixed << min_lon << "," << min_lat << "," << max_lon << "," << max_lat;
+    std::ostringstream center;
+    center.precision(7);
+    center << std::fixed << (min_lon + max_lon) / 2 << "," << (min_lat + max_lat) / 2 << ","
+           << config.min_zoom;
+
+    // the layers written by the tile plugin
+    const std::string json =
+        R"({"vector_layers":[)"
+        R"({"id":"speeds","fields":{"speed":"Number","is_small":"Boolean",)"
+        R"("datasource":"String","weight":"Number","duration":"Number","name":"String",)"
+        R"("rate":"Number"}},)"
+        R"({"id":"turns","fields":{"bearing_in":"Number","turn_angle":"Number",)"
+        R"("cost":"Number","weight":"Number"}},)"
+        R"({"id":"osmnodes","fields":{}}]})";
+
+    return {{"name", config.engine_config.storage_config.base_path.stem().string()},
+            {"format", "pbf"},
+            {"type", "overlay"},
+            {"version", "1"},
+            {"description", "OSRM debug tiles " OSRM_VERSION},
+            {"bounds", bounds.str()},
+            {"center", center.str()},
+            {"minzoom", std::to_string(config.min_zoom)},
+            {"maxzoom", std::to_string(config.max_zoom)},
+            {"json", json}};
+}
+
+// Writes an MBTiles 1.3 file, vector tiles are stored gzip compressed and rows are flipped to
+// the TMS scheme
+class MBTilesWriter final : public TileWriter
+{
+  public:
+    MBTilesWriter(const boost::filesystem::path &path,
+                  const std::vector<std::pair<std::string, std::string>> &metadata)
+        : database(nullptr, sqlite3_close), insert_tile(nullptr, sqlite3_finalize)
+    {
+        boost::filesystem::remove(path);
+
+        sqlite3 *handle = nullptr;
+        const auto result = sqlite3_open(path.string().c_str(), &handle);
+        database.reset(handle);
+        Check(result, "Could not open " + path.string());
+
+        Execute("PRAGMA synchronous = OFF");
+        Execute("CREATE TABLE metadata (name TEXT, value TEXT)");
+        Execute("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, "
+                "tile_data BLOB)");
+        Execute("CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row)");
+        Execute("BEGIN TRANSACTION");
+
+        auto insert_metadata = Prepare("INSERT INTO metadata (name, value) VALUES (?, ?)");
+        for (const auto &name_and_value : metadata)
+        {
+            sqlite3_bind_text(insert_metadata.get(),
+                              1,
+                              name_and_value.first.c_str(),
+                              -1,
+                              SQLITE_TRANSIENT);
+            sqlite3_bind_text(insert_metadata.get(),
+                              2,
+                              name_and_value.second.c_str(),
+                              -1,
+                              SQLITE_TRANSIENT);
+            Step(insert_metadata.get());
+        }
+
+        insert_tile = Prepare("INSERT INTO tiles (zoom_level, tile_column, tile_row, tile_data) "
+                              "VALUES (?, ?, ?, ?)");
+    }
+
+    std::string Encode(std::string tile) const override final
+    {
+        z_stream stream{};
+        // 16 added to the window bits writes a gzip header
+        if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+            Z_OK)
+        {
+            throw util::exception("Could not initialize gzip compression" + SOURCE_REF);
+        }
+
+        std::string compressed(deflateBound(&stream, tile.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(&tile[0]);
+        stream.avail_in = tile.size();
+        stream.next_out = reinterpret_cast<Bytef *>(&compressed[0]);
+        stream.avail_out = compressed.size();
+        const auto result = deflate(&stream, Z_FINISH);
+        deflateEnd(&stream);
+        if (result != Z_STREAM_END)
+        {
+            throw util::exception("Could not compress tile" + SOURCE_REF);
+        }
+
+        compressed.resize(stream.total_out);
+        return compressed;
+    }
+
+    void Write(const unsigned z,
+               const unsigned x,
+               const unsigned y,
+               const std::string &data) override final
+    {
+        sqlite3_bind_int(insert_tile.get(), 1, z);
+        sqlite3_bind_int(insert_tile.get(), 2, x);
+        sqlite3_bind_int(insert_tile.get(), 3, (1u << z) - 1 - y);
+        sqlite3_bind_blob(insert_tile.get(), 4, data.data(), data.size(), SQLITE_STATIC);
+        Step(insert_tile.get());
+    }
+
+    void Finish() override final { Execute("COMMIT"); }
+
+  private:
+    using Statement = std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>;
+
+    void Check(const int result, const std::string &message) const
+    {
+        if (result != SQLITE_OK && result != SQLITE_DONE)
+        {
+            const std::string error =
+                database ? sqlite3_errmsg(database.get()) : sqlite3_errstr(result);
+            throw util::exception(message + ": " + error + SOURCE_REF);
+        }
+    }
+
+    void Execute(const std::string &sql)
+    {
+        Check(sqlite3_exec(database.get(), sql.c_str(), nullptr, nullptr, nullptr),
+              "Could not execute " + sql);
+    }
+
+    Statement Prepare(const std::string &sql)
+    {
+        sqlite3_stmt *statement = nullptr;
+        Check(sqlite3_prepare_v2(database.get(), sql.c_str(), -1, &statement, nullptr),
+              "Could not prepare " + sql);
+        return Statement(statement, sqlite3_finalize);
+    }
+
+    void Step(sqlite3_stmt *statement)
+    {
+        Check(sqlite3_step(statement), "Could not insert into the MBTiles file");
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    }
+
+    std::unique_ptr<sqlite3, decltype(&sqlite3_close)> database;
+    Statement insert_tile;
+};
+#endif
+
+// Parses <min lon>,<min lat>,<max lon>,<max lat>
+bool parseBoundingBox(const std::string &bbox,
+                      util::FloatCoordinate &south_west,
+                      util::FloatCoordinate &north_east)
+{
+    std::istringstream in(bbox);
+    double min_lon, min_lat, max_lon, max_lat;
+    char separator_1, separator_2, separator_3;
+    in >> min_lon >> separator_1 >> min_lat >> separator_2 >> max_lon >> separator_3 >> max_lat;
+    if (!in || !in.eof() || separator_1 != ',' || separator_2 != ',' || separator_3 != ',' ||
+        min_lon >= max_lon || min_lat >= max_lat || min_lon < -180 || max_lon > 180 ||
+        min_lat < -90 || max_lat > 90)
+    {
+        return false;
+    }
+
+    // web mercator ends short of the poles
+    south_west = {util::FloatLongitude{min_lon},
+                  util::web_mercator::clamp(util::FloatLatitude{min_lat})};
+    north_east = {util::FloatLongitude{max_lon},
+                  util::web_mercator::clamp(util::FloatLatitude{max_lat})};
+    return true;
+}
+
+return_code parseArguments(int argc, char *argv[], TilesConfig &config)
+{
+    std::string algorithm;
+    std::string format;
+    std::string bbox;
+
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options()
+        //
+        ("output,o",
+         boost::program_options::value<boost::filesystem::path>(&config.output_path),
+         "Output directory or MBTiles file") //
+        ("format",
+         boost::program_options::value<std::string>(&format),
+         "Output format: directory (<output>/<z>/<x>/<y>.mvt) or mbtiles. Defaults to mbtiles "
+         "if the output ends with .mbtiles") //
+        ("bbox",
+         boost::program_options::value<std::string>(&bbox),
+         "Bounding box <min lon>,<min lat>,<max lon>,<max lat> of the rendered tiles") //
+        ("min-zoom",
+         boost::program_options::value<unsigned>(&config.min_zoom)->default_value(MIN_ZOOM),
+         "Lowest rendered zoom level (12 to 19)") //
+        ("max-zoom",
+         boost::program_options::value<unsigned>(&config.max_zoom)->default_value(MAX_ZOOM),
+         "Highest rendered zoom level (12 to 19)") //
+        ("threads,t",
+         boost::program_options::value<unsigned>(&config.requested_num_threads)
+             ->default_value(tbb::task_scheduler_init::default_num_threads()),
+         "Number of threads to use") //
+        ("shared-memory,s",
+         boost::program_options::value<bool>(&config.engine_config.use_shared_memory)
+             ->implicit_value(true)
+             ->default_value(false),
+         "Load data from shared memory") //
+        ("algorithm,a",
+         boost::program_options::value<std::string>(&algorithm)->default_value("CH"),
+         "Algorithm to use for the data. Can be CH, CoreCH, MLD.");
+
+    // hidden options, will be allowed on command line, but will not be
+    // shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "input,i",
+        boost::program_options::value<boost::filesystem::path>(
+            &config.engine_config.storage_config.base_path),
+        "Input file in .osrm format");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("input", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        boost::filesystem::path(executable).filename().string() + " <input.osrm> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        std::cout << OSRM_VERSION << std::endl;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        std::cout << visible_options;
+        return return_code::exit;
+    }
+
+    boost::program_options::notify(option_variables);
+
+    if ((!option_variables.count("input") && !config.engine_config.use_shared_memory) ||
+        !option_variables.count("output") || !option_variables.count("bbox"))
+    {
+        std::cout << visible_options;
+        return return_code::fail;
+    }
+
+    if (!parseBoundingBox(bbox, config.south_west, config.north_east))
+    {
+        util::Log(logERROR) << "Invalid bounding box " << bbox
+                            << ", expected <min lon>,<min lat>,<max lon>,<max lat>";
+        return return_code::fail;
+    }
+
+    if (config.min_zoom < MIN_ZOOM || config.max_zoom > MAX_ZOOM ||
+        config.min_zoom > config.max_zoom)
+    {
+        util::Log(logERROR) << "Invalid zoom levels, tiles are rendered for zoom " << MIN_ZOOM
+                            << " to " << MAX_ZOOM;
+        return return_code::fail;
+    }
+
+    if (format.empty())
+    {
+        format = config.output_path.extension() == ".mbtiles" ? "mbtiles" : "directory";
+    }
+    if (format == "directory")
+    {
+        config.format = OutputFormat::Directory;
+    }
+    else if (format == "mbtiles")
+    {
+        config.format = OutputFormat::MBTiles;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown output format " << format
+                            << ", expected directory or mbtiles";
+        return return_code::fail;
+    }
+
+    boost::to_lower(algorithm);
+    if (algorithm == "ch")
+    {
+        config.engine_config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "corech")
+    {
+        config.engine_config.algorithm = EngineConfig::Algorithm::CoreCH;
+    }
+    else if (algorithm == "mld")
+    {
+        config.engine_config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown algorithm " << algorithm << ", expected CH, CoreCH or MLD";
+        return return_code::fail;
+    }
+
+    return return_code::ok;
+}
+
+std::unique_ptr<TileWriter> makeWriter(const TilesConfig &config)
+{
+    if (config.format == OutputFormat::Directory)
+    {
+        return std::make_unique<DirectoryWriter>(config.output_path);
+    }
+
+#ifdef USE_SQLITE3_LIBRARY
+    return std::make_unique<MBTilesWriter>(config.output_path, makeMetadata(config));
+#else
+    throw util::exception("osrm-tiles was built without SQLite, MBTiles output is not available, "
+                          "use --format directory" +
+                          SOURCE_REF);
+#endif
+}
+
+// All tiles of one column of a zoom level, rendered by one task
+struct TileColumn
+{
+    unsigned z;
+    unsigned x;
+    unsigned min_y;
+    unsigned max_y;
+    // rows with features and their encoded tiles
+    std::vector<std::pair<unsigned, std::string>> tiles;
+};
+
+void renderTiles(const OSRM &osrm, const TilesConfig &config, TileWriter &writer)
+{
+    std::vector<TileRange> ranges;
+    std::uint64_t number_of_tiles = 0;
+    for (auto z = config.min_zoom; z <= config.max_zoom; ++z)
+    {
+        ranges.push_back(getTileRange(config.south_west, config.north_east, z));
+        number_of_tiles += ranges.back().NumberOfTiles();
+    }
+
+    if (number_of_tiles > std::numeric_limits<unsigned>::max())
+    {
+        throw util::exception("The bounding box covers " + std::to_string(number_of_tiles) +
+                              " tiles, choose a smaller box or fewer zoom levels" + SOURCE_REF);
+    }
+    util::Log() << "Rendering " << number_of_tiles << " tiles for zoom " << config.min_zoom
+                << " to " << config.max_zoom;
+
+    auto range = ranges.begin();
+    auto x = range->min_x;
+    tbb::filter_t<void, std::shared_ptr<TileColumn>> column_generator(
+        tbb::filter::serial_in_order, [&](tbb::flow_control &fc) {
+            if (range == ranges.end())
+            {
+                fc.stop();
+                return std::shared_ptr<TileColumn>{};
+            }
+
+            auto column = std::make_shared<TileColumn>();
+            column->z = range->z;
+            column->x = x;
+            column->min_y = range->min_y;
+            column->max_y = range->max_y;
+
+            if (x == range->max_x && ++range != ranges.end())
+            {
+                x = range->min_x;
+            }
+            else
+            {
+                ++x;
+            }
+            return column;
+        });
+
+    // the tile plugin is safe to use from several threads, every thread has its own heaps
+    tbb::filter_t<std::shared_ptr<TileColumn>, std::shared_ptr<TileColumn>> column_renderer(
+        tbb::filter::parallel, [&](std::shared_ptr<TileColumn> column) {
+            for (auto y = column->min_y; y <= column->max_y; ++y)
+            {
+                std::string tile;
+                const TileParameters parameters{column->x, y, column->z};
+                if (osrm.Tile(parameters, tile) != Status::Ok)
+                {
+                    throw util::exception("Could not render tile " + std::to_string(column->z) +
+                                          "/" + std::to_string(column->x) + "/" +
+                                          std::to_string(y) + SOURCE_REF);
+                }
+
+                if (hasFeatures(tile))
+                {
+                    column->tiles.emplace_back(y, writer.Encode(std::move(tile)));
+                }
+            }
+            return column;
+        });
+
+    std::size_t written_tiles = 0;
+    std::size_t written_bytes = 0;
+    {
+        util::UnbufferedLog log;
+        util::Percent progress(log, static_cast<unsigned>(number_of_tiles));
+        tbb::filter_t<std::shared_ptr<TileColumn>, void> column_writer(
+            tbb::filter::serial_out_of_order, [&](std::shared_ptr<TileColumn> column) {
+                for (const auto &row_and_tile : column->tiles)
+                {
+                    writer.Write(column->z, column->x, row_and_tile.first, row_and_tile.second);
+                    written_bytes += row_and_tile.second.size();
+                }
+                written_tiles += column->tiles.size();
+                progress.PrintAddition(column->max_y - column->min_y + 1);
+            });
+
+        tbb::parallel_pipeline(config.requested_num_threads * 2,
+                               column_generator & column_renderer & column_writer);
+    }
+    writer.Finish();
+
+    util::Log() << "Wrote " << written_tiles << " tiles with " << written_bytes << " bytes, "
+                << number_of_tiles - written_tiles << " tiles without roads were skipped";
+}
+}
+
+int main(int argc, char *argv[]) try
+{
+    util::LogPolicy::GetInstance().Unmute();
+    TilesConfig config;
+
+    const auto result = parseArguments(argc, argv, config);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    if (1 > config.requested_num_threads)
+    {
+        util::Log(logERROR) << "Number of threads must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    if (!config.engine_config.use_shared_memory)
+    {
+        config.engine_config.storage_config =
+            storage::StorageConfig(config.engine_config.storage_config.base_path);
+    }
+    if (!config.engine_config.IsValid())
+    {
+        util::Log(logERROR) << "Required files are missing, cannot continue";
+        return EXIT_FAILURE;
+    }
+
+    tbb::task_scheduler_init init(config.requested_num_threads);
+
+    TIMER_START(rendering);
+    const OSRM osrm{config.engine_config};
+    auto writer = makeWriter(config);
+    renderTiles(osrm, config, *writer);
+    TIMER_STOP(rendering);
+
+    util::Log() << "Rendering finished after " << TIMER_SEC(rendering) << " seconds";
+
+    return EXIT_SUCCESS;
+}
+catch (const osrm::RuntimeError &e)
+{
+    util::Log(logERROR) << e.what();
+    return e.GetCode();
+}
+catch (const std::bad_alloc &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    util::Log(logERROR) << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,92 @@
+#include "util/huge_pages.hpp"
+
+#include "util/log.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace osrm
+{
+namespace util
+{
+
+bool adviseHugePages(void *address, const std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    return ::madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+    (void)address;
+    (void)size;
+    return false;
+#endif
+}
+
+#ifdef __linux__
+ProcessMemory::ProcessMemory(const std::size_t size, const bool use_huge_pages)
+    : memory(nullptr), mapped_size(0), huge_tlb(false)
+{
+    void *address = MAP_FAILED;
+    if (use_huge_pages)
+    {
+        mapped_size = alignToHugePages(size);
+        address = ::mmap(nullptr,
+                         mapped_size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                         -1,
+                         0);
+        huge_tlb = address != MAP_FAILED;
+        if (!huge_tlb)
+        {
+            const auto error = std::strerror(errno);
+            util::Log(logWARNING) << "Could not map " << mapped_size
+                                  << " bytes of reserved huge pages (" << error
+                                  << "), falling back to transparent huge pages";
+        }
+    }
+
+    if (address == MAP_FAILED)
+    {
+        // anonymous mappings are zero filled like the value initialized array they replace
+        mapped_size = std::max<std::size_t>(size, 1);
+        address = ::mmap(nullptr,
+                         mapped_size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+        if (address == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        if (use_huge_pages && !adviseHugePages(address, mapped_size))
+        {
+            util::Log(logWARNING) << "Transparent huge pages are not available";
+        }
+    }
+
+    memory = static_cast<char *>(address);
+}
+
+ProcessMemory::~ProcessMemory() { ::munmap(memory, mapped_size); }
+#else
+ProcessMemory::ProcessMemory(const std::size_t size, const bool use_huge_pages)
+    : memory(new char[size]()), mapped_size(size), huge_tlb(false)
+{
+    if (use_huge_pages)
+    {
+        util::Log(logWARNING) << "Huge pages are only supported on Linux";
+    }
+}
+
+ProcessMemory::~ProcessMemory() { delete[] memory; }
+#endif
+}
+}
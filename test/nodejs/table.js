@@ -181,3 +181,32 @@ test('table: table in Monaco without motorways', function(assert) {
     });
 });
 
+test('table: distance and duration table in Monaco', function(assert) {
+    assert.plan(5);
+    var osrm = new OSRM(data_path);
+    var options = {
+        coordinates: two_test_coordinates,
+        annotations: ['duration', 'distance']
+    };
+    osrm.table(options, function(err, table) {
+        assert.ifError(err);
+        assert.equal(table.durations.length, 2);
+        assert.equal(table.distances.length, 2);
+        assert.equal(table.distances[0][0], 0);
+        assert.ok(table.distances[0][1] > 0);
+    });
+});
+
+test('table: throws on invalid annotations', function(assert) {
+    assert.plan(2);
+    var osrm = new OSRM(data_path);
+    var options = {
+        coordinates: two_test_coordinates
+    };
+    options.annotations = 'distance';
+    assert.throws(function() { osrm.table(options, function(err, response) {}); },
+        /Annotations must an array containing 'duration' or 'distance', or both/);
+    options.annotations = ['speed'];
+    assert.throws(function() { osrm.table(options, function(err, response) {}); },
+        /this 'annotations' param is not supported/);
+});
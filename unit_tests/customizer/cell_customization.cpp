@@ -7,6 +7,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 using namespace osrm;
 using namespace osrm::customizer;
 using namespace osrm::partition;
@@ -409,4 +411,135 @@ BOOST_AUTO_TEST_CASE(exclude_test)
     CHECK_EQUAL_RANGE(cell_2_1.GetInWeight(5), 1, 0);
 }
 
+BOOST_AUTO_TEST_CASE(changed_cells_test)
+{
+    // node:                0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+    std::vector<CellID> l1{{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
+    std::vector<CellID> l3{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+    MultiLevelPartition mlp{{l1, l2, l3}, {4, 2, 1}};
+
+    std::vector<MockEdge> edges = {
+        {0, 1, 1},  {0, 2, 1},  {3, 1, 1},  {3, 2, 1},  {4, 5, 1},  {4, 6, 1},  {4, 7, 1},
+        {5, 4, 1},  {5, 6, 1},  {5, 7, 1},  {6, 4, 1},  {6, 5, 1},  {6, 7, 1},  {7, 4, 1},
+        {7, 5, 1},  {7, 6, 1},  {9, 11, 1}, {10, 8, 1}, {11, 10, 1}, {13, 12, 10}, {15, 14, 1},
+        {2, 4, 1},  {5, 12, 1}, {8, 3, 1},  {9, 3, 1},  {12, 5, 1}, {13, 7, 1}, {14, 9, 1},
+        {14, 11, 1}};
+
+    const auto previous_graph = makeGraph(mlp, edges);
+    std::vector<bool> node_filter(previous_graph.GetNumberOfNodes(), true);
+
+    CellCustomizer customizer(mlp);
+    CellStorage storage(mlp, previous_graph);
+    auto previous_metric = storage.MakeMetric();
+    customizer.Customize(previous_graph, storage, node_filter, previous_metric);
+
+    const auto check_changed_cells = [&](const std::vector<MockEdge> &changed_edges,
+                                         const std::size_t expected_num_customized) {
+        const auto graph = makeGraph(mlp, changed_edges);
+
+        auto metric = storage.MakeMetric();
+        customizer.Customize(graph, storage, node_filter, metric);
+
+        const auto changed_cells = customizer.FindChangedCells(graph, previous_graph);
+        BOOST_REQUIRE(changed_cells);
+
+        auto updated_metric = previous_metric;
+        const auto num_customized = customizer.CustomizeChanged(
+            graph, storage, node_filter, updated_metric, *changed_cells);
+        BOOST_CHECK_EQUAL(num_customized, expected_num_customized);
+
+        CHECK_EQUAL_COLLECTIONS(updated_metric.weights, metric.weights);
+        CHECK_EQUAL_COLLECTIONS(updated_metric.durations, metric.durations);
+    };
+
+    // unchanged graph
+    check_changed_cells(edges, 0);
+
+    // cell (3, 1, 0): 13 -> 12 changes on every level
+    auto shorter_edges = edges;
+    shorter_edges[19].weight = 4;
+    check_changed_cells(shorter_edges, 3);
+
+    // cell (1, 0, 0): 6 -> 7 is never the shortest path between border nodes
+    auto longer_edges = edges;
+    longer_edges[12].weight = 3;
+    check_changed_cells(longer_edges, 1);
+
+    // edge between cells (1, 0, 0) -> (3, 1, 0) is read on level 3
+    auto border_edges = edges;
+    border_edges[22].weight = 2;
+    check_changed_cells(border_edges, 1);
+
+    // a different graph can not be compared
+    auto other_edges = edges;
+    other_edges.pop_back();
+    BOOST_CHECK(!customizer.FindChangedCells(makeGraph(mlp, other_edges), previous_graph));
+}
+
+BOOST_AUTO_TEST_CASE(min_plus_engine_test)
+{
+    // 16x16 grid, 4x4 nodes per cell on level 1, 8x8 on level 2
+    const NodeID size = 16;
+    std::vector<CellID> l1(size * size), l2(size * size), l3(size * size, 0);
+    for (const auto y : util::irange<NodeID>(0, size))
+    {
+        for (const auto x : util::irange<NodeID>(0, size))
+        {
+            l2[y * size + x] = (y / 8) * 2 + x / 8;
+            l1[y * size + x] = l2[y * size + x] * 4 + ((y / 4) % 2) * 2 + (x / 4) % 2;
+        }
+    }
+    MultiLevelPartition mlp{{l1, l2, l3}, {16, 4, 1}};
+
+    std::mt19937 generator(1337);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 10);
+    std::uniform_int_distribution<NodeID> node_distribution(0, size * size - 1);
+    std::vector<MockEdge> edges;
+    for (const auto y : util::irange<NodeID>(0, size))
+    {
+        for (const auto x : util::irange<NodeID>(0, size))
+        {
+            const auto node = y * size + x;
+            if (x + 1 < size)
+            {
+                edges.push_back({node, node + 1, weight_distribution(generator)});
+                edges.push_back({node + 1, node, weight_distribution(generator)});
+            }
+            if (y + 1 < size && x % 3 != 0)
+            {
+                edges.push_back({node, node + size, weight_distribution(generator)});
+            }
+            // one-way shortcuts
+            if (x % 5 == 0)
+            {
+                edges.push_back({node, node_distribution(generator), weight_distribution(generator)});
+            }
+        }
+    }
+    const auto graph = makeGraph(mlp, edges);
+    CellStorage storage(mlp, graph);
+
+    CellCustomizer dijkstra_customizer(mlp, CustomizationEngine::Dijkstra);
+    CellCustomizer min_plus_customizer(mlp, CustomizationEngine::MinPlus);
+
+    std::vector<bool> all_nodes(graph.GetNumberOfNodes(), true);
+    std::vector<bool> some_nodes(graph.GetNumberOfNodes(), true);
+    for (const auto node : util::irange<NodeID>(0, graph.GetNumberOfNodes()))
+    {
+        some_nodes[node] = node % 7 != 0;
+    }
+
+    for (const auto &node_filter : {all_nodes, some_nodes})
+    {
+        auto dijkstra_metric = storage.MakeMetric();
+        dijkstra_customizer.Customize(graph, storage, node_filter, dijkstra_metric);
+        auto min_plus_metric = storage.MakeMetric();
+        min_plus_customizer.Customize(graph, storage, node_filter, min_plus_metric);
+
+        CHECK_EQUAL_COLLECTIONS(min_plus_metric.weights, dijkstra_metric.weights);
+        CHECK_EQUAL_COLLECTIONS(min_plus_metric.durations, dijkstra_metric.durations);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+#include "engine/api/binary_writer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(binary_writer)
+
+using namespace osrm::engine::api;
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+    const std::vector<double> durations = {0., 1.5, -2.25};
+    const std::vector<std::int32_t> indices = {-1, 7};
+    const std::vector<std::string> names = {"Aleja Solidarnosci", "", "Ulica"};
+
+    std::vector<char> buffer;
+    BinaryWriter writer(buffer);
+    writer.Add("code", std::string("Ok"));
+    writer.Add("durations", durations);
+    writer.Add("indices", indices);
+    writer.Add("names", names);
+    writer.Add("empty", std::vector<std::uint64_t>());
+    writer.Finish();
+
+    BinaryReader reader(buffer.data(), buffer.size());
+    BOOST_CHECK(reader.IsValid());
+    BOOST_CHECK_EQUAL(reader.GetString("code"), "Ok");
+
+    const auto read_durations = reader.Get<double>("durations");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        read_durations.begin(), read_durations.end(), durations.begin(), durations.end());
+    const auto read_indices = reader.Get<std::int32_t>("indices");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        read_indices.begin(), read_indices.end(), indices.begin(), indices.end());
+    const auto read_names = reader.GetStrings("names");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        read_names.begin(), read_names.end(), names.begin(), names.end());
+
+    BOOST_CHECK(reader.Has("empty"));
+    BOOST_CHECK(reader.Get<std::uint64_t>("empty").empty());
+    BOOST_CHECK(!reader.Has("distances"));
+    // the type has to match
+    BOOST_CHECK(reader.Get<std::uint32_t>("durations").empty());
+}
+
+BOOST_AUTO_TEST_CASE(aligned_sections)
+{
+    std::vector<char> buffer;
+    BinaryWriter writer(buffer);
+    writer.Add("code", std::string("Ok"));
+    writer.Add("bytes", std::vector<std::uint8_t>{1, 2, 3});
+    writer.Add("values", std::vector<double>{4.});
+    writer.Finish();
+
+    BinaryReader reader(buffer.data(), buffer.size());
+    const auto values = reader.Get<double>("values");
+    BOOST_REQUIRE_EQUAL(values.size(), 1);
+    BOOST_CHECK_EQUAL((values.begin() - reinterpret_cast<const double *>(buffer.data())) *
+                          sizeof(double) % BinaryWriter::ALIGNMENT,
+                      0);
+    BOOST_CHECK_EQUAL(buffer.size() % BinaryWriter::ALIGNMENT, 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_buffers)
+{
+    const std::string too_short = "OSRB";
+    BOOST_CHECK(!BinaryReader(too_short.data(), too_short.size()).IsValid());
+
+    std::vector<char> buffer;
+    BinaryWriter writer(buffer);
+    writer.Add("code", std::string("Ok"));
+    writer.Finish();
+    buffer[0] = 'X';
+    BinaryReader reader(buffer.data(), buffer.size());
+    BOOST_CHECK(!reader.IsValid());
+    BOOST_CHECK(!reader.Has("code"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,350 @@
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "customizer/cell_customizer.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "partition/cell_storage.hpp"
+#include "partition/multi_level_graph.hpp"
+#include "partition/multi_level_partition.hpp"
+#include "util/integer_range.hpp"
+#include "util/static_graph.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Declare an algorithm for a facade over an in-memory multi-level graph
+namespace network
+{
+struct Algorithm final
+{
+};
+}
+
+} // routing_algorithms
+
+template <> struct SearchEngineData<routing_algorithms::network::Algorithm>
+{
+    using QueryHeap = SearchEngineData<routing_algorithms::mld::Algorithm>::QueryHeap;
+};
+
+namespace datafacade
+{
+
+// A grid of GRID_SIZE x GRID_SIZE coordinates connected by two-way roads of a single segment.
+// Road r is the edge-based node 2 * r from its first to its second coordinate and 2 * r + 1
+// the other way around. The edge-based nodes are partitioned by the grid quadrant (level 1)
+// and the grid half (level 2) of the coordinate they start at.
+template <>
+class ContiguousInternalMemoryDataFacade<routing_algorithms::network::Algorithm> final
+    : public test::MockBaseDataFacade
+{
+  public:
+    using EdgeData = extractor::EdgeBasedEdge::EdgeData;
+
+    static constexpr NodeID GRID_SIZE = 4;
+
+    struct Road
+    {
+        NodeID from;
+        NodeID to;
+        EdgeWeight weight;
+    };
+
+    ContiguousInternalMemoryDataFacade()
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<EdgeWeight> weight_distribution(10, 1000);
+        for (const auto y : util::irange<NodeID>(0, GRID_SIZE))
+        {
+            for (const auto x : util::irange<NodeID>(0, GRID_SIZE))
+            {
+                if (x + 1 < GRID_SIZE)
+                    roads.push_back({GetCoordinateID(x, y),
+                                     GetCoordinateID(x + 1, y),
+                                     weight_distribution(generator)});
+                if (y + 1 < GRID_SIZE)
+                    roads.push_back({GetCoordinateID(x, y),
+                                     GetCoordinateID(x, y + 1),
+                                     weight_distribution(generator)});
+            }
+        }
+
+        const auto number_of_nodes = static_cast<NodeID>(2 * roads.size());
+        std::vector<CellID> l1(number_of_nodes), l2(number_of_nodes);
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        {
+            const auto coordinate = GetFromCoordinateID(node);
+            const auto quadrant_x = coordinate % GRID_SIZE / (GRID_SIZE / 2);
+            const auto quadrant_y = coordinate / GRID_SIZE / (GRID_SIZE / 2);
+            l1[node] = quadrant_y * 2 + quadrant_x;
+            l2[node] = quadrant_y;
+        }
+        partition = partition::MultiLevelPartition{{l1, l2}, {4, 2}};
+
+        // Every turn except u-turns, costs the weight of the road it leaves
+        using Edge = util::static_graph_details::SortableEdgeWithData<EdgeData>;
+        std::vector<Edge> edges;
+        NodeID turn_id = 0;
+        for (const auto from : util::irange<NodeID>(0, number_of_nodes))
+        {
+            for (const auto to : util::irange<NodeID>(0, number_of_nodes))
+            {
+                if (from / 2 == to / 2 || GetToCoordinateID(from) != GetFromCoordinateID(to))
+                    continue;
+                const auto weight = roads[from / 2].weight;
+                edges.push_back(Edge{from, to, turn_id, weight, weight, true, false});
+                edges.push_back(Edge{to, from, turn_id, weight, weight, false, true});
+                ++turn_id;
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        graph = partition::MultiLevelGraph<EdgeData, storage::Ownership::Container>(
+            partition, number_of_nodes, edges);
+
+        cell_storage = partition::CellStorage(partition, graph);
+        cell_metric = cell_storage.MakeMetric();
+        customizer::CellCustomizer customizer(partition);
+        std::vector<bool> node_filter(number_of_nodes, true);
+        customizer.Customize(graph, cell_storage, node_filter, cell_metric);
+    }
+
+    // A phantom node on road at ratio of its length from its first coordinate
+    PhantomNode MakePhantom(const std::size_t road, const double ratio) const
+    {
+        const auto from = GetCoordinateOfNode(roads[road].from);
+        const auto to = GetCoordinateOfNode(roads[road].to);
+        const auto interpolate = [ratio](const auto from, const auto to) {
+            return static_cast<int>(static_cast<int>(from) +
+                                    ratio * (static_cast<int>(to) - static_cast<int>(from)));
+        };
+        const util::Coordinate location{util::FixedLongitude{interpolate(from.lon, to.lon)},
+                                        util::FixedLatitude{interpolate(from.lat, to.lat)}};
+
+        PhantomNode segments;
+        segments.forward_segment_id = {static_cast<NodeID>(2 * road), true};
+        segments.reverse_segment_id = {static_cast<NodeID>(2 * road + 1), true};
+
+        const auto forward_weight = static_cast<EdgeWeight>(ratio * roads[road].weight);
+        const auto reverse_weight = roads[road].weight - forward_weight;
+        return PhantomNode{segments,
+                           ComponentID{0, false},
+                           forward_weight,
+                           reverse_weight,
+                           0,
+                           0,
+                           forward_weight,
+                           reverse_weight,
+                           0,
+                           0,
+                           true,
+                           true,
+                           true,
+                           true,
+                           location,
+                           location};
+    }
+
+    std::size_t GetNumberOfRoads() const { return roads.size(); }
+
+    unsigned GetNumberOfNodes() const { return graph.GetNumberOfNodes(); }
+
+    NodeID GetTarget(const EdgeID edge) const { return graph.GetTarget(edge); }
+
+    const EdgeData &GetEdgeData(const EdgeID edge) const { return graph.GetEdgeData(edge); }
+
+    const auto &GetMultiLevelPartition() const { return partition; }
+
+    const auto &GetCellStorage() const { return cell_storage; }
+
+    const auto &GetCellMetric() const { return cell_metric; }
+
+    auto GetBorderEdgeRange(const LevelID level, const NodeID node) const
+    {
+        return graph.GetBorderEdgeRange(level, node);
+    }
+
+    EdgeID FindEdge(const NodeID from, const NodeID to) const { return graph.FindEdge(from, to); }
+
+    util::Coordinate GetCoordinateOfNode(const NodeID id) const override
+    {
+        return {util::FloatLongitude{7.41 + 0.001 * (id % GRID_SIZE)},
+                util::FloatLatitude{43.73 + 0.001 * (id / GRID_SIZE)}};
+    }
+
+    GeometryID GetGeometryIndex(const NodeID id) const override
+    {
+        return GeometryID{id / 2, id % 2 == 0};
+    }
+
+    std::vector<NodeID> GetUncompressedForwardGeometry(const EdgeID id) const override
+    {
+        return {roads[id].from, roads[id].to};
+    }
+
+    std::vector<NodeID> GetUncompressedReverseGeometry(const EdgeID id) const override
+    {
+        return {roads[id].to, roads[id].from};
+    }
+
+    std::vector<EdgeWeight> GetUncompressedForwardWeights(const EdgeID id) const override
+    {
+        return {roads[id].weight};
+    }
+
+    std::vector<DatasourceID> GetUncompressedForwardDatasources(const EdgeID /*id*/) const override
+    {
+        return {0};
+    }
+
+    std::vector<DatasourceID> GetUncompressedReverseDatasources(const EdgeID /*id*/) const override
+    {
+        return {0};
+    }
+
+    extractor::TravelMode GetTravelMode(const NodeID /*id*/) const override
+    {
+        return TRAVEL_MODE_DRIVING;
+    }
+
+  private:
+    NodeID GetCoordinateID(const NodeID x, const NodeID y) const { return y * GRID_SIZE + x; }
+    NodeID GetFromCoordinateID(const NodeID node) const
+    {
+        return node % 2 == 0 ? roads[node / 2].from : roads[node / 2].to;
+    }
+    NodeID GetToCoordinateID(const NodeID node) const
+    {
+        return node % 2 == 0 ? roads[node / 2].to : roads[node / 2].from;
+    }
+
+    std::vector<Road> roads;
+    partition::MultiLevelPartition partition;
+    partition::MultiLevelGraph<EdgeData, storage::Ownership::Container> graph;
+    partition::CellStorage cell_storage;
+    customizer::CellMetric cell_metric;
+};
+
+} // datafacade
+} // engine
+} // osrm
+
+BOOST_AUTO_TEST_SUITE(network_distances)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::engine::routing_algorithms;
+
+using Algorithm = network::Algorithm;
+using Facade = DataFacade<Algorithm>;
+using QueryHeap = SearchEngineData<Algorithm>::QueryHeap;
+
+namespace
+{
+// Every target has to get the distance of the single source to target search
+void checkDistances(const Facade &facade,
+                    const PhantomNode &source,
+                    const std::vector<PhantomNode> &targets,
+                    const EdgeWeight weight_upper_bound)
+{
+    SearchEngineData<Algorithm> engine_working_data;
+    QueryHeap forward_heap(facade.GetNumberOfNodes());
+    QueryHeap reverse_heap(facade.GetNumberOfNodes());
+
+    const auto distances = mld::getNetworkDistances(engine_working_data,
+                                                    facade,
+                                                    forward_heap,
+                                                    reverse_heap,
+                                                    source,
+                                                    targets,
+                                                    weight_upper_bound);
+    BOOST_REQUIRE_EQUAL(distances.size(), targets.size());
+
+    for (const auto index : util::irange<std::size_t>(0UL, targets.size()))
+    {
+        const auto distance = mld::getNetworkDistance(engine_working_data,
+                                                      facade,
+                                                      forward_heap,
+                                                      reverse_heap,
+                                                      source,
+                                                      targets[index],
+                                                      weight_upper_bound);
+        BOOST_CHECK_EQUAL(distances[index], distance);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(all_targets)
+{
+    const Facade facade;
+
+    std::vector<PhantomNode> targets;
+    for (const auto road : util::irange<std::size_t>(0UL, facade.GetNumberOfRoads()))
+        targets.push_back(facade.MakePhantom(road, 0.5));
+
+    for (const auto road : util::irange<std::size_t>(0UL, facade.GetNumberOfRoads()))
+        checkDistances(facade, facade.MakePhantom(road, 0.25), targets, INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_CASE(targets_on_source_road)
+{
+    const Facade facade;
+
+    // in front of, behind and at the source, the one behind needs a loop
+    const auto source = facade.MakePhantom(0, 0.5);
+    const std::vector<PhantomNode> targets = {facade.MakePhantom(0, 0.75),
+                                              facade.MakePhantom(0, 0.25),
+                                              facade.MakePhantom(0, 0.5),
+                                              facade.MakePhantom(1, 0.5)};
+    checkDistances(facade, source, targets, INVALID_EDGE_WEIGHT);
+
+    SearchEngineData<Algorithm> engine_working_data;
+    QueryHeap forward_heap(facade.GetNumberOfNodes());
+    QueryHeap reverse_heap(facade.GetNumberOfNodes());
+    const auto distances = mld::getNetworkDistances(
+        engine_working_data, facade, forward_heap, reverse_heap, source, targets);
+    BOOST_CHECK_GT(distances[0], 0.);
+    BOOST_CHECK_LT(distances[0], std::numeric_limits<double>::max());
+    BOOST_CHECK_LT(distances[1], std::numeric_limits<double>::max());
+    BOOST_CHECK_EQUAL(distances[2], 0.);
+}
+
+BOOST_AUTO_TEST_CASE(weight_upper_bound)
+{
+    const Facade facade;
+
+    std::vector<PhantomNode> targets;
+    for (const auto road : util::irange<std::size_t>(0UL, facade.GetNumberOfRoads()))
+        targets.push_back(facade.MakePhantom(road, 0.5));
+
+    const auto source = facade.MakePhantom(facade.GetNumberOfRoads() / 2, 0.5);
+    for (const EdgeWeight bound : {1, 500, 1000, 2000})
+        checkDistances(facade, source, targets, bound);
+
+    // only the target at the source is within the bound
+    SearchEngineData<Algorithm> engine_working_data;
+    QueryHeap forward_heap(facade.GetNumberOfNodes());
+    QueryHeap reverse_heap(facade.GetNumberOfNodes());
+    const auto distances = mld::getNetworkDistances(
+        engine_working_data, facade, forward_heap, reverse_heap, source, targets, 1);
+    for (const auto index : util::irange<std::size_t>(0UL, distances.size()))
+    {
+        if (index == facade.GetNumberOfRoads() / 2)
+            BOOST_CHECK_EQUAL(distances[index], 0.);
+        else
+            BOOST_CHECK_EQUAL(distances[index], std::numeric_limits<double>::max());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
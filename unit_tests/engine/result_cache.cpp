@@ -0,0 +1,261 @@
+#include "engine/result_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(result_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+std::vector<PhantomNode> makePhantoms(const std::vector<util::Coordinate> &coordinates)
+{
+    std::vector<PhantomNode> phantoms;
+    for (const auto coordinate : coordinates)
+    {
+        PhantomNode phantom;
+        phantom.location = coordinate;
+        phantom.input_location = coordinate;
+        phantoms.push_back(phantom);
+    }
+    return phantoms;
+}
+}
+
+BOOST_AUTO_TEST_CASE(serve_json_writer)
+{
+    ResultCache cache(1024);
+    const auto make_key = [] { return std::string("key"); };
+
+    int calls = 0;
+    const auto make_response = [&](util::json::Writer &writer) {
+        ++calls;
+        writer.StartObject();
+        writer.Key("code");
+        writer.String("Ok");
+        writer.EndObject();
+        return Status::Ok;
+    };
+
+    std::vector<char> first_buffer;
+    util::json::Writer first_writer(first_buffer);
+    BOOST_CHECK(cache.Serve(1, make_key, first_writer, [&] {
+        return make_response(first_writer);
+    }) == Status::Ok);
+
+    std::vector<char> second_buffer;
+    util::json::Writer second_writer(second_buffer);
+    BOOST_CHECK(cache.Serve(1, make_key, second_writer, [&] {
+        return make_response(second_writer);
+    }) == Status::Ok);
+
+    BOOST_CHECK_EQUAL(calls, 1);
+    BOOST_CHECK(first_buffer == second_buffer);
+    BOOST_CHECK_EQUAL(std::string(second_buffer.begin(), second_buffer.end()), "{\"code\":\"Ok\"}");
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 1);
+    BOOST_CHECK_EQUAL(statistics.misses, 1);
+    BOOST_CHECK_EQUAL(statistics.entries, 1);
+    BOOST_CHECK_EQUAL(statistics.HitRate(), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(serve_binary_writer)
+{
+    ResultCache cache(1024);
+    const auto make_key = [] { return std::string("key"); };
+
+    int calls = 0;
+    const auto make_response = [&](api::BinaryWriter &writer) {
+        ++calls;
+        writer.Add("durations", std::vector<double>{1., 2.});
+        writer.Finish();
+        return Status::Ok;
+    };
+
+    std::vector<char> first_buffer;
+    api::BinaryWriter first_writer(first_buffer);
+    cache.Serve(1, make_key, first_writer, [&] { return make_response(first_writer); });
+
+    std::vector<char> second_buffer;
+    api::BinaryWriter second_writer(second_buffer);
+    cache.Serve(1, make_key, second_writer, [&] { return make_response(second_writer); });
+
+    BOOST_CHECK_EQUAL(calls, 1);
+    BOOST_CHECK(!first_buffer.empty());
+    BOOST_CHECK(first_buffer == second_buffer);
+
+    // json and binary responses of the same request are cached separately
+    std::vector<char> json_buffer;
+    util::json::Writer json_writer(json_buffer);
+    cache.Serve(1, make_key, json_writer, [&] {
+        ++calls;
+        json_writer.Null();
+        return Status::Ok;
+    });
+    BOOST_CHECK_EQUAL(calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(errors_are_not_cached)
+{
+    ResultCache cache(1024);
+    const auto make_key = [] { return std::string("key"); };
+
+    int calls = 0;
+    for (int request = 0; request < 2; ++request)
+    {
+        std::vector<char> buffer;
+        util::json::Writer writer(buffer);
+        BOOST_CHECK(cache.Serve(1, make_key, writer, [&] {
+            ++calls;
+            writer.Null();
+            return Status::Error;
+        }) == Status::Error);
+    }
+
+    BOOST_CHECK_EQUAL(calls, 2);
+    BOOST_CHECK_EQUAL(cache.GetStatistics().entries, 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalidate_on_new_timestamp)
+{
+    ResultCache cache(1024);
+    const auto make_key = [] { return std::string("key"); };
+
+    int calls = 0;
+    const auto serve = [&](const unsigned timestamp) {
+        std::vector<char> buffer;
+        util::json::Writer writer(buffer);
+        cache.Serve(timestamp, make_key, writer, [&] {
+            ++calls;
+            writer.Integer(timestamp);
+            return Status::Ok;
+        });
+        return std::string(buffer.begin(), buffer.end());
+    };
+
+    BOOST_CHECK_EQUAL(serve(1), "1");
+    BOOST_CHECK_EQUAL(serve(1), "1");
+    BOOST_CHECK_EQUAL(serve(2), "2");
+    BOOST_CHECK_EQUAL(calls, 2);
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.invalidations, 2);
+    BOOST_CHECK_EQUAL(statistics.entries, 1);
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    // room for two entries of 4 byte timestamp, format, 1 byte key and 1 byte response
+    ResultCache cache(14);
+
+    int calls = 0;
+    const auto serve = [&](const std::string &key) {
+        std::vector<char> buffer;
+        util::json::Writer writer(buffer);
+        cache.Serve(1, [&] { return key; }, writer, [&] {
+            ++calls;
+            writer.Integer(0);
+            return Status::Ok;
+        });
+    };
+
+    serve("a");
+    serve("b");
+    serve("a");
+    serve("c");
+    serve("a");
+    serve("b");
+
+    BOOST_CHECK_EQUAL(calls, 4);
+    BOOST_CHECK_EQUAL(cache.GetStatistics().evictions, 2);
+}
+
+BOOST_AUTO_TEST_CASE(disabled_cache)
+{
+    ResultCache cache(0);
+    BOOST_CHECK(!cache.IsEnabled());
+
+    int key_calls = 0;
+    int calls = 0;
+    for (int request = 0; request < 2; ++request)
+    {
+        std::vector<char> buffer;
+        util::json::Writer writer(buffer);
+        cache.Serve(1,
+                    [&] {
+                        ++key_calls;
+                        return std::string("key");
+                    },
+                    writer,
+                    [&] {
+                        ++calls;
+                        writer.Null();
+                        return Status::Ok;
+                    });
+    }
+
+    BOOST_CHECK_EQUAL(key_calls, 0);
+    BOOST_CHECK_EQUAL(calls, 2);
+    BOOST_CHECK_EQUAL(cache.GetStatistics().misses, 0);
+}
+
+BOOST_AUTO_TEST_CASE(route_keys)
+{
+    const std::vector<util::Coordinate> coordinates = {
+        util::Coordinate{util::FloatLongitude{7.419}, util::FloatLatitude{43.731}},
+        util::Coordinate{util::FloatLongitude{7.420}, util::FloatLatitude{43.736}}};
+    const auto phantoms = makePhantoms(coordinates);
+
+    api::RouteParameters params;
+    params.coordinates = coordinates;
+    const auto key = ResultCache::MakeKey(params, phantoms);
+
+    // only select the phantom nodes
+    auto hinted_params = params;
+    hinted_params.radiuses = {100., 100.};
+    BOOST_CHECK(ResultCache::MakeKey(hinted_params, phantoms) == key);
+
+    auto exclude_params = params;
+    exclude_params.exclude = {"toll", "motorway"};
+    auto reordered_exclude_params = params;
+    reordered_exclude_params.exclude = {"motorway", "toll"};
+    BOOST_CHECK(ResultCache::MakeKey(exclude_params, phantoms) != key);
+    BOOST_CHECK(ResultCache::MakeKey(exclude_params, phantoms) ==
+                ResultCache::MakeKey(reordered_exclude_params, phantoms));
+
+    auto steps_params = params;
+    steps_params.steps = true;
+    BOOST_CHECK(ResultCache::MakeKey(steps_params, phantoms) != key);
+
+    auto metric_params = params;
+    metric_params.metric = "distance";
+    BOOST_CHECK(ResultCache::MakeKey(metric_params, phantoms) != key);
+
+    auto other_phantoms = phantoms;
+    other_phantoms.back().fwd_segment_position = 1;
+    BOOST_CHECK(ResultCache::MakeKey(params, other_phantoms) != key);
+
+    // the coordinates are keyed as the input location of the phantoms
+    auto moved_params = params;
+    moved_params.coordinates.back() =
+        util::Coordinate{util::FloatLongitude{7.421}, util::FloatLatitude{43.737}};
+    BOOST_CHECK(ResultCache::MakeKey(moved_params, phantoms) == key);
+    BOOST_CHECK(ResultCache::MakeKey(moved_params, makePhantoms(moved_params.coordinates)) != key);
+
+    // route and table requests never share a key
+    api::TableParameters table_params;
+    table_params.coordinates = coordinates;
+    BOOST_CHECK(ResultCache::MakeKey(table_params, phantoms) != key);
+
+    auto sources_params = table_params;
+    sources_params.sources = {0};
+    BOOST_CHECK(ResultCache::MakeKey(sources_params, phantoms) !=
+                ResultCache::MakeKey(table_params, phantoms));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
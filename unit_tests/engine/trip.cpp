@@ -0,0 +1,141 @@
+#include "engine/trip/trip_brute_force.hpp"
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
+#include "util/dist_table_wrapper.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_solvers)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+util::DistTableWrapper<EdgeWeight> makeTable(const std::size_t number_of_locations,
+                                             const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 1000);
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            table[from * number_of_locations + to] =
+                from == to ? 0 : weight_distribution(generator);
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+std::int64_t getWeight(const util::DistTableWrapper<EdgeWeight> &table,
+                       const std::vector<NodeID> &trip)
+{
+    std::int64_t weight = 0;
+    for (std::size_t index = 0; index < trip.size(); ++index)
+    {
+        weight += table(trip[index], trip[(index + 1) % trip.size()]);
+    }
+    return weight;
+}
+
+bool isPermutation(const std::vector<NodeID> &trip, const std::size_t number_of_locations)
+{
+    std::vector<NodeID> expected(number_of_locations);
+    std::iota(expected.begin(), expected.end(), 0);
+    return std::is_permutation(trip.begin(), trip.end(), expected.begin(), expected.end());
+}
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_matches_brute_force)
+{
+    for (std::size_t number_of_locations = 2; number_of_locations < 9; ++number_of_locations)
+    {
+        for (unsigned seed = 0; seed < 5; ++seed)
+        {
+            const auto table = makeTable(number_of_locations, seed);
+            const auto held_karp = trip::HeldKarpTrip(number_of_locations, table);
+            const auto brute_force = trip::BruteForceTrip(number_of_locations, table);
+
+            BOOST_REQUIRE(isPermutation(held_karp, number_of_locations));
+            BOOST_CHECK_EQUAL(held_karp.front(), 0);
+            BOOST_CHECK_EQUAL(getWeight(table, held_karp), getWeight(table, brute_force));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_single_location)
+{
+    const auto table = makeTable(1, 0);
+    BOOST_CHECK(trip::HeldKarpTrip(1, table) == std::vector<NodeID>{0});
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_avoids_invalid_legs)
+{
+    // the only valid trip is 0 -> 2 -> 1 -> 3 -> 0
+    const auto I = INVALID_EDGE_WEIGHT;
+    // clang-format off
+    util::DistTableWrapper<EdgeWeight> table({0, I, 5, I,
+                                              I, 0, I, 5,
+                                              I, 5, 0, I,
+                                              5, I, I, 0}, 4);
+    // clang-format on
+    const auto trip = trip::HeldKarpTrip(4, table);
+    BOOST_CHECK(trip == (std::vector<NodeID>{0, 2, 1, 3}));
+
+    // no leg leaves location 0
+    util::DistTableWrapper<EdgeWeight> disconnected({0, I, I, 0}, 2);
+    BOOST_CHECK(trip::HeldKarpTrip(2, disconnected).empty());
+}
+
+BOOST_AUTO_TEST_CASE(local_search_improves_trip)
+{
+    const std::size_t number_of_locations = 40;
+    for (unsigned seed = 0; seed < 3; ++seed)
+    {
+        const auto table = makeTable(number_of_locations, seed);
+        const auto initial_trip = trip::FarthestInsertionTrip(number_of_locations, table);
+        const auto trip =
+            trip::LocalSearchTrip(table, initial_trip, std::chrono::milliseconds{1000}, 4, 1);
+
+        BOOST_REQUIRE(isPermutation(trip, number_of_locations));
+        BOOST_CHECK_LE(getWeight(table, trip), getWeight(table, initial_trip));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(local_search_finds_optimum_of_small_trips)
+{
+    const std::size_t number_of_locations = 7;
+    const auto table = makeTable(number_of_locations, 42);
+    std::vector<NodeID> initial_trip(number_of_locations);
+    std::iota(initial_trip.begin(), initial_trip.end(), 0);
+
+    const auto trip =
+        trip::LocalSearchTrip(table, initial_trip, std::chrono::milliseconds{1000}, 16, 1);
+    const auto optimum = trip::HeldKarpTrip(number_of_locations, table);
+    BOOST_CHECK_EQUAL(getWeight(table, trip), getWeight(table, optimum));
+}
+
+BOOST_AUTO_TEST_CASE(local_search_threads_give_same_result)
+{
+    const std::size_t number_of_locations = 30;
+    const auto table = makeTable(number_of_locations, 7);
+    const auto initial_trip = trip::FarthestInsertionTrip(number_of_locations, table);
+
+    const auto sequential =
+        trip::LocalSearchTrip(table, initial_trip, std::chrono::milliseconds{10000}, 8, 1);
+    const auto parallel =
+        trip::LocalSearchTrip(table, initial_trip, std::chrono::milliseconds{10000}, 8, 4);
+    BOOST_CHECK(sequential == parallel);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
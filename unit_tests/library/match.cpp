@@ -13,6 +13,9 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include <cstddef>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(match)
 
 BOOST_AUTO_TEST_CASE(test_match)
@@ -64,4 +67,173 @@ BOOST_AUTO_TEST_CASE(test_match)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_match_batch)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.max_match_threads = 4;
+    OSRM osrm{config};
+
+    MatchParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    // all traces of a batch are matched with the same exclude classes
+    MatchParameters other_exclude = params;
+    other_exclude.exclude.push_back("motorway");
+
+    // the same trace several times shares all candidates
+    std::vector<MatchParameters> batch(8, params);
+    batch.push_back(other_exclude);
+
+    std::vector<std::size_t> calls(batch.size(), 0);
+    const auto rc = osrm.Match(
+        batch, [&](const std::size_t index, const Status status, json::Object &result) {
+            BOOST_REQUIRE_LT(index, batch.size());
+            ++calls[index];
+
+            const auto code = result.values.at("code").get<json::String>().value;
+            if (index + 1 < batch.size())
+            {
+                BOOST_CHECK(status == Status::Ok);
+                BOOST_CHECK_EQUAL(code, "Ok");
+                const auto &tracepoints =
+                    result.values.at("tracepoints").get<json::Array>().values;
+                BOOST_CHECK_EQUAL(tracepoints.size(), params.coordinates.size());
+            }
+            else
+            {
+                BOOST_CHECK(status == Status::Error);
+                BOOST_CHECK_EQUAL(code, "InvalidValue");
+            }
+        });
+
+    BOOST_CHECK(rc == Status::Error);
+    for (const auto count : calls)
+    {
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_match_batch_metric)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/mld/monaco.osrm"};
+    config.algorithm = EngineConfig::Algorithm::MLD;
+    config.use_shared_memory = false;
+    config.max_match_threads = 2;
+    config.metrics["same"] = storage::StorageConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+    OSRM osrm{config};
+
+    MatchParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    // all traces of a batch are matched with the metric of the first one
+    MatchParameters other_metric = params;
+    other_metric.metric = "same";
+
+    std::vector<MatchParameters> batch(4, params);
+    batch.push_back(other_metric);
+
+    std::vector<std::size_t> calls(batch.size(), 0);
+    const auto rc = osrm.Match(
+        batch, [&](const std::size_t index, const Status status, json::Object &result) {
+            BOOST_REQUIRE_LT(index, batch.size());
+            ++calls[index];
+
+            const auto code = result.values.at("code").get<json::String>().value;
+            if (index + 1 < batch.size())
+            {
+                BOOST_CHECK(status == Status::Ok);
+                BOOST_CHECK_EQUAL(code, "Ok");
+            }
+            else
+            {
+                BOOST_CHECK(status == Status::Error);
+                BOOST_CHECK_EQUAL(code, "InvalidValue");
+            }
+        });
+
+    BOOST_CHECK(rc == Status::Error);
+    for (const auto count : calls)
+    {
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_match_batch_exclude_order)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/mld/monaco.osrm"};
+    config.algorithm = EngineConfig::Algorithm::MLD;
+    config.use_shared_memory = false;
+    config.max_match_threads = 2;
+    OSRM osrm{config};
+
+    MatchParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    // repeated exclude classes select the same facade
+    MatchParameters motorway = params;
+    motorway.exclude = {"motorway"};
+    MatchParameters repeated_motorway = params;
+    repeated_motorway.exclude = {"motorway", "motorway"};
+
+    std::vector<MatchParameters> batch{motorway, repeated_motorway};
+    std::vector<std::size_t> calls(batch.size(), 0);
+    auto rc = osrm.Match(
+        batch, [&](const std::size_t index, const Status status, json::Object &result) {
+            BOOST_REQUIRE_LT(index, batch.size());
+            ++calls[index];
+
+            BOOST_CHECK(status == Status::Ok);
+            BOOST_CHECK_EQUAL(result.values.at("code").get<json::String>().value, "Ok");
+        });
+
+    BOOST_CHECK(rc == Status::Ok);
+    for (const auto count : calls)
+    {
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+
+    // the order of the exclude classes does not matter, both traces are checked against the
+    // facade and fail the same way because the data has no facade without tolls and motorways
+    MatchParameters toll_motorway = params;
+    toll_motorway.exclude = {"toll", "motorway"};
+    MatchParameters motorway_toll = params;
+    motorway_toll.exclude = {"motorway", "toll"};
+
+    batch = {toll_motorway, motorway_toll};
+    calls.assign(batch.size(), 0);
+    rc = osrm.Match(
+        batch, [&](const std::size_t index, const Status status, json::Object &result) {
+            BOOST_REQUIRE_LT(index, batch.size());
+            ++calls[index];
+
+            BOOST_CHECK(status == Status::Error);
+            BOOST_CHECK_EQUAL(result.values.at("code").get<json::String>().value,
+                              "InvalidValue");
+            BOOST_CHECK_EQUAL(result.values.at("message").get<json::String>().value,
+                              "Exclude flag combination is not supported.");
+        });
+
+    BOOST_CHECK(rc == Status::Error);
+    for (const auto count : calls)
+    {
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
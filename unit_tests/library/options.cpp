@@ -5,7 +5,12 @@
 #include "equal_json.hpp"
 #include "fixture.hpp"
 
+#include "osrm/json_container.hpp"
 #include "osrm/osrm.hpp"
+#include "osrm/route_parameters.hpp"
+#include "osrm/status.hpp"
+
+#include <boost/filesystem.hpp>
 
 BOOST_AUTO_TEST_SUITE(options)
 
@@ -39,4 +44,134 @@ BOOST_AUTO_TEST_CASE(test_mld)
     OSRM osrm{config};
 }
 
+BOOST_AUTO_TEST_CASE(test_mmap)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.memory_image_path = boost::filesystem::temp_directory_path() /
+                               boost::filesystem::unique_path("monaco-%%%%-%%%%.osrm.memory");
+    config.algorithm = EngineConfig::Algorithm::CH;
+
+    RouteParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object mapped_result;
+    {
+        // the first instance writes the memory image, the second one only maps it
+        OSRM writing_osrm{config};
+        BOOST_CHECK(boost::filesystem::is_regular_file(config.memory_image_path));
+        const auto image_time = boost::filesystem::last_write_time(config.memory_image_path);
+
+        OSRM mapping_osrm{config};
+        BOOST_CHECK_EQUAL(boost::filesystem::last_write_time(config.memory_image_path),
+                          image_time);
+        BOOST_CHECK(mapping_osrm.Route(params, mapped_result) == Status::Ok);
+    }
+
+    config.use_mmap = false;
+    OSRM loading_osrm{config};
+    json::Object loaded_result;
+    BOOST_CHECK(loading_osrm.Route(params, loaded_result) == Status::Ok);
+    CHECK_EQUAL_JSON(mapped_result, loaded_result);
+
+    boost::filesystem::remove(config.memory_image_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_mmap_stale_image)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.memory_image_path = boost::filesystem::temp_directory_path() /
+                               boost::filesystem::unique_path("monaco-%%%%-%%%%.osrm.memory");
+    config.algorithm = EngineConfig::Algorithm::CH;
+
+    {
+        OSRM writing_osrm{config};
+    }
+
+    // an image older than the data files is written again
+    const auto data_time =
+        boost::filesystem::last_write_time(config.storage_config.GetPath(".osrm.hsgr"));
+    boost::filesystem::last_write_time(config.memory_image_path, data_time - 60);
+
+    OSRM rewriting_osrm{config};
+    BOOST_CHECK(boost::filesystem::last_write_time(config.memory_image_path) >= data_time);
+
+    RouteParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    json::Object result;
+    BOOST_CHECK(rewriting_osrm.Route(params, result) == Status::Ok);
+
+    boost::filesystem::remove(config.memory_image_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_mmap_unwritable_image)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.algorithm = EngineConfig::Algorithm::CH;
+    // the image can't be written into a missing directory, the data is loaded instead
+    config.memory_image_path = boost::filesystem::temp_directory_path() /
+                               boost::filesystem::unique_path("missing-%%%%-%%%%") /
+                               "monaco.osrm.memory";
+
+    OSRM osrm{config};
+    BOOST_CHECK(!boost::filesystem::exists(config.memory_image_path));
+
+    RouteParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    json::Object result;
+    BOOST_CHECK(osrm.Route(params, result) == Status::Ok);
+}
+
+BOOST_AUTO_TEST_CASE(test_metric)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+    config.algorithm = EngineConfig::Algorithm::MLD;
+    // the same dataset as a second metric has to give the same results
+    config.metrics["same"] = storage::StorageConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+    OSRM osrm{config};
+
+    RouteParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object default_result;
+    BOOST_CHECK(osrm.Route(params, default_result) == Status::Ok);
+
+    params.metric = "same";
+    json::Object metric_result;
+    BOOST_CHECK(osrm.Route(params, metric_result) == Status::Ok);
+    CHECK_EQUAL_JSON(default_result, metric_result);
+
+    params.metric = "unknown";
+    json::Object error_result;
+    BOOST_CHECK(osrm.Route(params, error_result) == Status::Error);
+    BOOST_CHECK_EQUAL(error_result.values.at("code").get<json::String>().value, "InvalidValue");
+    BOOST_CHECK_EQUAL(error_result.values.at("message").get<json::String>().value,
+                      "Metric unknown is not loaded.");
+
+    // the unknown metric is reported even if the exclude classes are supported
+    params.exclude.push_back("motorway");
+    json::Object exclude_result;
+    BOOST_CHECK(osrm.Route(params, exclude_result) == Status::Error);
+    BOOST_CHECK_EQUAL(exclude_result.values.at("message").get<json::String>().value,
+                      "Metric unknown is not loaded.");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,10 +5,12 @@
 #include "equal_json.hpp"
 #include "fixture.hpp"
 
+#include "osrm/binary_writer.hpp"
 #include "osrm/coordinate.hpp"
 #include "osrm/engine_config.hpp"
 #include "osrm/exception.hpp"
 #include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
 #include "osrm/osrm.hpp"
 #include "osrm/route_parameters.hpp"
 #include "osrm/status.hpp"
@@ -446,4 +448,80 @@ BOOST_AUTO_TEST_CASE(test_manual_setting_of_annotations_property)
     BOOST_CHECK_EQUAL(annotations.size(), 5);
 }
 
+BOOST_AUTO_TEST_CASE(test_route_writer_matches_json_object)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.steps = true;
+    params.alternatives = true;
+    params.geometries = RouteParameters::GeometriesType::GeoJSON;
+    params.annotations_type = RouteParameters::AnnotationsType::All;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object result;
+    BOOST_CHECK(osrm.Route(params, result) == Status::Ok);
+    std::vector<char> rendered;
+    json::render(rendered, result);
+
+    std::vector<char> streamed;
+    json::Writer writer(streamed);
+    BOOST_CHECK(osrm.Route(params, writer) == Status::Ok);
+
+    BOOST_CHECK_EQUAL(std::string(streamed.begin(), streamed.end()),
+                      std::string(rendered.begin(), rendered.end()));
+}
+
+BOOST_AUTO_TEST_CASE(test_route_binary_matches_json_object)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.alternatives = true;
+    params.annotations_type = RouteParameters::AnnotationsType::Duration;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+
+    json::Object result;
+    BOOST_CHECK(osrm.Route(params, result) == Status::Ok);
+
+    std::vector<char> buffer;
+    BinaryWriter writer(buffer);
+    BOOST_CHECK(osrm.Route(params, writer) == Status::Ok);
+
+    BinaryReader reader(buffer.data(), buffer.size());
+    BOOST_REQUIRE(reader.IsValid());
+    BOOST_CHECK_EQUAL(reader.GetString("code"), "Ok");
+
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    const auto distances = reader.Get<double>("routes.distance");
+    const auto durations = reader.Get<double>("routes.duration");
+    const auto leg_offsets = reader.Get<std::uint32_t>("routes.legs.offsets");
+    BOOST_REQUIRE_EQUAL(distances.size(), routes.size());
+    BOOST_REQUIRE_EQUAL(leg_offsets.size(), routes.size() + 1);
+    for (std::size_t index = 0; index < routes.size(); ++index)
+    {
+        // JSON rounds to one decimal
+        const auto &route = routes[index].get<json::Object>().values;
+        BOOST_CHECK_SMALL(distances[index] - route.at("distance").get<json::Number>().value,
+                          0.051);
+        BOOST_CHECK_SMALL(durations[index] - route.at("duration").get<json::Number>().value,
+                          0.051);
+        BOOST_CHECK_EQUAL(leg_offsets[index + 1] - leg_offsets[index],
+                          route.at("legs").get<json::Array>().values.size());
+    }
+
+    const auto waypoints = reader.Get<double>("waypoints.location");
+    BOOST_CHECK_EQUAL(waypoints.size(), 2 * params.coordinates.size());
+    BOOST_CHECK(reader.Has("annotation.duration"));
+    BOOST_CHECK(!reader.Has("annotation.distance"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,14 +5,19 @@
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
+#include "osrm/route_parameters.hpp"
 #include "osrm/table_parameters.hpp"
 
+#include "osrm/binary_writer.hpp"
 #include "osrm/coordinate.hpp"
 #include "osrm/engine_config.hpp"
 #include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include <cmath>
+
 BOOST_AUTO_TEST_SUITE(table)
 
 BOOST_AUTO_TEST_CASE(test_table_three_coords_one_source_one_dest_matrix)
@@ -174,4 +179,226 @@ BOOST_AUTO_TEST_CASE(test_table_no_segment_for_some_coordinates)
     BOOST_CHECK_EQUAL(code, "NoSegment");
 }
 
+BOOST_AUTO_TEST_CASE(test_table_concurrent_forward_searches)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.max_table_threads = 4;
+    OSRM concurrent_osrm{config};
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    for (const auto &location : get_locations_in_small_component())
+    {
+        params.coordinates.push_back(location);
+    }
+
+    json::Object result;
+    const auto rc = osrm.Table(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    json::Object concurrent_result;
+    const auto concurrent_rc = concurrent_osrm.Table(params, concurrent_result);
+    BOOST_CHECK(concurrent_rc == Status::Ok);
+
+    const auto &durations_array = result.values.at("durations").get<json::Array>().values;
+    const auto &concurrent_durations_array =
+        concurrent_result.values.at("durations").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(durations_array.size(), concurrent_durations_array.size());
+    for (unsigned int i = 0; i < durations_array.size(); i++)
+    {
+        const auto &durations_row = durations_array[i].get<json::Array>().values;
+        const auto &concurrent_durations_row =
+            concurrent_durations_array[i].get<json::Array>().values;
+        BOOST_CHECK_EQUAL(durations_row.size(), concurrent_durations_row.size());
+        for (unsigned int j = 0; j < durations_row.size(); j++)
+        {
+            BOOST_CHECK_EQUAL(durations_row[j].is<json::Null>(),
+                              concurrent_durations_row[j].is<json::Null>());
+            if (durations_row[j].is<json::Number>())
+            {
+                BOOST_CHECK_EQUAL(durations_row[j].get<json::Number>().value,
+                                  concurrent_durations_row[j].get<json::Number>().value);
+            }
+        }
+    }
+}
+
+void test_table_distances(const char *dataset, const osrm::EngineConfig::Algorithm algorithm)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(dataset, algorithm);
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    const auto rc = osrm.Table(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    const auto &durations_array = result.values.at("durations").get<json::Array>().values;
+    const auto &distances_array = result.values.at("distances").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(distances_array.size(), params.coordinates.size());
+    for (unsigned int i = 0; i < distances_array.size(); i++)
+    {
+        const auto &durations_row = durations_array[i].get<json::Array>().values;
+        const auto &distances_row = distances_array[i].get<json::Array>().values;
+        BOOST_CHECK_EQUAL(distances_row.size(), params.coordinates.size());
+        BOOST_CHECK_EQUAL(distances_row[i].get<json::Number>().value, 0);
+
+        for (unsigned int j = 0; j < distances_row.size(); j++)
+        {
+            BOOST_CHECK_EQUAL(durations_row[j].is<json::Null>(), distances_row[j].is<json::Null>());
+            if (i == j || distances_row[j].is<json::Null>())
+                continue;
+
+            // the entry has to match the distance of the route between both coordinates
+            RouteParameters route_params;
+            route_params.coordinates = {params.coordinates[i], params.coordinates[j]};
+            route_params.overview = RouteParameters::OverviewType::False;
+            json::Object route_result;
+            BOOST_CHECK(osrm.Route(route_params, route_result) == Status::Ok);
+            const auto &route = route_result.values.at("routes")
+                                    .get<json::Array>()
+                                    .values.at(0)
+                                    .get<json::Object>();
+            BOOST_CHECK_CLOSE(distances_row[j].get<json::Number>().value,
+                              route.values.at("distance").get<json::Number>().value,
+                              1);
+        }
+    }
+
+    // only the requested matrices are returned
+    params.annotations = TableParameters::AnnotationsType::Distance;
+    json::Object distances_result;
+    BOOST_CHECK(osrm.Table(params, distances_result) == Status::Ok);
+    BOOST_CHECK(distances_result.values.count("durations") == 0);
+    BOOST_CHECK(distances_result.values.count("distances") == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_distances_ch)
+{
+    test_table_distances(OSRM_TEST_DATA_DIR "/ch/monaco.osrm", osrm::EngineConfig::Algorithm::CH);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_distances_mld)
+{
+    test_table_distances(OSRM_TEST_DATA_DIR "/mld/monaco.osrm",
+                         osrm::EngineConfig::Algorithm::MLD);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_writer_matches_json_object)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.coordinates.push_back(get_dummy_location());
+    params.sources = {0, 1, 3};
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    BOOST_CHECK(osrm.Table(params, result) == Status::Ok);
+    std::vector<char> rendered;
+    json::render(rendered, result);
+
+    std::vector<char> streamed;
+    json::Writer writer(streamed);
+    BOOST_CHECK(osrm.Table(params, writer) == Status::Ok);
+
+    BOOST_CHECK_EQUAL(std::string(streamed.begin(), streamed.end()),
+                      std::string(rendered.begin(), rendered.end()));
+
+    // errors are rendered the same way
+    params.sources = {};
+    params.coordinates.push_back(osrm::util::Coordinate{});
+    json::Object error_result;
+    BOOST_CHECK(osrm.Table(params, error_result) == Status::Error);
+    rendered.clear();
+    json::render(rendered, error_result);
+
+    streamed.clear();
+    json::Writer error_writer(streamed);
+    BOOST_CHECK(osrm.Table(params, error_writer) == Status::Error);
+    BOOST_CHECK_EQUAL(std::string(streamed.begin(), streamed.end()),
+                      std::string(rendered.begin(), rendered.end()));
+}
+
+BOOST_AUTO_TEST_CASE(test_table_binary_matches_json_object)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.sources = {0, 1};
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    BOOST_CHECK(osrm.Table(params, result) == Status::Ok);
+
+    std::vector<char> buffer;
+    BinaryWriter writer(buffer);
+    BOOST_CHECK(osrm.Table(params, writer) == Status::Ok);
+
+    BinaryReader reader(buffer.data(), buffer.size());
+    BOOST_REQUIRE(reader.IsValid());
+    BOOST_CHECK_EQUAL(reader.GetString("code"), "Ok");
+
+    const auto dimensions = reader.Get<std::uint32_t>("dimensions");
+    BOOST_REQUIRE_EQUAL(dimensions.size(), 2);
+    BOOST_CHECK_EQUAL(dimensions[0], params.sources.size());
+    BOOST_CHECK_EQUAL(dimensions[1], params.coordinates.size());
+
+    const auto source_names = reader.GetStrings("sources.name");
+    const auto &sources = result.values.at("sources").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(source_names.size(), sources.size());
+    for (std::size_t index = 0; index < sources.size(); ++index)
+    {
+        const auto &source = sources[index].get<json::Object>().values;
+        BOOST_CHECK_EQUAL(source_names[index], source.at("name").get<json::String>().value);
+    }
+
+    for (const auto annotation : {"durations", "distances"})
+    {
+        const auto values = reader.Get<double>(annotation);
+        const auto &rows = result.values.at(annotation).get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(values.size(), dimensions[0] * dimensions[1]);
+        for (std::size_t row = 0; row < rows.size(); ++row)
+        {
+            const auto &columns = rows[row].get<json::Array>().values;
+            for (std::size_t column = 0; column < columns.size(); ++column)
+            {
+                const auto value = values[row * dimensions[1] + column];
+                if (columns[column].is<json::Null>())
+                    BOOST_CHECK(std::isnan(value));
+                else
+                    BOOST_CHECK_EQUAL(value, columns[column].get<json::Number>().value);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
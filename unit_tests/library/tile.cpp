@@ -8,6 +8,7 @@
 #include "osrm/coordinate.hpp"
 #include "osrm/engine_config.hpp"
 #include "osrm/json_container.hpp"
+#include "osrm/cache_statistics.hpp"
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
@@ -793,4 +794,35 @@ BOOST_AUTO_TEST_CASE(test_tile_nodes_mld)
     test_tile_nodes(osrm);
 }
 
+BOOST_AUTO_TEST_CASE(test_tile_cache)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/mld/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.algorithm = EngineConfig::Algorithm::MLD;
+    config.max_tile_cache_memory = 1;
+    OSRM osrm{config};
+
+    TileParameters params{17059, 11948, 15};
+    TileParameters other_params{17060, 11948, 15};
+
+    std::string first_result;
+    BOOST_CHECK(osrm.Tile(params, first_result) == Status::Ok);
+    std::string other_result;
+    BOOST_CHECK(osrm.Tile(other_params, other_result) == Status::Ok);
+    std::string cached_result;
+    BOOST_CHECK(osrm.Tile(params, cached_result) == Status::Ok);
+
+    BOOST_CHECK(first_result == cached_result);
+    BOOST_CHECK(first_result != other_result);
+
+    const auto statistics = osrm.TileCacheStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 1);
+    BOOST_CHECK_EQUAL(statistics.misses, 2);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+    BOOST_CHECK_EQUAL(statistics.size, first_result.size() + other_result.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
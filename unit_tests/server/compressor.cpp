@@ -0,0 +1,97 @@
+#include "server/compressor.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compressor)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+std::string decompress(const std::vector<char> &compressed, const http::compression_type type)
+{
+    std::vector<char> decompressed;
+    boost::iostreams::filtering_istream stream;
+    if (type == http::gzip_rfc1952)
+    {
+        stream.push(boost::iostreams::gzip_decompressor());
+    }
+    else
+    {
+        boost::iostreams::zlib_params parameters;
+        parameters.noheader = true;
+        stream.push(boost::iostreams::zlib_decompressor(parameters));
+    }
+    stream.push(boost::iostreams::array_source(compressed.data(), compressed.size()));
+    boost::iostreams::copy(stream, boost::iostreams::back_inserter(decompressed));
+    return std::string(decompressed.begin(), decompressed.end());
+}
+
+std::vector<char> makeInput(const std::size_t size)
+{
+    std::vector<char> input;
+    for (std::size_t i = 0; input.size() < size; ++i)
+    {
+        const auto number = std::to_string(i * 7919 % 10007) + ",";
+        input.insert(input.end(), number.begin(), number.end());
+    }
+    return input;
+}
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+    Compressor compressor;
+    std::vector<char> output;
+    for (const auto type : {http::gzip_rfc1952, http::deflate_rfc1951})
+    {
+        // the streams are reused for every reply
+        for (const std::size_t size : {0, 1, 1000, 100000, 10})
+        {
+            const auto input = makeInput(size);
+            compressor.compress(input, type, output);
+            BOOST_CHECK_EQUAL(decompress(output, type), std::string(input.begin(), input.end()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gzip_header)
+{
+    std::vector<char> output;
+    Compressor::thread_local_instance().compress(makeInput(100), http::gzip_rfc1952, output);
+    BOOST_REQUIRE_GE(output.size(), 2);
+    BOOST_CHECK_EQUAL(static_cast<unsigned char>(output[0]), 0x1f);
+    BOOST_CHECK_EQUAL(static_cast<unsigned char>(output[1]), 0x8b);
+
+    BOOST_CHECK_EQUAL(Compressor::content_encoding(http::gzip_rfc1952), "gzip");
+    BOOST_CHECK_EQUAL(Compressor::content_encoding(http::deflate_rfc1951), "deflate");
+}
+
+#ifdef USE_ZSTD_LIBRARY
+BOOST_AUTO_TEST_CASE(zstd_round_trip)
+{
+    Compressor compressor;
+    std::vector<char> output;
+    const auto input = makeInput(100000);
+    compressor.compress(input, http::zstd, output);
+
+    std::vector<char> decompressed(input.size());
+    const auto size =
+        ZSTD_decompress(decompressed.data(), decompressed.size(), output.data(), output.size());
+    BOOST_REQUIRE(!ZSTD_isError(size));
+    BOOST_CHECK_EQUAL(size, input.size());
+    BOOST_CHECK(decompressed == input);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
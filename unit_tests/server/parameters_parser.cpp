@@ -86,6 +86,8 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
         testInvalidOptions<TableParameters>("1,2;3,4?sources=1&destinations=1&bla=foo"), 32UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=foo"), 16UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?destinations=foo"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?annotations=weight"), 20UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?annotations="), 20UL);
 }
 
 BOOST_AUTO_TEST_CASE(valid_route_hint)
@@ -491,6 +493,13 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     CHECK_EQUAL_RANGE(reference_21.coordinates, result_21->coordinates);
     CHECK_EQUAL_RANGE(reference_21.hints, result_21->hints);
     CHECK_EQUAL_RANGE(reference_21.exclude, result_21->exclude);
+
+    // metric of the request
+    auto result_22 = parseParameters<RouteParameters>("1,2;3,4?metric=truck_heavy-2");
+    BOOST_CHECK(result_22);
+    BOOST_CHECK_EQUAL(result_22->metric, "truck_heavy-2");
+    CHECK_EQUAL_RANGE(reference_21.coordinates, result_22->coordinates);
+    BOOST_CHECK_EQUAL(result_21->metric, "");
 }
 
 BOOST_AUTO_TEST_CASE(valid_table_urls)
@@ -530,6 +539,23 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_1.approaches, result_3->approaches);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_3->coordinates);
+
+    using AnnotationsType = TableParameters::AnnotationsType;
+    BOOST_CHECK(result_1->annotations == AnnotationsType::Duration);
+
+    auto result_4 = parseParameters<TableParameters>("1,2;3,4?annotations=distance");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->annotations == AnnotationsType::Distance);
+
+    std::vector<std::size_t> sources_5 = {0};
+    TableParameters reference_5{sources_5, {}, AnnotationsType::All};
+    reference_5.coordinates = coords_1;
+    auto result_5 =
+        parseParameters<TableParameters>("1,2;3,4?sources=0&annotations=duration,distance");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->annotations == reference_5.annotations);
+    CHECK_EQUAL_RANGE(reference_5.sources, result_5->sources);
+    CHECK_EQUAL_RANGE(reference_5.coordinates, result_5->coordinates);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -585,6 +611,32 @@ BOOST_AUTO_TEST_CASE(valid_nearest_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(output_format)
+{
+    auto result_1 = parseParameters<RouteParameters>("1,2;3,4");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(!result_1->format);
+
+    auto result_2 = parseParameters<RouteParameters>("1,2;3,4.json");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->format == BaseParameters::OutputFormatType::JSON);
+
+    auto result_3 = parseParameters<TableParameters>("1,2;3,4.bin?sources=0");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(result_3->format == BaseParameters::OutputFormatType::Binary);
+    BOOST_CHECK_EQUAL(result_3->coordinates.size(), 2);
+    BOOST_CHECK_EQUAL(result_3->coordinates[1],
+                      util::Coordinate(util::FloatLongitude{3}, util::FloatLatitude{4}));
+
+    auto result_4 = parseParameters<NearestParameters>("1.5,2.bin");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->format == BaseParameters::OutputFormatType::Binary);
+    BOOST_CHECK_EQUAL(result_4->coordinates[0],
+                      util::Coordinate(util::FloatLongitude{1.5}, util::FloatLatitude{2}));
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.binary"), 11);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_tile_urls)
 {
     TileParameters reference_1{1, 2, 3};
@@ -0,0 +1,135 @@
+#include "server/request_parser.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+RequestParser::RequestStatus parse(std::string &input, http::request &request, char *&end)
+{
+    RequestParser parser;
+    RequestParser::RequestStatus result;
+    std::tie(result, std::ignore, end) = parser.parse(request, &input[0], &input[0] + input.size());
+    return result;
+}
+
+RequestParser::RequestStatus parse(std::string input, http::request &request)
+{
+    char *end;
+    return parse(input, request, end);
+}
+}
+
+BOOST_AUTO_TEST_CASE(http_version_keep_alive)
+{
+    http::request request_1_1;
+    BOOST_CHECK(parse("GET /route HTTP/1.1\r\nHost: localhost\r\n\r\n", request_1_1) ==
+                RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request_1_1.uri, "/route");
+    BOOST_CHECK(request_1_1.keep_alive);
+
+    http::request request_1_0;
+    BOOST_CHECK(parse("GET /route HTTP/1.0\r\n\r\n", request_1_0) ==
+                RequestParser::RequestStatus::valid);
+    BOOST_CHECK(!request_1_0.keep_alive);
+}
+
+BOOST_AUTO_TEST_CASE(connection_header_keep_alive)
+{
+    http::request close_1_1;
+    BOOST_CHECK(parse("GET /route HTTP/1.1\r\nConnection: close\r\n\r\n", close_1_1) ==
+                RequestParser::RequestStatus::valid);
+    BOOST_CHECK(!close_1_1.keep_alive);
+
+    http::request keep_alive_1_0;
+    BOOST_CHECK(parse("GET /route HTTP/1.0\r\nConnection: Keep-Alive\r\nUser-Agent: test\r\n\r\n",
+                      keep_alive_1_0) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK(keep_alive_1_0.keep_alive);
+    BOOST_CHECK_EQUAL(keep_alive_1_0.agent, "test");
+}
+
+BOOST_AUTO_TEST_CASE(accept_header)
+{
+    http::request request;
+    BOOST_CHECK(parse("GET /route HTTP/1.1\r\nAccept: application/x-osrm-binary\r\n\r\n",
+                      request) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.accept, "application/x-osrm-binary");
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_requests)
+{
+    const std::string first = "GET /first HTTP/1.1\r\n\r\n";
+    const std::string second = "GET /second HTTP/1.1\r\nConnection: close\r\n\r\n";
+    std::string input = first + second;
+
+    http::request first_request;
+    char *end;
+    BOOST_CHECK(parse(input, first_request, end) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(first_request.uri, "/first");
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(end - &input[0]), first.size());
+
+    // the remaining data is parsed by a new parser
+    RequestParser parser;
+    http::request second_request;
+    RequestParser::RequestStatus result;
+    char *second_end;
+    std::tie(result, std::ignore, second_end) =
+        parser.parse(second_request, end, &input[0] + input.size());
+    BOOST_CHECK(result == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(second_request.uri, "/second");
+    BOOST_CHECK(!second_request.keep_alive);
+    BOOST_CHECK(second_end == &input[0] + input.size());
+}
+
+BOOST_AUTO_TEST_CASE(request_body)
+{
+    const std::string first = "POST /match/v1/driving/batch HTTP/1.1\r\nContent-Length: 11\r\n\r\n"
+                              "1,2;3,4\n5,6";
+    std::string input = first + "GET /second HTTP/1.1\r\n\r\n";
+
+    http::request request;
+    char *end;
+    BOOST_CHECK(parse(input, request, end) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/match/v1/driving/batch");
+    BOOST_CHECK_EQUAL(request.body, "1,2;3,4\n5,6");
+    // the next request starts behind the body
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(end - &input[0]), first.size());
+
+    // the body can arrive in several reads
+    std::string header = "POST /match HTTP/1.1\r\nContent-Length: 6\r\n\r\nab";
+    std::string rest = "cdef";
+    RequestParser parser;
+    http::request split_request;
+    RequestParser::RequestStatus result;
+    std::tie(result, std::ignore, std::ignore) =
+        parser.parse(split_request, &header[0], &header[0] + header.size());
+    BOOST_CHECK(result == RequestParser::RequestStatus::indeterminate);
+    std::tie(result, std::ignore, std::ignore) =
+        parser.parse(split_request, &rest[0], &rest[0] + rest.size());
+    BOOST_CHECK(result == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(split_request.body, "abcdef");
+
+    http::request invalid_request;
+    BOOST_CHECK(parse("POST /match HTTP/1.1\r\nContent-Length: many\r\n\r\n", invalid_request) ==
+                RequestParser::RequestStatus::invalid);
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_request)
+{
+    std::string input = "GET /route HTTP/1.1\r\nHost: local";
+    http::request request;
+    char *end;
+    BOOST_CHECK(parse(input, request, end) == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK(end == &input[0] + input.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
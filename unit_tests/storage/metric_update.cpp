@@ -0,0 +1,150 @@
+#include "storage/io.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/storage.hpp"
+
+#include "util/exception.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(metric_update)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+boost::filesystem::path makeTemporaryDirectory()
+{
+    const auto directory = boost::filesystem::temp_directory_path() /
+                           boost::filesystem::unique_path("osrm-storage-%%%%-%%%%");
+    boost::filesystem::create_directory(directory);
+    return directory;
+}
+
+// A dataset in a temporary directory that only has a .osrm.timestamp file
+struct TimestampedDataset
+{
+    TimestampedDataset() : directory(makeTemporaryDirectory()), config(directory / "test.osrm")
+    {
+    }
+
+    ~TimestampedDataset() { boost::filesystem::remove_all(directory); }
+
+    void WriteTimestamp(const std::string &timestamp)
+    {
+        io::FileWriter timestamp_file(config.GetPath(".osrm.timestamp"),
+                                      io::FileWriter::GenerateFingerprint);
+        timestamp_file.WriteFrom(timestamp.data(), timestamp.size());
+    }
+
+    boost::filesystem::path directory;
+    StorageConfig config;
+};
+
+// A layout of empty blocks except the timestamp
+DataLayout makeLayout(const std::string &timestamp)
+{
+    DataLayout layout;
+    for (auto i = 0; i < DataLayout::NUM_BLOCKS; i++)
+    {
+        layout.SetBlockSize<char>(static_cast<DataLayout::BlockID>(i), 0);
+    }
+    layout.SetBlockSize<char>(DataLayout::TIMESTAMP, timestamp.size());
+    return layout;
+}
+
+std::vector<char> makeMemory(const DataLayout &layout, const std::string &timestamp)
+{
+    std::vector<char> memory(layout.GetSizeOfLayout());
+    const auto timestamp_ptr =
+        layout.GetBlockPtr<char, true>(memory.data(), DataLayout::TIMESTAMP);
+    std::copy(timestamp.begin(), timestamp.end(), timestamp_ptr);
+    return memory;
+}
+}
+
+BOOST_AUTO_TEST_CASE(full_update_regions)
+{
+    // the first full update, then alternating between the two full regions
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_NONE, REGION_NONE, false), REGION_1);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_1, REGION_1, false), REGION_2);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_2, REGION_2, false), REGION_1);
+
+    // a metric region in use is replaced together with its base
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_3, REGION_1, false), REGION_2);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_4, REGION_2, false), REGION_1);
+
+    BOOST_CHECK(getRetiredRegions(REGION_NONE, REGION_NONE, false).empty());
+    BOOST_CHECK(getRetiredRegions(REGION_1, REGION_1, false) ==
+                std::vector<SharedDataType>{REGION_1});
+    BOOST_CHECK(getRetiredRegions(REGION_3, REGION_1, false) ==
+                (std::vector<SharedDataType>{REGION_3, REGION_1}));
+}
+
+BOOST_AUTO_TEST_CASE(metric_update_regions)
+{
+    // metric updates alternate between the two metric regions
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_1, REGION_1, true), REGION_3);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_3, REGION_1, true), REGION_4);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_4, REGION_1, true), REGION_3);
+    BOOST_CHECK_EQUAL(getNextRegion(REGION_4, REGION_2, true), REGION_3);
+
+    // the base region is kept, only a metric region in use is retired
+    BOOST_CHECK(getRetiredRegions(REGION_1, REGION_1, true).empty());
+    BOOST_CHECK(getRetiredRegions(REGION_3, REGION_1, true) ==
+                std::vector<SharedDataType>{REGION_3});
+    BOOST_CHECK(getRetiredRegions(REGION_4, REGION_2, true) ==
+                std::vector<SharedDataType>{REGION_4});
+
+    // without a full region there is nothing to share the static data with
+    BOOST_CHECK_THROW(getNextRegion(REGION_NONE, REGION_NONE, true), util::exception);
+    BOOST_CHECK_THROW(getNextRegion(REGION_3, REGION_NONE, true), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(accept_same_base)
+{
+    const std::string timestamp = "2017-05-01T00:00:00Z";
+    TimestampedDataset dataset;
+    dataset.WriteTimestamp(timestamp);
+
+    const auto base_layout = makeLayout(timestamp);
+    auto base_memory = makeMemory(base_layout, timestamp);
+
+    auto layout = makeLayout(timestamp);
+    layout.base_region = REGION_1;
+    // metric blocks can differ from the base
+    layout.SetBlockSize<char>(DataLayout::MLD_CELL_WEIGHTS_0, 42);
+
+    Storage storage(dataset.config);
+    BOOST_CHECK_EQUAL(storage.FindBaseMismatch(layout, base_layout, base_memory.data()),
+                      DataLayout::NUM_BLOCKS);
+}
+
+BOOST_AUTO_TEST_CASE(refuse_other_base)
+{
+    const std::string timestamp = "2017-05-01T00:00:00Z";
+    TimestampedDataset dataset;
+
+    const auto base_layout = makeLayout(timestamp);
+    auto base_memory = makeMemory(base_layout, timestamp);
+    Storage storage(dataset.config);
+
+    // an extract of other data with an equally long timestamp
+    dataset.WriteTimestamp("2017-06-01T00:00:00Z");
+    auto layout = makeLayout(timestamp);
+    layout.base_region = REGION_1;
+    BOOST_CHECK_EQUAL(storage.FindBaseMismatch(layout, base_layout, base_memory.data()),
+                      DataLayout::TIMESTAMP);
+
+    // static blocks of other sizes are reported before the timestamp is read
+    dataset.WriteTimestamp(timestamp);
+    layout.SetBlockSize<char>(DataLayout::NAME_CHAR_DATA, 42);
+    BOOST_CHECK_EQUAL(storage.FindBaseMismatch(layout, base_layout, base_memory.data()),
+                      DataLayout::NAME_CHAR_DATA);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,57 @@
+#include "storage/shared_datatype.hpp"
+#include "storage/storage.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(populate_data)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+// The files are read concurrently, every block has to hold the same data as when they are
+// read one after another
+void checkParallelLoad(const std::string &path)
+{
+    Storage storage{StorageConfig{path}};
+
+    DataLayout layout;
+    storage.PopulateLayout(layout);
+
+    std::vector<char> parallel_memory(layout.GetSizeOfLayout());
+    storage.PopulateData(layout, parallel_memory.data());
+
+    std::vector<char> serial_memory(layout.GetSizeOfLayout());
+    tbb::task_arena serial_arena(1);
+    serial_arena.execute([&] { storage.PopulateData(layout, serial_memory.data()); });
+
+    for (auto i = 0; i < DataLayout::NUM_BLOCKS; i++)
+    {
+        const auto bid = static_cast<DataLayout::BlockID>(i);
+        const auto size = layout.GetBlockSize(bid);
+        const auto parallel_block = layout.GetBlockPtr<char>(parallel_memory.data(), bid);
+        const auto serial_block = layout.GetBlockPtr<char>(serial_memory.data(), bid);
+        BOOST_CHECK_MESSAGE(std::equal(parallel_block, parallel_block + size, serial_block),
+                            "Block " << block_id_to_name[bid] << " of " << path << " differs");
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_load_ch)
+{
+    checkParallelLoad(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+}
+
+BOOST_AUTO_TEST_CASE(parallel_load_mld)
+{
+    checkParallelLoad(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,39 @@
+#include "util/huge_pages.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(huge_pages_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(align_to_huge_pages)
+{
+    BOOST_CHECK_EQUAL(alignToHugePages(0), 0);
+    BOOST_CHECK_EQUAL(alignToHugePages(1), HUGE_PAGE_SIZE);
+    BOOST_CHECK_EQUAL(alignToHugePages(HUGE_PAGE_SIZE), HUGE_PAGE_SIZE);
+    BOOST_CHECK_EQUAL(alignToHugePages(HUGE_PAGE_SIZE + 1), 2 * HUGE_PAGE_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(process_memory)
+{
+    // falls back to normal pages if no huge pages are reserved
+    for (const auto use_huge_pages : {false, true})
+    {
+        const std::size_t size = 3 * HUGE_PAGE_SIZE + 42;
+        ProcessMemory memory(size, use_huge_pages);
+        BOOST_REQUIRE(memory.get() != nullptr);
+        if (!use_huge_pages)
+        {
+            BOOST_CHECK(!memory.UsesHugeTLB());
+        }
+
+        BOOST_CHECK(std::all_of(memory.get(), memory.get() + size, [](char c) { return c == 0; }));
+        std::fill(memory.get(), memory.get() + size, 'x');
+        BOOST_CHECK_EQUAL(memory.get()[size - 1], 'x');
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,7 @@
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
 #include <exception>
 #include <numeric>
 #include <string>
@@ -19,6 +20,7 @@ const static std::string IO_CORRUPT_FINGERPRINT_FILE = "corrupt_fingerprint_file
 const static std::string IO_INCOMPATIBLE_FINGERPRINT_FILE =
     "incompatible_fingerprint_file_test_io.tmp";
 const static std::string IO_TEXT_FILE = "plain_text_file.tmp";
+const static std::string IO_LARGE_FILE = "large_file_test_io.tmp";
 
 BOOST_AUTO_TEST_SUITE(osrm_io)
 
@@ -185,4 +187,38 @@ BOOST_AUTO_TEST_CASE(io_read_lines)
     }
 }
 
+BOOST_AUTO_TEST_CASE(io_buffered_reads)
+{
+    // several times the read buffer, so reads cross its boundaries
+    std::vector<std::uint32_t> data_in(1024 * 1024 + 13), data_out;
+    std::iota(begin(data_in), end(data_in), 0);
+
+    {
+        osrm::storage::io::FileWriter outfile(IO_LARGE_FILE,
+                                              osrm::storage::io::FileWriter::GenerateFingerprint);
+        outfile.WriteFrom(data_in.data(), data_in.size());
+    }
+
+    osrm::storage::io::FileReader infile(IO_LARGE_FILE,
+                                         osrm::storage::io::FileReader::VerifyFingerprint);
+    BOOST_CHECK_EQUAL(infile.GetSize(), data_in.size() * sizeof(std::uint32_t));
+
+    // small reads and skips, then a large read of the rest
+    std::size_t position = 0;
+    for (const auto count : {1, 7, 100000, 3, 262144, 1})
+    {
+        BOOST_CHECK_EQUAL(infile.ReadOne<std::uint32_t>(), data_in[position]);
+        infile.Skip<std::uint32_t>(count);
+        position += 1 + count;
+    }
+    BOOST_CHECK_EQUAL(infile.GetSize(), data_in.size() * sizeof(std::uint32_t));
+
+    data_out.resize(data_in.size() - position);
+    infile.ReadInto(data_out);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        data_out.begin(), data_out.end(), data_in.begin() + position, data_in.end());
+
+    std::remove(IO_LARGE_FILE.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
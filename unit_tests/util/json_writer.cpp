@@ -0,0 +1,185 @@
+#include "util/json_writer.hpp"
+#include "util/cast.hpp"
+#include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(json_writer)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+std::string render(const json::Object &object)
+{
+    std::vector<char> buffer;
+    json::render(buffer, object);
+    return std::string(buffer.begin(), buffer.end());
+}
+
+std::string format(const double value)
+{
+    std::vector<char> buffer;
+    json::detail::appendNumber(buffer, value);
+    return std::string(buffer.begin(), buffer.end());
+}
+}
+
+BOOST_AUTO_TEST_CASE(number_formatting)
+{
+    const std::vector<double> values = {0.,
+                                        -0.,
+                                        1.,
+                                        -1.,
+                                        0.1,
+                                        -0.1,
+                                        1.5,
+                                        123456.7,
+                                        100.,
+                                        1e-7,
+                                        -1e-7,
+                                        0.0000005,
+                                        2.0000005,
+                                        1e15,
+                                        -1e15,
+                                        1e300,
+                                        std::numeric_limits<double>::max(),
+                                        std::numeric_limits<double>::lowest(),
+                                        std::numeric_limits<double>::infinity(),
+                                        9007199254740993.,
+                                        18446744073709551615.};
+
+    for (const auto value : values)
+    {
+        BOOST_CHECK_EQUAL(format(value), cast::to_string_with_precision(value));
+    }
+
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> real_distribution(-1e6, 1e6);
+    std::uniform_int_distribution<int> duration_distribution(0, 1000000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto real = real_distribution(generator);
+        BOOST_CHECK_EQUAL(format(real), cast::to_string_with_precision(real));
+
+        const auto duration = duration_distribution(generator) / 10.;
+        BOOST_CHECK_EQUAL(format(duration), cast::to_string_with_precision(duration));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(integer_formatting)
+{
+    for (const std::int64_t value : {std::int64_t{0},
+                                     std::int64_t{7},
+                                     std::int64_t{-42},
+                                     std::numeric_limits<std::int64_t>::max(),
+                                     std::numeric_limits<std::int64_t>::min()})
+    {
+        std::vector<char> buffer;
+        json::detail::appendInteger(buffer, value);
+        BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()), std::to_string(value));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(writer_matches_renderer)
+{
+    json::Object object;
+    object.values["code"] = "Ok";
+    object.values["message"] = "Aleja \"Solidarnosci\"";
+    json::Array row;
+    row.values.push_back(json::Number(1.5));
+    row.values.push_back(json::Null());
+    row.values.push_back(json::Number(-0.25));
+    json::Array table;
+    table.values.push_back(row);
+    table.values.push_back(json::Array());
+    object.values["table"] = table;
+    json::Object nested;
+    nested.values["true"] = json::True();
+    nested.values["false"] = json::False();
+    object.values["nested"] = nested;
+
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+    writer.StartObject();
+    for (const auto &member : object.values)
+    {
+        writer.Key(member.first);
+        if (member.first == "code" || member.first == "message")
+        {
+            writer.String(member.second.get<json::String>().value);
+        }
+        else if (member.first == "table")
+        {
+            writer.StartArray();
+            writer.StartArray();
+            writer.Number(1.5);
+            writer.Null();
+            writer.Number(-0.25);
+            writer.EndArray();
+            writer.StartArray();
+            writer.EndArray();
+            writer.EndArray();
+        }
+        else
+        {
+            writer.StartObject();
+            for (const auto &nested_member : nested.values)
+            {
+                writer.Key(nested_member.first);
+                writer.Bool(nested_member.first == "true");
+            }
+            writer.EndObject();
+        }
+    }
+    writer.EndObject();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()), render(object));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_members)
+{
+    json::Array durations;
+    for (int i = 0; i < 5; ++i)
+    {
+        durations.values.push_back(json::Number(i * 1.1));
+    }
+
+    json::Object object;
+    object.values["sources"] = json::Array();
+    object.values["destinations"] = json::Array();
+    object.values["durations"] = durations;
+    object.values["code"] = "Ok";
+
+    json::Object skeleton;
+    skeleton.values["sources"] = json::Array();
+    skeleton.values["destinations"] = json::Array();
+    skeleton.values["durations"] = json::Null();
+    skeleton.values["code"] = "Ok";
+
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+    writer.Object(skeleton, [&](const std::string &key) {
+        if (key != "durations")
+            return false;
+
+        writer.StartArray();
+        for (int i = 0; i < 5; ++i)
+        {
+            writer.Number(i * 1.1);
+        }
+        writer.EndArray();
+        return true;
+    });
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()), render(object));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include "util/lru_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(lru_cache_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(get_and_put)
+{
+    LRUCache<int, std::string> cache(100);
+
+    std::string value;
+    BOOST_CHECK(!cache.Get(1, value));
+
+    cache.Put(1, "one", 3);
+    BOOST_CHECK(cache.Get(1, value));
+    BOOST_CHECK_EQUAL(value, "one");
+
+    // replacing a value updates the size
+    cache.Put(1, "uno", 10);
+    BOOST_CHECK(cache.Get(1, value));
+    BOOST_CHECK_EQUAL(value, "uno");
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 2);
+    BOOST_CHECK_EQUAL(statistics.misses, 1);
+    BOOST_CHECK_EQUAL(statistics.evictions, 0);
+    BOOST_CHECK_EQUAL(statistics.entries, 1);
+    BOOST_CHECK_EQUAL(statistics.size, 10);
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+    LRUCache<int, int> cache(30);
+    cache.Put(1, 1, 10);
+    cache.Put(2, 2, 10);
+    cache.Put(3, 3, 10);
+
+    // 1 becomes the most recently used, 2 is evicted first
+    int value;
+    BOOST_CHECK(cache.Get(1, value));
+    cache.Put(4, 4, 10);
+    BOOST_CHECK(!cache.Get(2, value));
+    BOOST_CHECK(cache.Get(1, value));
+    BOOST_CHECK(cache.Get(3, value));
+    BOOST_CHECK(cache.Get(4, value));
+
+    // a large value evicts several entries
+    cache.Put(5, 5, 25);
+    BOOST_CHECK(cache.Get(5, value));
+    BOOST_CHECK(!cache.Get(1, value));
+    BOOST_CHECK(!cache.Get(3, value));
+    BOOST_CHECK(!cache.Get(4, value));
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.evictions, 4);
+    BOOST_CHECK_EQUAL(statistics.entries, 1);
+    BOOST_CHECK_EQUAL(statistics.size, 25);
+}
+
+BOOST_AUTO_TEST_CASE(too_large_and_clear)
+{
+    LRUCache<int, int> cache(10);
+    cache.Put(1, 1, 5);
+
+    // values larger than the cache leave it untouched
+    cache.Put(2, 2, 11);
+    int value;
+    BOOST_CHECK(!cache.Get(2, value));
+    BOOST_CHECK(cache.Get(1, value));
+
+    cache.Clear();
+    BOOST_CHECK(!cache.Get(1, value));
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.invalidations, 1);
+    BOOST_CHECK_EQUAL(statistics.entries, 0);
+    BOOST_CHECK_EQUAL(statistics.size, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+#include "util/min_plus.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(min_plus_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(for_each_valid_weight)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(0, 100);
+
+    // sizes around the vector widths and rows from all invalid to all valid
+    for (std::size_t size = 0; size < 35; ++size)
+    {
+        for (const auto invalid_share : {0, 30, 70, 100})
+        {
+            std::vector<EdgeWeight> weights(size);
+            std::vector<std::size_t> expected;
+            for (std::size_t index = 0; index < size; ++index)
+            {
+                if (weight_distribution(generator) < invalid_share)
+                {
+                    weights[index] = INVALID_EDGE_WEIGHT;
+                }
+                else
+                {
+                    weights[index] = weight_distribution(generator);
+                    expected.push_back(index);
+                }
+            }
+
+            std::vector<std::size_t> indices;
+            forEachValidWeight(weights.data(), weights.size(), [&](const std::size_t index) {
+                indices.push_back(index);
+            });
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                indices.begin(), indices.end(), expected.begin(), expected.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(min_plus_row)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(0, 100);
+
+    for (std::size_t size = 0; size < 35; ++size)
+    {
+        const auto random_row = [&](std::vector<EdgeWeight> &weights,
+                                    std::vector<EdgeDuration> &durations) {
+            weights.resize(size);
+            durations.resize(size);
+            for (std::size_t index = 0; index < size; ++index)
+            {
+                weights[index] = weight_distribution(generator) < 30
+                                     ? INVALID_EDGE_WEIGHT
+                                     : weight_distribution(generator);
+                durations[index] = weight_distribution(generator);
+            }
+        };
+
+        std::vector<EdgeWeight> target_weights, weights;
+        std::vector<EdgeDuration> target_durations, durations;
+        random_row(target_weights, target_durations);
+        random_row(weights, durations);
+        const EdgeWeight offset_weight = weight_distribution(generator) / 2;
+        const EdgeDuration offset_duration = weight_distribution(generator);
+
+        auto expected_weights = target_weights;
+        auto expected_durations = target_durations;
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            if (weights[index] != INVALID_EDGE_WEIGHT &&
+                offset_weight + weights[index] < expected_weights[index])
+            {
+                expected_weights[index] = offset_weight + weights[index];
+                expected_durations[index] = offset_duration + durations[index];
+            }
+        }
+
+        minPlus(target_weights.data(),
+                target_durations.data(),
+                weights.data(),
+                durations.data(),
+                size,
+                offset_weight,
+                offset_duration);
+        BOOST_CHECK_EQUAL_COLLECTIONS(target_weights.begin(),
+                                      target_weights.end(),
+                                      expected_weights.begin(),
+                                      expected_weights.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(target_durations.begin(),
+                                      target_durations.end(),
+                                      expected_durations.begin(),
+                                      expected_durations.end());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,9 +23,22 @@ struct TestData
 typedef NodeID TestNodeID;
 typedef int TestKey;
 typedef int TestWeight;
+
+// AdaptiveStorage with a memory budget that is always large enough for arrays
+template <typename NodeID, typename Key> struct AdaptiveArrayStorage : AdaptiveStorage<NodeID, Key>
+{
+    explicit AdaptiveArrayStorage(std::size_t size)
+        : AdaptiveStorage<NodeID, Key>(size, std::numeric_limits<std::size_t>::max())
+    {
+    }
+};
+
 typedef boost::mpl::list<ArrayStorage<TestNodeID, TestKey>,
+                         GenerationArrayStorage<TestNodeID, TestKey>,
                          MapStorage<TestNodeID, TestKey>,
-                         UnorderedMapStorage<TestNodeID, TestKey>>
+                         UnorderedMapStorage<TestNodeID, TestKey>,
+                         AdaptiveStorage<TestNodeID, TestKey>,
+                         AdaptiveArrayStorage<TestNodeID, TestKey>>
     storage_types;
 
 template <unsigned NUM_ELEM> struct RandomDataFixture
@@ -157,4 +170,91 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomData
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(random_operations_test,
+                                 T,
+                                 storage_types,
+                                 RandomDataFixture<NUM_NODES>)
+{
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(NUM_NODES);
+
+    std::mt19937 g(42);
+    std::uniform_int_distribution<TestWeight> weight_distribution(0, 1000);
+
+    // reference weights of all nodes that are still in the heap
+    std::vector<TestWeight> reference(NUM_NODES, std::numeric_limits<TestWeight>::max());
+
+    for (unsigned idx : order)
+    {
+        const auto weight = weight_distribution(g);
+        heap.Insert(ids[idx], weight, data[idx]);
+        reference[ids[idx]] = weight;
+    }
+
+    for (unsigned idx : order)
+    {
+        const auto id = ids[idx];
+        if (!heap.WasRemoved(id) && reference[id] > 0 && idx % 2 == 0)
+        {
+            reference[id] = std::uniform_int_distribution<TestWeight>(0, reference[id] - 1)(g);
+            heap.DecreaseKey(id, reference[id]);
+        }
+
+        if (idx % 3 == 0)
+        {
+            const auto min_weight = *std::min_element(reference.begin(), reference.end());
+            BOOST_CHECK_EQUAL(heap.MinKey(), min_weight);
+            const auto min_id = heap.DeleteMin();
+            BOOST_CHECK_EQUAL(reference[min_id], min_weight);
+            BOOST_CHECK(heap.WasRemoved(min_id));
+            reference[min_id] = std::numeric_limits<TestWeight>::max();
+        }
+    }
+
+    TestWeight last_weight = std::numeric_limits<TestWeight>::min();
+    while (!heap.Empty())
+    {
+        const auto min_weight = heap.MinKey();
+        BOOST_CHECK_LE(last_weight, min_weight);
+        BOOST_CHECK_EQUAL(reference[heap.DeleteMin()], min_weight);
+        last_weight = min_weight;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(adaptive_storage_selection)
+{
+    using Storage = AdaptiveStorage<TestNodeID, TestKey>;
+
+    BOOST_CHECK(!Storage(NUM_NODES).UsesArray());
+    BOOST_CHECK(!Storage(NUM_NODES, NUM_NODES * Storage::ARRAY_BYTES_PER_NODE - 1).UsesArray());
+    BOOST_CHECK(Storage(NUM_NODES, NUM_NODES * Storage::ARRAY_BYTES_PER_NODE).UsesArray());
+
+    // the arrays are allocated up front, the hash map only grows with the inserted nodes
+    BOOST_CHECK_EQUAL(Storage::GetArrayMemory(NUM_NODES, 0), 0);
+    BOOST_CHECK_EQUAL(
+        Storage::GetArrayMemory(NUM_NODES, NUM_NODES * Storage::ARRAY_BYTES_PER_NODE - 1), 0);
+    BOOST_CHECK_EQUAL(
+        Storage::GetArrayMemory(NUM_NODES, std::numeric_limits<std::size_t>::max()),
+        NUM_NODES * Storage::ARRAY_BYTES_PER_NODE);
+}
+
+BOOST_AUTO_TEST_CASE(adaptive_storage_clear_and_grow)
+{
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, AdaptiveStorage<TestNodeID, TestKey>>
+        heap(NUM_NODES, std::numeric_limits<std::size_t>::max());
+
+    heap.Insert(1, 10, TestData{1});
+    BOOST_CHECK(heap.WasInserted(1));
+
+    // stale entries of the previous generation are not visible after a clear
+    heap.Clear();
+    BOOST_CHECK(!heap.WasInserted(1));
+
+    // nodes beyond the initial size grow the arrays
+    heap.Insert(2 * NUM_NODES, 20, TestData{2});
+    BOOST_CHECK(heap.WasInserted(2 * NUM_NODES));
+    BOOST_CHECK(!heap.WasInserted(2 * NUM_NODES + 1));
+    BOOST_CHECK_EQUAL(heap.GetKey(2 * NUM_NODES), 20);
+    BOOST_CHECK_EQUAL(heap.DeleteMin(), 2 * NUM_NODES);
+}
+
 BOOST_AUTO_TEST_SUITE_END()